@@ -0,0 +1,184 @@
+#include <benchmark/benchmark.h>  // for State, DoNotOptimize, BENCHMARK
+
+#include <cstdint>                      // for uint64_t
+#include <functional>                   // for greater
+#include <netlistx/priority_queue.hpp>  // for BucketQueue, DaryHeap, RadixHeap
+#include <queue>                        // for priority_queue
+#include <random>                       // for mt19937
+#include <utility>                      // for pair
+#include <vector>                       // for vector
+
+namespace {
+    constexpr long long max_gain = 64;
+
+    // An FM-like workload: pop the best item, then change the gains of a few other items
+    struct GainWorkload {
+        std::vector<long long> initial;
+        std::vector<std::pair<index_t, long long>> updates;  // num_updates per pop
+
+        static constexpr size_t num_updates = 8;
+
+        explicit GainWorkload(size_t num_items) : initial(num_items) {
+            auto rng = std::mt19937{1};
+            for (auto &gain : initial) {
+                gain = static_cast<long long>(rng() % (2 * max_gain + 1)) - max_gain;
+            }
+            updates.resize(num_items * num_updates);
+            for (auto &update : updates) {
+                update.first = index_t(rng() % num_items);
+                update.second = static_cast<long long>(rng() % 5) - 2;
+            }
+        }
+    };
+
+    auto clamp_gain(long long gain) -> long long {
+        return gain < -max_gain ? -max_gain : gain > max_gain ? max_gain : gain;
+    }
+
+    template <typename Queue> void run_addressable(Queue &queue, const GainWorkload &workload) {
+        const auto num_items = workload.initial.size();
+        for (size_t v = 0; v != num_items; ++v) {
+            queue.push(index_t(v), workload.initial[v]);
+        }
+        auto next = workload.updates.begin();
+        while (!queue.empty()) {
+            benchmark::DoNotOptimize(queue.pop());
+            for (size_t i = 0; i != GainWorkload::num_updates; ++i, ++next) {
+                if (queue.contains(next->first)) {
+                    queue.update(next->first, clamp_gain(queue.key(next->first) + next->second));
+                }
+            }
+        }
+    }
+
+    void BM_BucketQueue(benchmark::State &state) {
+        const auto workload = GainWorkload{size_t(state.range(0))};
+        for (auto _ : state) {
+            auto queue = BucketQueue{workload.initial.size(), max_gain};
+            run_addressable(queue, workload);
+        }
+    }
+
+    void BM_DaryHeap4(benchmark::State &state) {
+        const auto workload = GainWorkload{size_t(state.range(0))};
+        for (auto _ : state) {
+            auto queue = DaryHeap<long long, 4>{workload.initial.size()};
+            run_addressable(queue, workload);
+        }
+    }
+
+    void BM_DaryHeap2(benchmark::State &state) {
+        const auto workload = GainWorkload{size_t(state.range(0))};
+        for (auto _ : state) {
+            auto queue = DaryHeap<long long, 2>{workload.initial.size()};
+            run_addressable(queue, workload);
+        }
+    }
+
+    // std::priority_queue with lazy deletion: an update pushes a new entry, and stale entries are
+    // skipped when they reach the top.
+    void BM_StdPriorityQueueLazy(benchmark::State &state) {
+        const auto workload = GainWorkload{size_t(state.range(0))};
+        const auto num_items = workload.initial.size();
+        for (auto _ : state) {
+            auto queue = std::priority_queue<std::pair<long long, index_t>>{};
+            auto gain = workload.initial;
+            auto done = std::vector<std::uint8_t>(num_items, 0U);
+            for (size_t v = 0; v != num_items; ++v) {
+                queue.emplace(gain[v], index_t(v));
+            }
+            auto next = workload.updates.begin();
+            while (!queue.empty()) {
+                const auto top = queue.top();
+                queue.pop();
+                if (done[top.second] != 0U || gain[top.second] != top.first) {
+                    continue;  // stale
+                }
+                done[top.second] = 1U;
+                benchmark::DoNotOptimize(top.second);
+                for (size_t i = 0; i != GainWorkload::num_updates; ++i, ++next) {
+                    if (done[next->first] == 0U) {
+                        gain[next->first] = clamp_gain(gain[next->first] + next->second);
+                        queue.emplace(gain[next->first], next->first);
+                    }
+                }
+            }
+        }
+    }
+
+    // A Dijkstra-like monotone workload for the radix heap: keys only grow past the last minimum
+    template <typename Step> void run_monotone(size_t num_items, const Step &step) {
+        auto rng = std::mt19937{2};
+        for (size_t v = 0; v != num_items; ++v) {
+            step(index_t(v), std::uint64_t(rng() % 1000000U), rng);
+        }
+    }
+
+    void BM_RadixHeap(benchmark::State &state) {
+        const auto num_items = size_t(state.range(0));
+        for (auto _ : state) {
+            auto heap = RadixHeap{num_items};
+            run_monotone(num_items, [&](index_t v, std::uint64_t key, std::mt19937 &rng) {
+                heap.push(v, heap.last_key() + key);
+                if (rng() % 2U == 0U) {
+                    const auto u = index_t(rng() % num_items);
+                    if (heap.contains(u)) {
+                        heap.update(u, heap.last_key() + rng() % 1000U);
+                    }
+                    benchmark::DoNotOptimize(heap.pop());
+                }
+            });
+            while (!heap.empty()) {
+                benchmark::DoNotOptimize(heap.pop());
+            }
+        }
+    }
+
+    void BM_StdPriorityQueueLazyMin(benchmark::State &state) {
+        using Entry = std::pair<std::uint64_t, index_t>;
+        const auto num_items = size_t(state.range(0));
+        for (auto _ : state) {
+            auto queue = std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>{};
+            auto key = std::vector<std::uint64_t>(num_items, 0U);
+            auto state_of = std::vector<std::uint8_t>(num_items, 0U);  // 0 new, 1 queued, 2 done
+            auto last = std::uint64_t{0};
+            auto num_queued = size_t{0};
+            auto pop = [&]() {
+                while (true) {
+                    const auto top = queue.top();
+                    queue.pop();
+                    if (state_of[top.second] == 1U && key[top.second] == top.first) {
+                        state_of[top.second] = 2U;
+                        last = top.first;
+                        --num_queued;
+                        return top.second;
+                    }
+                }
+            };
+            run_monotone(num_items, [&](index_t v, std::uint64_t k, std::mt19937 &rng) {
+                key[v] = last + k;
+                state_of[v] = 1U;
+                ++num_queued;
+                queue.emplace(key[v], v);
+                if (rng() % 2U == 0U) {
+                    const auto u = index_t(rng() % num_items);
+                    if (state_of[u] == 1U) {
+                        key[u] = last + rng() % 1000U;
+                        queue.emplace(key[u], u);
+                    }
+                    benchmark::DoNotOptimize(pop());
+                }
+            });
+            while (num_queued != 0U) {
+                benchmark::DoNotOptimize(pop());
+            }
+        }
+    }
+}  // namespace
+
+BENCHMARK(BM_BucketQueue)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_DaryHeap4)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_DaryHeap2)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_StdPriorityQueueLazy)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_RadixHeap)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_StdPriorityQueueLazyMin)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20);
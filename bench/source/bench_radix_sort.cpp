@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>  // for State, DoNotOptimize, BENCHMARK
+
+#include <algorithm>                // for sort, stable_sort
+#include <cstdint>                  // for uint64_t
+#include <netlistx/netlist.hpp>     // for index_t
+#include <netlistx/radix_sort.hpp>  // for radix_sort_pairs, radix_argsort
+#include <numeric>                  // for iota
+#include <random>                   // for mt19937
+#include <utility>                  // for pair
+#include <vector>                   // for vector
+
+namespace {
+    // The (net, module) composite keys of the pins of an ibm-like netlist, in module order as
+    // read from the module adjacency; sorting them groups the pins by net
+    struct PinKeys {
+        std::vector<std::uint64_t> keys;
+        std::vector<index_t> pins;  // pin index of every key
+
+        explicit PinKeys(size_t num_pins) {
+            // ibm01: 12752 modules, 14111 nets and 50566 pins
+            const auto num_modules = num_pins * 12752U / 50566U;
+            const auto num_nets = num_pins * 14111U / 50566U;
+            auto rng = std::mt19937{1};
+            for (size_t i = 0; i != num_pins; ++i) {
+                const auto module = i * num_modules / num_pins;
+                const auto net = num_modules + rng() % num_nets;
+                this->keys.push_back(std::uint64_t(net) << 32U | module);
+            }
+            this->pins.resize(num_pins);
+            std::iota(this->pins.begin(), this->pins.end(), index_t{0});
+        }
+    };
+
+    void BM_RadixSortPairs(benchmark::State &state) {
+        const auto input = PinKeys{size_t(state.range(0))};
+        for (auto _ : state) {
+            auto keys = input.keys;
+            auto pins = input.pins;
+            radix_sort_pairs(keys, pins);
+            benchmark::DoNotOptimize(pins.data());
+        }
+    }
+
+    void BM_StdSortPairs(benchmark::State &state) {
+        const auto input = PinKeys{size_t(state.range(0))};
+        for (auto _ : state) {
+            auto pairs = std::vector<std::pair<std::uint64_t, index_t>>(input.keys.size());
+            for (size_t i = 0; i != pairs.size(); ++i) {
+                pairs[i] = {input.keys[i], input.pins[i]};
+            }
+            std::sort(pairs.begin(), pairs.end());
+            benchmark::DoNotOptimize(pairs.data());
+        }
+    }
+
+    void BM_RadixArgsort(benchmark::State &state) {
+        const auto input = PinKeys{size_t(state.range(0))};
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(radix_argsort(input.keys));
+        }
+    }
+
+    void BM_StableSortArgsort(benchmark::State &state) {
+        const auto input = PinKeys{size_t(state.range(0))};
+        for (auto _ : state) {
+            auto perm = std::vector<index_t>(input.keys.size());
+            std::iota(perm.begin(), perm.end(), index_t{0});
+            std::stable_sort(perm.begin(), perm.end(), [&](index_t i, index_t j) {
+                return input.keys[i] < input.keys[j];
+            });
+            benchmark::DoNotOptimize(perm.data());
+        }
+    }
+}  // namespace
+
+// The pin counts of ibm01 and ibm18
+BENCHMARK(BM_RadixSortPairs)->Arg(50566)->Arg(819697);
+BENCHMARK(BM_StdSortPairs)->Arg(50566)->Arg(819697);
+BENCHMARK(BM_RadixArgsort)->Arg(50566)->Arg(819697);
+BENCHMARK(BM_StableSortArgsort)->Arg(50566)->Arg(819697);
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>  // for State, DoNotOptimize, BENCHMARK
+
+#include <netlistx/csr.hpp>         // for Csr
+#include <netlistx/wirelength.hpp>  // for total_hpwl, total_rsmt
+#include <random>                   // for mt19937
+#include <vector>                   // for vector
+
+namespace {
+    // A placed netlist with a VLSI-like net degree distribution: mostly 2 and 3 pins, a few
+    // percent of 7 to 30 pins and some nets of hundreds of pins
+    struct PlacedNets {
+        Csr net_pins;
+        std::vector<double> x;
+        std::vector<double> y;
+
+        explicit PlacedNets(size_t num_nets) {
+            const auto num_modules = num_nets;
+            auto rng = std::mt19937{1};
+            for (size_t i = 0; i != num_nets; ++i) {
+                const auto r = rng() % 1000U;
+                const auto degree = r < 550U   ? 2U
+                                    : r < 750U ? 3U
+                                    : r < 900U ? 4U + rng() % 3U
+                                    : r < 990U ? 7U + rng() % 24U
+                                               : 31U + rng() % 300U;
+                for (size_t j = 0; j != degree; ++j) {
+                    this->net_pins.targets.push_back(index_t(rng() % num_modules));
+                }
+                this->net_pins.offsets.push_back(this->net_pins.targets.size());
+            }
+            this->x.resize(num_modules);
+            this->y.resize(num_modules);
+            for (size_t v = 0; v != num_modules; ++v) {
+                this->x[v] = double(rng() % 100000U);
+                this->y[v] = double(rng() % 100000U);
+            }
+        }
+    };
+
+    void BM_TotalHpwl(benchmark::State &state) {
+        const auto nets = PlacedNets{size_t(state.range(0))};
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(total_hpwl(nets.net_pins, nets.x, nets.y));
+        }
+    }
+
+    void BM_TotalRsmt(benchmark::State &state) {
+        const auto nets = PlacedNets{size_t(state.range(0))};
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(total_rsmt(nets.net_pins, nets.x, nets.y));
+        }
+    }
+}  // namespace
+
+BENCHMARK(BM_TotalHpwl)->Arg(1 << 14)->Arg(1 << 18);
+BENCHMARK(BM_TotalRsmt)->Arg(1 << 14)->Arg(1 << 18);
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstddef>                        // for size_t
+#include <cstdint>                        // for int32_t, uint8_t, uint32_t
+#include <netlistx/csr.hpp>               // for Csr
+#include <netlistx/netlist.hpp>           // for SimpleNetlist
+#include <string>                         // for string
+#include <utility>                        // for pair
+#include <vector>                         // for vector
+
+/**
+ * @brief Writer of Arrow IPC files (the Arrow "file" format, also known as Feather v2).
+ *
+ * Self-contained: the FlatBuffers metadata is encoded directly, without an Arrow dependency.
+ * Columns are taken by value (move them in) and written as one record batch; every buffer is
+ * written as-is from memory and padded to 64 bytes, so consumers can memory-map the file and use
+ * the columns without copying. All columns are non-nullable.
+ *
+ * Example:
+ *
+ *     auto writer = ArrowFileWriter{};
+ *     writer.add_column("weight", std::move(weights));
+ *     writer.add_list_column("pins", net_pins_csr(hyprgraph));
+ *     writer.write("nets.arrow");
+ */
+class ArrowFileWriter {
+  public:
+    /// Column types
+    enum class Type { uint32, boolean, list_uint32 };
+
+    /// A column: its values, or its lists of values
+    struct Column {
+        std::string name;
+        Type type = Type::uint32;
+        size_t length{};
+        std::vector<std::uint32_t> values;  // uint32 values or list entries
+        std::vector<std::int32_t> offsets;  // list offsets (length + 1)
+        std::vector<std::uint8_t> bits;     // bit-packed booleans
+    };
+
+  private:
+    std::vector<Column> _columns;
+    std::vector<std::pair<std::string, std::string>> _metadata;
+
+  public:
+    /// Adds a UInt32 column.
+    void add_column(boost::string_view name, std::vector<std::uint32_t> values);
+
+    /// Adds a Bool column (one 0/1 byte per row).
+    void add_bool_column(boost::string_view name, const std::vector<std::uint8_t> &flags);
+
+    /// Adds a List<UInt32> column (row `i` holds the entries of row `i` of `lists`).
+    void add_list_column(boost::string_view name, Csr lists);
+
+    /// Adds a key-value pair to the schema metadata.
+    void add_metadata(boost::string_view key, boost::string_view value);
+
+    /**
+     * @brief Writes the columns as an Arrow IPC file.
+     *
+     * @param[in] fileName The path of the file.
+     * @return true on success; false if the columns differ in length or a list column has more
+     *         than 2^31 - 1 entries.
+     */
+    auto write(boost::string_view fileName) const -> bool;
+};
+
+/**
+ * @brief Exports the nets of a netlist as an Arrow IPC file.
+ *
+ * One row per net, with columns `pins` (List<UInt32> of module ids, sorted) and `weight`
+ * (UInt32). The schema metadata holds `num_modules`, `num_nets` and `num_pads`.
+ *
+ * @param[in] fileName The path of the file.
+ * @param[in] hyprgraph The netlist.
+ * @return true on success.
+ */
+auto writeArrowNets(boost::string_view fileName, const SimpleNetlist &hyprgraph) -> bool;
+
+/**
+ * @brief Exports the modules of a netlist as an Arrow IPC file.
+ *
+ * One row per module, with columns `nets` (List<UInt32> of net node ids, sorted, as in
+ * `writeJSON`), `weight` (UInt32), `is_pad` (Bool) and `is_fixed` (Bool).
+ *
+ * @param[in] fileName The path of the file.
+ * @param[in] hyprgraph The netlist.
+ * @return true on success.
+ */
+auto writeArrowModules(boost::string_view fileName, const SimpleNetlist &hyprgraph) -> bool;
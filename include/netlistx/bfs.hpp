@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>              // for sort, min_element
+#include <atomic>                 // for atomic
+#include <cstddef>                // for size_t
+#include <cstdint>                // for uint64_t
+#include <netlistx/netlist.hpp>   // for index_t
+#include <netlistx/parallel.hpp>  // for parallel_blocks, num_blocks_for
+#include <vector>                 // for vector
+
+/**
+ * @brief Direction-optimizing breadth-first search over the module-net graph of a netlist.
+ *
+ * Modules and nets are both nodes, so a module at distance 2 shares a net with the source. Each
+ * level is expanded either top-down (the frontier claims its unvisited neighbors with an atomic
+ * compare-and-swap) or bottom-up (every unvisited node looks for a neighbor in the frontier,
+ * which is kept as a bitset), following Beamer's heuristic: switch to bottom-up when the edges
+ * leaving the frontier exceed `1/alpha` of the unexplored edges, and back to top-down when the
+ * frontier shrinks below `1/beta` of the nodes. Both kinds of steps run in parallel.
+ *
+ * The workspace is allocated once; a new `run` only resets the nodes visited by the previous
+ * one. Distances are deterministic and every level of `order()` is sorted by node id.
+ *
+ * @tparam Gnl The type of the hypergraph.
+ */
+template <typename Gnl> class NetlistBfs {
+  public:
+    static constexpr index_t npos = ~index_t{0};
+
+    double alpha = 14.0;  ///< Top-down to bottom-up switch threshold
+    double beta = 24.0;   ///< Bottom-up to top-down switch threshold
+
+  private:
+    const Gnl &_hyprgraph;
+    std::vector<std::atomic<index_t>> _dist;
+    std::vector<std::uint64_t> _frontier_bits;
+    std::vector<index_t> _order;
+    std::vector<size_t> _level_start;
+    size_t _total_degree{};
+    size_t _num_bottom_up_steps{};
+
+  public:
+    /**
+     * @brief Allocates the workspace for the given netlist.
+     *
+     * @param[in] hyprgraph The input hypergraph (must outlive the engine).
+     */
+    explicit NetlistBfs(const Gnl &hyprgraph)
+        : _hyprgraph{hyprgraph},
+          _dist(hyprgraph.number_of_nodes()),
+          _frontier_bits((hyprgraph.number_of_nodes() + 63U) / 64U, 0U) {
+        for (auto &d : this->_dist) {
+            d.store(npos, std::memory_order_relaxed);
+        }
+        for (const auto &net : hyprgraph.nets) {
+            this->_total_degree += 2U * hyprgraph.gr.degree(net);
+        }
+    }
+
+    /**
+     * @brief Runs a BFS from `source`.
+     *
+     * @param[in] source The source node (module or net).
+     * @return index_t The eccentricity of `source` (the largest distance reached).
+     */
+    auto run(index_t source) -> index_t {
+        for (const auto v : this->_order) {
+            this->_dist[v].store(npos, std::memory_order_relaxed);
+        }
+        this->_order.clear();
+        this->_level_start.assign(1, 0U);
+        this->_num_bottom_up_steps = 0U;
+
+        const auto num_nodes = this->_hyprgraph.number_of_nodes();
+        this->_dist[source].store(0U, std::memory_order_relaxed);
+        this->_order.push_back(source);
+        this->_level_start.push_back(1U);
+        auto scout = this->_hyprgraph.gr.degree(source);
+        auto unexplored = this->_total_degree - scout;
+        auto bottom_up = false;
+        for (index_t level = 0;; ++level) {
+            const auto first = this->_level_start[level];
+            const auto last = this->_level_start[level + 1];
+            if (first == last) {
+                this->_level_start.pop_back();
+                return level - 1U;
+            }
+            if (!bottom_up && double(scout) > double(unexplored) / this->alpha) {
+                bottom_up = true;
+            } else if (bottom_up && double(last - first) < double(num_nodes) / this->beta) {
+                bottom_up = false;
+            }
+            if (bottom_up) {
+                this->_step_bottom_up(level, first, last);
+                ++this->_num_bottom_up_steps;
+            } else {
+                this->_step_top_down(level, first, last);
+            }
+            scout = 0U;
+            for (auto i = last; i != this->_order.size(); ++i) {
+                scout += this->_hyprgraph.gr.degree(this->_order[i]);
+            }
+            unexplored -= std::min(unexplored, scout);
+            this->_level_start.push_back(this->_order.size());
+        }
+    }
+
+    /// Distance of `node` from the last source, or `npos` if unreached
+    auto distance(index_t node) const -> index_t {
+        return this->_dist[node].load(std::memory_order_relaxed);
+    }
+
+    /// The reached nodes in BFS order
+    auto order() const -> const std::vector<index_t> & { return this->_order; }
+
+    /// Number of levels of the last run (eccentricity + 1)
+    auto number_of_levels() const -> size_t { return this->_level_start.size() - 1; }
+
+    /// The nodes at distance `level`
+    auto level(size_t level) const -> std::vector<index_t> {
+        return std::vector<index_t>(
+            this->_order.begin() + static_cast<std::ptrdiff_t>(this->_level_start[level]),
+            this->_order.begin() + static_cast<std::ptrdiff_t>(this->_level_start[level + 1]));
+    }
+
+    /// Number of bottom-up steps of the last run
+    auto number_of_bottom_up_steps() const -> size_t { return this->_num_bottom_up_steps; }
+
+  private:
+    void _step_top_down(index_t level, size_t first, size_t last) {
+        const auto num_blocks = num_blocks_for(last - first, 256U);
+        auto next = std::vector<std::vector<index_t>>(num_blocks);
+        parallel_blocks(first, last, num_blocks, [&](size_t b, size_t lo, size_t hi) {
+            for (auto i = lo; i != hi; ++i) {
+                for (const auto &w : this->_hyprgraph.gr[this->_order[i]]) {
+                    auto expected = npos;
+                    if (this->_dist[w].load(std::memory_order_relaxed) == npos
+                        && this->_dist[w].compare_exchange_strong(expected, level + 1U)) {
+                        next[b].push_back(index_t(w));
+                    }
+                }
+            }
+        });
+        this->_append(next);
+        std::sort(this->_order.begin() + static_cast<std::ptrdiff_t>(last), this->_order.end());
+    }
+
+    void _step_bottom_up(index_t level, size_t first, size_t last) {
+        auto &bits = this->_frontier_bits;
+        for (auto i = first; i != last; ++i) {
+            const auto v = this->_order[i];
+            bits[v / 64U] |= std::uint64_t{1} << (v % 64U);
+        }
+        const auto num_nodes = this->_hyprgraph.number_of_nodes();
+        const auto num_blocks = num_blocks_for(bits.size(), 64U);
+        auto next = std::vector<std::vector<index_t>>(num_blocks);
+        parallel_blocks(0U, bits.size(), num_blocks, [&](size_t b, size_t lo, size_t hi) {
+            const auto end = std::min(hi * 64U, num_nodes);
+            for (auto u = lo * 64U; u < end; ++u) {
+                if (this->_dist[u].load(std::memory_order_relaxed) != npos) {
+                    continue;
+                }
+                for (const auto &w : this->_hyprgraph.gr[index_t(u)]) {
+                    if ((bits[w / 64U] >> (w % 64U) & 1U) != 0U) {
+                        this->_dist[u].store(level + 1U, std::memory_order_relaxed);
+                        next[b].push_back(index_t(u));
+                        break;
+                    }
+                }
+            }
+        });
+        for (auto i = first; i != last; ++i) {
+            bits[this->_order[i] / 64U] = 0U;
+        }
+        this->_append(next);
+    }
+
+    void _append(const std::vector<std::vector<index_t>> &next) {
+        for (const auto &part : next) {
+            this->_order.insert(this->_order.end(), part.begin(), part.end());
+        }
+    }
+};
+
+/**
+ * @brief Finds a pseudo-peripheral module with the George-Liu algorithm.
+ *
+ * Starting from `start`, repeatedly moves to a module of minimum degree in the last BFS level
+ * (or the level before it if the last level only holds nets) while the eccentricity grows. On
+ * return, `bfs` holds the BFS from the returned module.
+ *
+ * @tparam Gnl The type of the hypergraph.
+ * @param[in,out] bfs The BFS engine (its workspace is reused).
+ * @param[in] hyprgraph The input hypergraph.
+ * @param[in] start The module to start from.
+ * @return index_t A module of (approximately) maximal eccentricity.
+ */
+template <typename Gnl>
+auto pseudo_peripheral_node(NetlistBfs<Gnl> &bfs, const Gnl &hyprgraph, index_t start)
+    -> index_t {
+    const auto num_modules = hyprgraph.number_of_modules();
+    auto root = start;
+    auto ecc = bfs.run(root);
+    while (true) {
+        auto candidates = bfs.level(bfs.number_of_levels() - 1);
+        if (!candidates.empty() && candidates.front() >= num_modules
+            && bfs.number_of_levels() >= 2) {
+            candidates = bfs.level(bfs.number_of_levels() - 2);
+        }
+        const auto next = *std::min_element(
+            candidates.begin(), candidates.end(), [&](index_t v1, index_t v2) {
+                return hyprgraph.gr.degree(v1) < hyprgraph.gr.degree(v2);
+            });
+        const auto next_ecc = bfs.run(next);
+        if (next_ecc <= ecc) {
+            bfs.run(root);
+            return root;
+        }
+        root = next;
+        ecc = next_ecc;
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint64_t
+#include <istream>      // for istream
+#include <ostream>      // for ostream
+#include <type_traits>  // for is_integral, make_unsigned
+#include <vector>       // for vector
+
+/**
+ * @brief Stores an integer in little-endian byte order.
+ *
+ * The binary formats of the library (result memo, index sidecars, ...) are little-endian
+ * regardless of the host, so files can be shared between machines.
+ *
+ * @tparam T An integer type.
+ * @param[out] bytes The destination (`sizeof(T)` bytes).
+ * @param[in] value The value.
+ */
+template <typename T> void store_le(unsigned char *bytes, T value) {
+    static_assert(std::is_integral<T>::value, "store_le needs an integer type");
+    using U = typename std::make_unsigned<T>::type;
+    for (size_t i = 0; i != sizeof(T); ++i) {
+        bytes[i] = static_cast<unsigned char>((static_cast<U>(value) >> (8U * i)) & 0xffU);
+    }
+}
+
+/**
+ * @brief Loads an integer stored in little-endian byte order.
+ *
+ * @tparam T An integer type.
+ * @param[in] bytes The source (`sizeof(T)` bytes).
+ * @return T The value.
+ */
+template <typename T> auto load_le(const unsigned char *bytes) -> T {
+    static_assert(std::is_integral<T>::value, "load_le needs an integer type");
+    using U = typename std::make_unsigned<T>::type;
+    auto result = U{0};
+    for (size_t i = 0; i != sizeof(T); ++i) {
+        result = static_cast<U>(result | static_cast<U>(U(bytes[i]) << (8U * i)));
+    }
+    return static_cast<T>(result);
+}
+
+/**
+ * @brief Writes an integer in little-endian byte order.
+ *
+ * @tparam T An integer type.
+ * @param[in,out] out The output stream.
+ * @param[in] value The value.
+ */
+template <typename T> void write_le(std::ostream &out, T value) {
+    unsigned char bytes[sizeof(T)];
+    store_le(bytes, value);
+    out.write(reinterpret_cast<const char *>(bytes), sizeof(T));
+}
+
+/**
+ * @brief Reads an integer in little-endian byte order.
+ *
+ * @tparam T An integer type.
+ * @param[in,out] in The input stream.
+ * @param[out] value The value.
+ * @return true if the bytes could be read.
+ */
+template <typename T> auto read_le(std::istream &in, T &value) -> bool {
+    unsigned char bytes[sizeof(T)];
+    if (!in.read(reinterpret_cast<char *>(bytes), sizeof(T))) {
+        return false;
+    }
+    value = load_le<T>(bytes);
+    return true;
+}
+
+/**
+ * @brief Writes the length of a vector (as uint64) followed by its elements.
+ *
+ * @tparam T An integer type.
+ * @param[in,out] out The output stream.
+ * @param[in] values The elements.
+ */
+template <typename T> void write_le_vector(std::ostream &out, const std::vector<T> &values) {
+    write_le(out, std::uint64_t(values.size()));
+    for (const auto value : values) {
+        write_le(out, value);
+    }
+}
+
+/**
+ * @brief Reads a vector written by `write_le_vector`.
+ *
+ * @tparam T An integer type.
+ * @param[in,out] in The input stream.
+ * @param[out] values The elements.
+ * @param[in] max_size Larger lengths are rejected (protects against corrupt files).
+ * @return true if the vector could be read.
+ */
+template <typename T>
+auto read_le_vector(std::istream &in, std::vector<T> &values, std::uint64_t max_size) -> bool {
+    auto size = std::uint64_t{0};
+    if (!read_le(in, size) || size > max_size) {
+        return false;
+    }
+    values.resize(size);
+    for (auto &value : values) {
+        if (!read_le(in, value)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <condition_variable>             // for condition_variable
+#include <cstddef>                        // for size_t
+#include <cstdint>                        // for uint8_t, uint64_t
+#include <memory>                         // for unique_ptr
+#include <mutex>                          // for mutex
+#include <netlistx/binary_io.hpp>         // for store_le, load_le
+#include <netlistx/fingerprint.hpp>       // for Fingerprint128
+#include <sstream>                        // for ostringstream, istringstream
+#include <string>                         // for string
+#include <thread>                         // for thread
+#include <type_traits>                    // for is_integral
+#include <vector>                         // for vector
+
+/**
+ * @brief The resumable state of a long run: named arrays plus the step they belong to.
+ *
+ * A checkpoint is a flat list of sections, each a named array of integers (cluster maps of a
+ * coarsening hierarchy, partitions, gains, ...) or the serialized state of a random engine.
+ * Storing the engines together with the arrays lets a run in deterministic mode continue exactly
+ * as if it had not been interrupted.
+ *
+ *     auto checkpoint = Checkpoint{};
+ *     checkpoint.netlist = fingerprint(hyprgraph);
+ *     checkpoint.step = generation;
+ *     checkpoint.put("part", part);
+ *     checkpoint.put_engine("rng", rng);
+ *     writer.submit(std::move(checkpoint));
+ */
+struct Checkpoint {
+    struct Section {
+        std::string name;
+        std::uint8_t element_size{};  ///< Bytes per element (1 for engine states)
+        std::vector<unsigned char> bytes;
+    };
+
+    Fingerprint128 netlist;  ///< Fingerprint of the netlist of the run
+    std::uint64_t step{};    ///< Iteration, level or generation of the run
+    std::vector<Section> sections;
+
+    /// The section named `name`, or nullptr
+    auto find(boost::string_view name) const -> const Section *;
+
+    /**
+     * @brief Stores an integer array (replacing a section of the same name).
+     *
+     * @tparam T An integer type.
+     * @param[in] name The name of the section.
+     * @param[in] values The array.
+     */
+    template <typename T> void put(boost::string_view name, const std::vector<T> &values) {
+        static_assert(std::is_integral<T>::value, "put needs an integer type");
+        auto bytes = std::vector<unsigned char>(values.size() * sizeof(T));
+        for (size_t i = 0; i != values.size(); ++i) {
+            store_le(&bytes[i * sizeof(T)], values[i]);
+        }
+        this->_put(name, sizeof(T), std::move(bytes));
+    }
+
+    /**
+     * @brief Loads an integer array stored by `put`.
+     *
+     * @tparam T The integer type used by `put`.
+     * @param[in] name The name of the section.
+     * @param[out] values The array.
+     * @return false if there is no such section or its element size differs.
+     */
+    template <typename T> auto get(boost::string_view name, std::vector<T> &values) const -> bool {
+        static_assert(std::is_integral<T>::value, "get needs an integer type");
+        const auto *section = this->find(name);
+        if (section == nullptr || section->element_size != sizeof(T)) {
+            return false;
+        }
+        values.resize(section->bytes.size() / sizeof(T));
+        for (size_t i = 0; i != values.size(); ++i) {
+            values[i] = load_le<T>(&section->bytes[i * sizeof(T)]);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Stores the state of a random engine (e.g. `std::mt19937_64`).
+     *
+     * The state is the engine's textual representation, which restores an identical sequence
+     * with the same standard library.
+     */
+    template <typename Engine> void put_engine(boost::string_view name, const Engine &engine) {
+        auto text = std::ostringstream{};
+        text << engine;
+        const auto state = text.str();
+        this->_put(name, 1U, std::vector<unsigned char>(state.begin(), state.end()));
+    }
+
+    /// Restores the state of a random engine stored by `put_engine`.
+    template <typename Engine> auto get_engine(boost::string_view name, Engine &engine) const
+        -> bool {
+        const auto *section = this->find(name);
+        if (section == nullptr || section->element_size != 1U) {
+            return false;
+        }
+        auto text = std::istringstream{std::string(section->bytes.begin(), section->bytes.end())};
+        auto restored = engine;
+        if (!(text >> restored)) {
+            return false;
+        }
+        engine = restored;
+        return true;
+    }
+
+  private:
+    void _put(boost::string_view name, size_t element_size, std::vector<unsigned char> bytes);
+};
+
+/**
+ * @brief Writes a checkpoint file.
+ *
+ * The file is written to a uniquely named temporary file next to `fileName` and renamed over it
+ * when complete, so a crash during the write leaves the previous checkpoint intact and concurrent
+ * writers never share a temporary file. The layout is a little-endian header (magic, step,
+ * netlist fingerprint, number of sections), the sections (name, element size, byte length and
+ * bytes) and a checksum of everything before it.
+ *
+ * @param[in] fileName The path of the checkpoint.
+ * @param[in] checkpoint The checkpoint.
+ * @return true on success.
+ */
+auto writeCheckpoint(boost::string_view fileName, const Checkpoint &checkpoint) -> bool;
+
+/**
+ * @brief Reads a checkpoint file.
+ *
+ * @param[in] fileName The path of the checkpoint.
+ * @param[out] checkpoint The checkpoint.
+ * @return false if the file is missing, truncated or fails its checksum.
+ */
+auto readCheckpoint(boost::string_view fileName, Checkpoint &checkpoint) -> bool;
+
+/**
+ * @brief Writes checkpoints on a background thread.
+ *
+ * `submit` hands a checkpoint over and returns at once, so the compute threads never wait for
+ * the disk. If a checkpoint is submitted while the previous one is still queued, the older one
+ * is dropped (only the latest state matters). The destructor writes the last submitted
+ * checkpoint before it returns.
+ */
+class CheckpointWriter {
+    std::string _fileName;
+    mutable std::mutex _mutex;
+    std::condition_variable _wakeup;
+    std::condition_variable _idle;
+    std::unique_ptr<Checkpoint> _pending;
+    bool _writing = false;
+    bool _stop = false;
+    bool _ok = true;
+    size_t _num_written = 0;
+    std::thread _thread;
+
+    void _run();
+
+  public:
+    /**
+     * @brief Starts the writer thread.
+     *
+     * @param[in] fileName The path of the checkpoint file (overwritten by every write).
+     */
+    explicit CheckpointWriter(boost::string_view fileName);
+    CheckpointWriter(const CheckpointWriter &) = delete;
+    auto operator=(const CheckpointWriter &) -> CheckpointWriter & = delete;
+    ~CheckpointWriter();
+
+    /// Queues a checkpoint for writing (replacing a queued one that was not written yet).
+    void submit(Checkpoint checkpoint);
+
+    /// Waits until the queued checkpoint, if any, is on disk.
+    void flush();
+
+    /// The number of checkpoints written so far
+    auto num_written() const -> size_t;
+
+    /// Whether the last write succeeded
+    auto ok() const -> bool;
+};
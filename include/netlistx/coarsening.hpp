@@ -0,0 +1,127 @@
+#pragma once
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstddef>                        // for size_t
+#include <cstdint>                        // for uint8_t
+#include <netlistx/fingerprint.hpp>       // for Fingerprint128
+#include <netlistx/netlist.hpp>           // for SimpleNetlist, index_t
+#include <vector>                         // for vector
+
+/**
+ * @brief Options of `coarsen`.
+ */
+struct CoarseningOptions {
+    size_t coarsest_size = 160;           ///< Stop when a level has at most this many modules
+    double min_reduction = 0.05;          ///< Stop when a level removes a smaller share of modules
+    size_t max_levels = 32;               ///< Maximum number of levels
+    size_t max_net_degree = 8;            ///< Larger nets are never contracted
+    unsigned int max_cluster_weight = 0;  ///< Heavier clusters are not formed (0: total / coarsest)
+};
+
+/**
+ * @brief One level of a coarsening hierarchy.
+ */
+struct CoarseLevel {
+    SimpleNetlist netlist;         ///< The coarse netlist
+    std::vector<index_t> cluster;  ///< The coarse module of every module of the finer level
+};
+
+/**
+ * @brief The levels of a multilevel coarsening of a netlist.
+ *
+ * `levels[0]` is contracted from the input netlist and `levels[i]` from `levels[i - 1]`. The
+ * hierarchy does not depend on the number of blocks or the balance of a partition, so one
+ * hierarchy can be built (or loaded with `readHierarchy`) once and shared by every run of a
+ * parameter sweep. It is never modified after construction; concurrent runs may read it from
+ * several threads.
+ *
+ * A partition of a coarse level projected down to the input netlist has the same block weights
+ * and the same connectivity cost (see `connectivity_cost`).
+ */
+struct CoarseningHierarchy {
+    Fingerprint128 netlist;           ///< Fingerprint of the input netlist
+    std::vector<CoarseLevel> levels;  ///< The coarse levels, from fine to coarse
+
+    /// The number of coarse levels
+    auto num_levels() const -> size_t { return this->levels.size(); }
+
+    /// The coarsest netlist (there must be at least one level)
+    auto coarsest() const -> const SimpleNetlist & { return this->levels.back().netlist; }
+
+    /**
+     * @brief Projects a partition of `levels[level]` to the next finer level.
+     *
+     * @param[in] level The level of `part`.
+     * @param[in] part The block of every module of `levels[level]`.
+     * @return std::vector<std::uint8_t> The block of every module of the next finer level (the
+     *         input netlist if `level` is 0).
+     */
+    auto project(size_t level, const std::vector<std::uint8_t> &part) const
+        -> std::vector<std::uint8_t>;
+
+    /**
+     * @brief Projects a partition of `levels[level]` to the input netlist.
+     *
+     * @param[in] level The level of `part`.
+     * @param[in] part The block of every module of `levels[level]`.
+     * @return std::vector<std::uint8_t> The block of every module of the input netlist.
+     */
+    auto project_to_input(size_t level, const std::vector<std::uint8_t> &part) const
+        -> std::vector<std::uint8_t>;
+};
+
+/**
+ * @brief Contracts every cluster of modules into one module.
+ *
+ * The weight of a coarse module is the total weight of its cluster, and a coarse module is fixed
+ * if its cluster holds a fixed module. Nets whose pins fall into a single cluster disappear; the
+ * other nets keep their order, with one pin per cluster. Parallel nets are kept, since the
+ * netlist has no net weights to merge them into.
+ *
+ * @param[in] hyprgraph The input hypergraph.
+ * @param[in] cluster The cluster of every module, in [0, num_clusters).
+ * @param[in] num_clusters The number of clusters.
+ * @return SimpleNetlist The contracted netlist.
+ */
+auto contract(const SimpleNetlist &hyprgraph, const std::vector<index_t> &cluster,
+              size_t num_clusters) -> SimpleNetlist;
+
+/**
+ * @brief Builds a coarsening hierarchy by repeated matching-based contraction.
+ *
+ * Every level runs `min_maximal_matching` with the cluster weight of each net as its cost, so
+ * light, disjoint nets are preferred, and contracts the pins of every matched net into one
+ * module. Nets with more than `max_net_degree` pins, nets that would form a cluster heavier than
+ * `max_cluster_weight`, and nets with a fixed module are not contracted. Coarsening stops at
+ * `coarsest_size` modules, after `max_levels` levels, or when a level shrinks by less than
+ * `min_reduction`.
+ *
+ * @param[in] hyprgraph The input hypergraph.
+ * @param[in] options The coarsening options.
+ * @return CoarseningHierarchy The hierarchy (without levels if the netlist cannot be coarsened).
+ */
+auto coarsen(const SimpleNetlist &hyprgraph, const CoarseningOptions &options = {})
+    -> CoarseningHierarchy;
+
+/**
+ * @brief Writes a coarsening hierarchy.
+ *
+ * The file is a checkpoint (see `writeCheckpoint`) with the cluster map, the net pins and the
+ * module weights of every level.
+ *
+ * @param[in] fileName The path of the file.
+ * @param[in] hierarchy The hierarchy.
+ * @return true on success.
+ */
+auto writeHierarchy(boost::string_view fileName, const CoarseningHierarchy &hierarchy) -> bool;
+
+/**
+ * @brief Reads a coarsening hierarchy written by `writeHierarchy`.
+ *
+ * @param[in] fileName The path of the file.
+ * @param[in] hyprgraph The input netlist of the hierarchy.
+ * @param[out] hierarchy The hierarchy.
+ * @return false if the file cannot be read, is inconsistent, or belongs to another netlist.
+ */
+auto readHierarchy(boost::string_view fileName, const SimpleNetlist &hyprgraph,
+                   CoarseningHierarchy &hierarchy) -> bool;
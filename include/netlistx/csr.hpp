@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>              // for sort
+#include <cstddef>                // for size_t, ptrdiff_t
+#include <netlistx/netlist.hpp>   // for index_t
+#include <netlistx/parallel.hpp>  // for parallel_for
+#include <vector>                 // for vector
+
+/**
+ * @brief A read-only view of one row of a `Csr` array.
+ */
+struct CsrRow {
+    const index_t *first{};
+    const index_t *last{};
+
+    auto begin() const -> const index_t * { return this->first; }
+    auto end() const -> const index_t * { return this->last; }
+    auto size() const -> size_t { return static_cast<size_t>(this->last - this->first); }
+    auto empty() const -> bool { return this->first == this->last; }
+    auto operator[](size_t i) const -> index_t { return this->first[i]; }
+};
+
+/**
+ * @brief Compressed sparse row array.
+ *
+ * Row `i` is stored in `targets[offsets[i] .. offsets[i + 1])`. Unlike the hash-set adjacency
+ * of `xnetwork::SimpleGraph`, the rows are contiguous and (when built by the functions below)
+ * sorted, which makes comparisons, intersections and hashing cheap.
+ */
+struct Csr {
+    std::vector<size_t> offsets{0U};
+    std::vector<index_t> targets;
+
+    /// Returns the number of rows.
+    auto size() const -> size_t { return this->offsets.size() - 1; }
+
+    /// Returns the total number of entries.
+    auto number_of_entries() const -> size_t { return this->targets.size(); }
+
+    /// Returns row `i`.
+    auto operator[](size_t i) const -> CsrRow {
+        return CsrRow{this->targets.data() + this->offsets[i],
+                      this->targets.data() + this->offsets[i + 1]};
+    }
+};
+
+/**
+ * @brief Builds a sorted CSR array from the adjacency of the given nodes.
+ *
+ * Row `i` holds the neighbors of `nodes[i]` in increasing order. The degree count and the sorted
+ * fill are both done in parallel; only the prefix sum is sequential.
+ *
+ * @tparam Gnl The type of the hypergraph.
+ * @tparam Nodes The type of the node view.
+ * @param[in] hyprgraph The input hypergraph.
+ * @param[in] nodes The nodes whose adjacency becomes the rows.
+ * @return Csr The sorted CSR array.
+ */
+template <typename Gnl, typename Nodes>
+auto sorted_adjacency(const Gnl &hyprgraph, const Nodes &nodes) -> Csr {
+    const auto num_rows = nodes.size();
+    auto csr = Csr{};
+    csr.offsets.assign(num_rows + 1, 0U);
+    parallel_for(0U, num_rows, [&](size_t lo, size_t hi) {
+        for (auto i = lo; i != hi; ++i) {
+            csr.offsets[i + 1] = hyprgraph.gr.degree(nodes[i]);
+        }
+    });
+    for (size_t i = 0; i != num_rows; ++i) {
+        csr.offsets[i + 1] += csr.offsets[i];
+    }
+    csr.targets.resize(csr.offsets[num_rows]);
+    parallel_for(0U, num_rows, [&](size_t lo, size_t hi) {
+        for (auto i = lo; i != hi; ++i) {
+            auto pos = csr.offsets[i];
+            for (const auto &w : hyprgraph.gr[nodes[i]]) {
+                csr.targets[pos++] = index_t(w);
+            }
+            std::sort(csr.targets.begin() + static_cast<std::ptrdiff_t>(csr.offsets[i]),
+                      csr.targets.begin() + static_cast<std::ptrdiff_t>(pos));
+        }
+    });
+    return csr;
+}
+
+/**
+ * @brief Builds the sorted pin lists of all nets (row `i` is net `nets[i]`).
+ *
+ * @tparam Gnl The type of the hypergraph.
+ * @param[in] hyprgraph The input hypergraph.
+ * @return Csr The module ids of every net, sorted.
+ */
+template <typename Gnl> auto net_pins_csr(const Gnl &hyprgraph) -> Csr {
+    return sorted_adjacency(hyprgraph, hyprgraph.nets);
+}
+
+/**
+ * @brief Builds the sorted net lists of all modules (row `v` is module `modules[v]`).
+ *
+ * @tparam Gnl The type of the hypergraph.
+ * @param[in] hyprgraph The input hypergraph.
+ * @return Csr The net node ids of every module, sorted.
+ */
+template <typename Gnl> auto module_nets_csr(const Gnl &hyprgraph) -> Csr {
+    return sorted_adjacency(hyprgraph, hyprgraph.modules);
+}
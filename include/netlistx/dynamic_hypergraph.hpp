@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>               // for size_t
+#include <cstdint>               // for uint8_t, uint64_t
+#include <netlistx/csr.hpp>      // for CsrRow
+#include <netlistx/netlist.hpp>  // for SimpleNetlist, index_t
+#include <vector>                // for vector
+
+/**
+ * @brief A hypergraph for n-level coarsening: contracts one module pair at a time and undoes
+ * the contractions in reverse order.
+ *
+ * Nets are numbered by their offset in [0, number_of_nets()). The pins of every net are stored
+ * in one array, with the active pins first. Contracting `v` into `u` works net by net on the
+ * nets of `v`:
+ *
+ * - if `u` is also a pin, `v` is swapped behind the active pins (duplicate pins are removed on
+ *   the fly), and a net left with a single pin becomes disabled;
+ * - otherwise `v` is replaced by `u` in place, and the net is appended to the nets of `u`.
+ *
+ * The net lists of all modules share one arena. Only `u` gains nets: its list is extended in
+ * place if it is the last one of the arena, and copied to the end of the arena otherwise. The
+ * list of `v` is left untouched. So undoing a contraction only has to restore the pins of the
+ * nets of `v`, the weight of `u` and the extent of the list of `u`, and then truncate the
+ * arena. A contraction is recorded in 24 bytes, and apart from the copied lists the memory is
+ * fixed at about 8 bytes per pin, 13 bytes per net and 17 bytes per module.
+ *
+ * Contractions must be undone in reverse order (`uncontract`); a module contracted into `u` is
+ * inactive until then.
+ */
+class DynamicHypergraph {
+  public:
+    /// A contraction of `v` into `u`, with the previous extent of the net list of `u`
+    struct Memento {
+        index_t u;
+        index_t v;
+        index_t u_size;
+        size_t u_begin;
+    };
+
+  private:
+    std::vector<size_t> _pin_begin;   // num_nets + 1
+    std::vector<index_t> _net_size;   // active pins of every net
+    std::vector<index_t> _pins;
+    std::vector<size_t> _nets_begin;  // net list of every module in the arena
+    std::vector<index_t> _nets_size;
+    std::vector<index_t> _incident;   // the arena
+    std::vector<unsigned int> _weight;
+    std::vector<std::uint8_t> _active;
+    std::vector<std::uint8_t> _mark;  // scratch, one flag per net
+    std::vector<Memento> _history;
+    size_t _num_active{};
+
+    void _move_to_end(index_t u);
+
+  public:
+    /**
+     * @brief Copies a netlist (module weights included).
+     *
+     * @param[in] hyprgraph The input hypergraph.
+     */
+    explicit DynamicHypergraph(const SimpleNetlist &hyprgraph);
+
+    /// The number of modules, active or not
+    auto number_of_modules() const -> size_t { return this->_weight.size(); }
+
+    /// The number of nets, enabled or not
+    auto number_of_nets() const -> size_t { return this->_net_size.size(); }
+
+    /// The number of active modules
+    auto num_active() const -> size_t { return this->_num_active; }
+
+    /// Whether module `v` is active (not contracted into another module)
+    auto is_active(index_t v) const -> bool { return this->_active[v] != 0U; }
+
+    /// The weight of module `v` (the total weight of the modules contracted into it)
+    auto weight(index_t v) const -> unsigned int { return this->_weight[v]; }
+
+    /// Whether net `net` has at least two pins
+    auto is_enabled(index_t net) const -> bool { return this->_net_size[net] >= 2U; }
+
+    /// The active pins of net `net`
+    auto pins(index_t net) const -> CsrRow {
+        const auto *first = this->_pins.data() + this->_pin_begin[net];
+        return CsrRow{first, first + this->_net_size[net]};
+    }
+
+    /// The nets of active module `v` (skip those that are not enabled)
+    auto nets(index_t v) const -> CsrRow {
+        const auto *first = this->_incident.data() + this->_nets_begin[v];
+        return CsrRow{first, first + this->_nets_size[v]};
+    }
+
+    /// The contractions that have not been undone, oldest first
+    auto history() const -> const std::vector<Memento> & { return this->_history; }
+
+    /**
+     * @brief Contracts module `v` into module `u`.
+     *
+     * @param[in] u An active module, which stays active.
+     * @param[in] v Another active module, which becomes inactive.
+     */
+    void contract(index_t u, index_t v);
+
+    /**
+     * @brief Undoes the last contraction.
+     *
+     * @return Memento The contraction that was undone.
+     */
+    auto uncontract() -> Memento;
+
+    /**
+     * @brief Undoes the last `count` contractions and projects a partition onto them.
+     *
+     * @param[in] count The number of contractions to undo (at most `history().size()`).
+     * @param[in,out] part The block of every module; a reactivated module gets the block of the
+     *                     module it was contracted into.
+     * @return std::vector<index_t> The reactivated modules, the seeds of a local refinement.
+     */
+    auto uncontract_batch(size_t count, std::vector<std::uint8_t> &part) -> std::vector<index_t>;
+};
+
+/**
+ * @brief Options of `nlevel_coarsen`.
+ */
+struct NLevelOptions {
+    size_t coarsest_size = 160;           ///< Stop at this many active modules
+    unsigned int max_cluster_weight = 0;  ///< Heavier modules are not formed (0: total / coarsest)
+    size_t max_net_degree = 64;           ///< Larger nets do not contribute to the rating
+};
+
+/**
+ * @brief Coarsens a hypergraph one contraction at a time.
+ *
+ * Every active module `u`, in id order, is contracted with the neighbor `v` of highest rating
+ * sum(1 / (|e| - 1)) / (weight(u) * weight(v)) over their common nets `e`, so every level of the
+ * hierarchy differs from the next by a single module. Passes are repeated until `coarsest_size`
+ * modules are left or a pass finds no pair within `max_cluster_weight`.
+ *
+ * @param[in,out] hyprgraph The dynamic hypergraph.
+ * @param[in] options The coarsening options.
+ * @return size_t The number of contractions.
+ */
+auto nlevel_coarsen(DynamicHypergraph &hyprgraph, const NLevelOptions &options = {}) -> size_t;
+
+/**
+ * @brief Refines a k-way partition around the given modules.
+ *
+ * The modules of `seeds` are visited first; a module is moved to the block that reduces the
+ * connectivity cost (see `connectivity_cost`) most without exceeding `max_block_weight`, and the
+ * neighbors of a moved module are visited next. Every module is visited at most once, so the
+ * work is bounded by the pins around the seeds and the moved modules.
+ *
+ * @param[in] hyprgraph The dynamic hypergraph.
+ * @param[in,out] part The block of every active module.
+ * @param[in,out] block_weight The weight of every block (its size is the number of blocks).
+ * @param[in] seeds The modules to start from, e.g. from `uncontract_batch`.
+ * @param[in] max_block_weight The maximum weight of a block.
+ * @return std::uint64_t The reduction of the connectivity cost.
+ */
+auto refine_local(const DynamicHypergraph &hyprgraph, std::vector<std::uint8_t> &part,
+                  std::vector<std::uint64_t> &block_weight, const std::vector<index_t> &seeds,
+                  std::uint64_t max_block_weight) -> std::uint64_t;
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>              // for sort
+#include <cstddef>                // for size_t
+#include <cstdint>                // for uint64_t
+#include <netlistx/csr.hpp>       // for Csr, net_pins_csr
+#include <netlistx/hash.hpp>      // for hash_mix, hash_combine, hash_sequence
+#include <netlistx/parallel.hpp>  // for parallel_blocks, parallel_for, num_blocks_for
+#include <string>                 // for string
+#include <vector>                 // for vector
+
+/**
+ * @brief A 128-bit netlist fingerprint.
+ */
+struct Fingerprint128 {
+    std::uint64_t hi{};
+    std::uint64_t lo{};
+
+    auto operator==(const Fingerprint128 &other) const -> bool {
+        return this->hi == other.hi && this->lo == other.lo;
+    }
+    auto operator!=(const Fingerprint128 &other) const -> bool { return !(*this == other); }
+
+    /**
+     * @brief Get the fingerprint as 32 lowercase hexadecimal digits.
+     *
+     * @return std::string The hexadecimal representation.
+     */
+    auto to_string() const -> std::string {
+        constexpr const char *digits = "0123456789abcdef";
+        auto result = std::string(32U, '0');
+        for (auto i = 0U; i != 16U; ++i) {
+            result[15U - i] = digits[(this->hi >> (4U * i)) & 0xfU];
+            result[31U - i] = digits[(this->lo >> (4U * i)) & 0xfU];
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief Options of `fingerprint`.
+ */
+struct FingerprintOptions {
+    /// If true, the fingerprint is also invariant under renumbering of the modules. Modules are
+    /// then labelled by color refinement instead of by their ids.
+    bool module_relabeling = false;
+    /// Number of color refinement rounds used when `module_relabeling` is set.
+    unsigned int refinement_rounds = 3U;
+};
+
+/**
+ * @brief Computes a fingerprint for every row of a sorted pin CSR array.
+ *
+ * @param[in] pins The sorted pin lists, e.g. from `net_pins_csr`.
+ * @return std::vector<uint64_t> The fingerprint of each net.
+ */
+inline auto net_fingerprints(const Csr &pins) -> std::vector<std::uint64_t> {
+    auto fingerprints = std::vector<std::uint64_t>(pins.size());
+    parallel_for(0U, pins.size(), [&](size_t lo, size_t hi) {
+        for (auto i = lo; i != hi; ++i) {
+            const auto row = pins[i];
+            fingerprints[i] = hash_sequence(row.begin(), row.end(), row.size());
+        }
+    });
+    return fingerprints;
+}
+
+/**
+ * @brief Folds a multiset of hashes into two independent commutative lanes.
+ *
+ * @param[in] hashes The hashes to fold.
+ * @return Fingerprint128 The lane sums (independent of the order of `hashes`).
+ */
+inline auto fold_multiset(const std::vector<std::uint64_t> &hashes) -> Fingerprint128 {
+    constexpr auto seed_hi = 0x243f6a8885a308d3ULL;
+    constexpr auto seed_lo = 0x13198a2e03707344ULL;
+    const auto num_blocks = num_blocks_for(hashes.size(), 16384U);
+    auto partial = std::vector<Fingerprint128>(num_blocks);
+    parallel_blocks(0U, hashes.size(), num_blocks, [&](size_t b, size_t lo, size_t hi) {
+        auto sum = Fingerprint128{};
+        for (auto i = lo; i != hi; ++i) {
+            sum.hi += hash_mix(hashes[i] ^ seed_hi);
+            sum.lo += hash_mix(hashes[i] ^ seed_lo);
+        }
+        partial[b] = sum;
+    });
+    auto result = Fingerprint128{};
+    for (const auto &sum : partial) {
+        result.hi += sum.hi;
+        result.lo += sum.lo;
+    }
+    return result;
+}
+
+/**
+ * @brief Computes a canonical 128-bit fingerprint of a netlist.
+ *
+ * The fingerprint is a commutative fold over the nets, so it does not depend on the order in
+ * which the nets appear in the input file. By default a net is hashed from its sorted module ids,
+ * module weights are included by id and the sorted ids of the fixed modules are part of the
+ * header. With `module_relabeling` set, modules are labelled by a few rounds of color refinement
+ * (weight, degree and fixed flag, then the multiset of incident net colors), which makes the
+ * fingerprint invariant under module renumbering as well. Equal fingerprints do
+ * not prove isomorphism, but different fingerprints prove that the netlists differ.
+ *
+ * All passes run in parallel over nets and modules.
+ *
+ * @tparam Gnl The type of the hypergraph.
+ * @param[in] hyprgraph The input hypergraph.
+ * @param[in] options The fingerprint options.
+ * @return Fingerprint128 The fingerprint.
+ */
+template <typename Gnl>
+auto fingerprint(const Gnl &hyprgraph, const FingerprintOptions &options = {}) -> Fingerprint128 {
+    const auto num_modules = hyprgraph.number_of_modules();
+    const auto num_nets = hyprgraph.number_of_nets();
+    auto module_hash = std::vector<std::uint64_t>(num_modules);
+    auto net_hash = std::vector<std::uint64_t>{};
+
+    if (!options.module_relabeling) {
+        net_hash = net_fingerprints(net_pins_csr(hyprgraph));
+        parallel_for(0U, num_modules, [&](size_t lo, size_t hi) {
+            for (auto i = lo; i != hi; ++i) {
+                const auto v = hyprgraph.modules[i];
+                module_hash[i] = hash_combine(v, hyprgraph.get_module_weight(v));
+            }
+        });
+    } else {
+        // Color refinement: module colors and net colors are multiset hashes of each other
+        net_hash.resize(num_nets);
+        auto color = std::vector<std::uint64_t>(hyprgraph.number_of_nodes());
+        parallel_for(0U, num_modules, [&](size_t lo, size_t hi) {
+            for (auto i = lo; i != hi; ++i) {
+                const auto v = hyprgraph.modules[i];
+                color[v] = hash_combine(hyprgraph.get_module_weight(v), hyprgraph.gr.degree(v));
+                if (hyprgraph.module_fixed.contains(v)) {
+                    color[v] = hash_combine(color[v], 1U);
+                }
+            }
+        });
+        auto refine_nets = [&]() {
+            parallel_for(0U, num_nets, [&](size_t lo, size_t hi) {
+                for (auto i = lo; i != hi; ++i) {
+                    const auto net = hyprgraph.nets[i];
+                    auto sum = std::uint64_t{0};
+                    for (const auto &v : hyprgraph.gr[net]) {
+                        sum += hash_mix(color[v]);
+                    }
+                    color[net] = hash_combine(hyprgraph.gr.degree(net), sum);
+                }
+            });
+        };
+        refine_nets();
+        for (auto round = 0U; round < options.refinement_rounds; ++round) {
+            parallel_for(0U, num_modules, [&](size_t lo, size_t hi) {
+                for (auto i = lo; i != hi; ++i) {
+                    const auto v = hyprgraph.modules[i];
+                    auto sum = std::uint64_t{0};
+                    for (const auto &net : hyprgraph.gr[v]) {
+                        sum += hash_mix(color[net]);
+                    }
+                    color[v] = hash_combine(color[v], sum);
+                }
+            });
+            refine_nets();
+        }
+        for (size_t i = 0; i != num_modules; ++i) {
+            module_hash[i] = color[hyprgraph.modules[i]];
+        }
+        for (size_t i = 0; i != num_nets; ++i) {
+            net_hash[i] = color[hyprgraph.nets[i]];
+        }
+    }
+
+    const auto nets = fold_multiset(net_hash);
+    const auto modules = fold_multiset(module_hash);
+    auto header = hash_combine(hash_combine(num_modules, num_nets), hyprgraph.num_pads);
+    header = hash_combine(header, options.module_relabeling ? options.refinement_rounds : 0U);
+    if (!options.module_relabeling) {
+        auto fixed = std::vector<std::uint64_t>{};
+        for (const auto &v : hyprgraph.module_fixed) {
+            fixed.push_back(std::uint64_t(v));
+        }
+        std::sort(fixed.begin(), fixed.end());
+        header = hash_sequence(fixed.begin(), fixed.end(), header);
+    }
+    return Fingerprint128{hash_combine(hash_combine(header, nets.hi), modules.hi),
+                          hash_combine(hash_combine(~header, nets.lo), modules.lo)};
+}
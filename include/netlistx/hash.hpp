@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>  // for uint64_t
+
+/**
+ * @brief Finalizes a 64-bit value with the splitmix64 mixer.
+ *
+ * @param[in] x The value to mix.
+ * @return uint64_t The mixed value, with every input bit affecting every output bit.
+ */
+constexpr auto hash_mix(std::uint64_t x) -> std::uint64_t {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27U)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31U);
+}
+
+/**
+ * @brief Combines a hash with another value (order dependent).
+ *
+ * @param[in] seed The running hash.
+ * @param[in] value The value to fold in.
+ * @return uint64_t The combined hash.
+ */
+constexpr auto hash_combine(std::uint64_t seed, std::uint64_t value) -> std::uint64_t {
+    return hash_mix(seed ^ (hash_mix(value) + (seed << 6U) + (seed >> 2U)));
+}
+
+/**
+ * @brief Hashes a sequence of integers (order dependent).
+ *
+ * @tparam Iter The iterator type.
+ * @param[in] first The beginning of the sequence.
+ * @param[in] last The end of the sequence.
+ * @param[in] seed The initial hash value.
+ * @return uint64_t The hash of the sequence.
+ */
+template <typename Iter>
+constexpr auto hash_sequence(Iter first, Iter last, std::uint64_t seed = 0U) -> std::uint64_t {
+    for (; first != last; ++first) {
+        seed = hash_combine(seed, static_cast<std::uint64_t>(*first));
+    }
+    return seed;
+}
@@ -0,0 +1,305 @@
+#pragma once
+
+#include <algorithm>                  // for min, min_element, sort
+#include <cassert>                    // for assert
+#include <cstddef>                    // for size_t
+#include <cstdint>                    // for uint8_t
+#include <netlistx/csr.hpp>           // for CsrRow
+#include <netlistx/netlist.hpp>       // for index_t
+#include <netlistx/netlist_diff.hpp>  // for EcoDelta, NetSlots
+#include <vector>                     // for vector
+
+/**
+ * @brief Minimum weighted vertex cover that is maintained under ECO edits.
+ *
+ * The engine keeps the state of the primal-dual algorithm of `min_vertex_cover`: the cover bit and
+ * the remaining dual gap of every module, and the number of covered pins and the dual value of
+ * every net (in stable `NetSlots`, so unchanged nets keep their state). After an ECO, `update`
+ * repairs the cover using only the nets and modules named in the `EcoDelta`:
+ *
+ * - Nets that were changed or removed give their dual value back to their old pins.
+ * - A module whose weight decreased below its dual load lowers the duals of its nets until the
+ *   load fits, so the dual solution stays feasible and `dual_cost()` a valid lower bound.
+ * - Touched cover modules whose nets are all covered twice are pruned (heaviest first).
+ * - Changed and added nets that are left uncovered are covered by the primal-dual step.
+ *
+ * The cost of an update is proportional to the pins of the nets named in the delta and of the
+ * nets of the touched modules, not to the size of the design. If the certified ratio
+ * `primal_cost() / dual_cost()` drifts more than `tolerance` above the ratio of the last full
+ * build, the cover is rebuilt from scratch so that quality stays within that tolerance of a full
+ * rerun.
+ *
+ * Net node ids are assumed to follow the module ids, as in `SimpleNetlist`.
+ *
+ * @tparam T The weight type.
+ */
+template <typename T> class IncrementalVertexCover {
+    std::vector<std::uint8_t> _in_cover;  // per module
+    std::vector<T> _weight;               // per module
+    std::vector<T> _gap;                  // per module: weight minus dual load
+    NetSlots _slots;                      // net offset -> slot of the per-net state
+    std::vector<index_t> _count;          // per net slot: number of covered pins
+    std::vector<T> _dual;                 // per net slot: dual value
+    T _total_primal_cost{};
+    T _total_dual_cost{};
+    double _baseline_ratio{1.0};
+    size_t _work{};
+
+  public:
+    /// Allowed relative increase of the primal/dual ratio before `update` rebuilds from scratch
+    double tolerance = 0.05;
+
+    /**
+     * @brief Constructs the cover with a full primal-dual run.
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @tparam C1 The type of the weight function.
+     * @param[in] hyprgraph The input hypergraph.
+     * @param[in] weight The weight function over modules.
+     */
+    template <typename Gnl, typename C1>
+    IncrementalVertexCover(const Gnl &hyprgraph, const C1 &weight) {
+        this->build(hyprgraph, weight);
+    }
+
+    /**
+     * @brief Recomputes the cover from scratch.
+     *
+     * The result is the same as `min_vertex_cover` with an empty initial cover.
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @tparam C1 The type of the weight function.
+     * @param[in] hyprgraph The input hypergraph.
+     * @param[in] weight The weight function over modules.
+     */
+    template <typename Gnl, typename C1> void build(const Gnl &hyprgraph, const C1 &weight) {
+        const auto num_modules = hyprgraph.number_of_modules();
+        this->_in_cover.assign(num_modules, 0U);
+        this->_weight.resize(num_modules);
+        for (size_t v = 0; v != num_modules; ++v) {
+            this->_weight[v] = weight[index_t(v)];
+        }
+        this->_gap = this->_weight;
+        this->_slots.assign(hyprgraph.number_of_nets());
+        this->_count.assign(hyprgraph.number_of_nets(), 0U);
+        this->_dual.assign(hyprgraph.number_of_nets(), T(0));
+        this->_total_primal_cost = T(0);
+        this->_total_dual_cost = T(0);
+        for (const auto &net : hyprgraph.nets) {
+            this->_cover_net(hyprgraph, index_t(net));
+        }
+        this->_baseline_ratio = this->ratio();
+    }
+
+    /**
+     * @brief Repairs the cover after an ECO.
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @tparam C1 The type of the weight function.
+     * @param[in] hyprgraph The new revision of the hypergraph.
+     * @param[in] weight The weight function over the modules of the new revision.
+     * @param[in] delta The delta from the previous revision, e.g. from `diff`.
+     * @return true if the cover was repaired locally, false if it was rebuilt.
+     */
+    template <typename Gnl, typename C1>
+    auto update(const Gnl &hyprgraph, const C1 &weight, const EcoDelta &delta) -> bool {
+        const auto num_modules = hyprgraph.number_of_modules();
+        const auto base = index_t(num_modules);
+        const auto old_base = index_t(this->_in_cover.size());
+        this->_work = 0U;
+
+        // Removed and changed nets give their dual back to the old pins that remain
+        auto give_back = [&](index_t old_net, CsrRow old_pins) {
+            const auto slot = this->_slots[old_net - old_base];
+            const auto dual = this->_dual[slot];
+            this->_total_dual_cost -= dual;
+            this->_dual[slot] = T(0);
+            for (const auto v : old_pins) {
+                if (v < num_modules) {
+                    this->_gap[v] += dual;
+                }
+            }
+            this->_work += old_pins.size();
+        };
+        const auto num_removed = delta.removed_nets.size();
+        for (size_t k = 0; k != num_removed; ++k) {
+            give_back(delta.removed_nets[k], delta.old_pins[k]);
+        }
+        for (size_t k = 0; k != delta.changed_nets.size(); ++k) {
+            give_back(delta.changed_nets[k].first, delta.old_pins[num_removed + k]);
+        }
+
+        // Modules: drop removed ones, add new ones, apply weight changes
+        for (auto v = num_modules; v < this->_in_cover.size(); ++v) {
+            if (this->_in_cover[v] != 0U) {
+                this->_total_primal_cost -= this->_weight[v];
+            }
+        }
+        this->_in_cover.resize(num_modules, 0U);
+        this->_weight.resize(num_modules);
+        this->_gap.resize(num_modules);
+        for (const auto v : delta.added_modules) {
+            this->_weight[v] = weight[v];
+            this->_gap[v] = this->_weight[v];
+        }
+        for (const auto v : delta.changed_modules) {
+            const auto new_weight = T(weight[v]);
+            if (this->_in_cover[v] != 0U) {
+                this->_total_primal_cost += new_weight - this->_weight[v];
+            }
+            this->_gap[v] += new_weight - this->_weight[v];
+            this->_weight[v] = new_weight;
+        }
+        this->_work += delta.added_modules.size() + delta.changed_modules.size();
+
+        // Nets: unchanged nets keep their slot, changed and added nets are recounted
+        this->_slots.apply(delta, old_base, base, hyprgraph.number_of_nets());
+        this->_count.resize(this->_slots.size(), 0U);
+        this->_dual.resize(this->_slots.size(), T(0));
+        auto recount = [&](index_t net) {
+            const auto slot = this->_slots[net - base];
+            auto &count = this->_count[slot];
+            count = 0U;
+            for (const auto &v : hyprgraph.gr[net]) {
+                count += this->_in_cover[v];
+            }
+            this->_dual[slot] = T(0);
+            this->_work += hyprgraph.gr.degree(net);
+        };
+        for (const auto &nets : delta.changed_nets) {
+            recount(nets.second);
+        }
+        for (const auto net : delta.added_nets) {
+            recount(net);
+        }
+
+        // A module that got lighter than its dual load lowers the duals of its nets until the
+        // load fits; the pins of those nets get the difference back
+        for (const auto v : delta.changed_modules) {
+            for (const auto &net : hyprgraph.gr[v]) {
+                if (!(this->_gap[v] < T(0))) {
+                    break;
+                }
+                const auto slot = this->_slots[net - base];
+                const auto cut = std::min(this->_dual[slot], T(0) - this->_gap[v]);
+                this->_dual[slot] -= cut;
+                this->_total_dual_cost -= cut;
+                for (const auto &u : hyprgraph.gr[net]) {
+                    this->_gap[u] += cut;
+                }
+                this->_work += hyprgraph.gr.degree(net);
+            }
+        }
+
+        // Prune touched cover modules that are no longer needed
+        auto candidates = std::vector<index_t>{};
+        for (const auto v : delta.touched_modules) {
+            if (this->_in_cover[v] != 0U) {
+                candidates.push_back(v);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [&](index_t v1, index_t v2) {
+            return this->_weight[v2] < this->_weight[v1];
+        });
+        for (const auto v : candidates) {
+            this->_work += hyprgraph.gr.degree(v);
+            auto redundant = true;
+            for (const auto &net : hyprgraph.gr[v]) {
+                if (this->_count[this->_slots[net - base]] < 2U) {
+                    redundant = false;
+                    break;
+                }
+            }
+            if (!redundant) {
+                continue;
+            }
+            this->_in_cover[v] = 0U;
+            this->_total_primal_cost -= this->_weight[v];
+            for (const auto &net : hyprgraph.gr[v]) {
+                --this->_count[this->_slots[net - base]];
+            }
+        }
+
+        // Cover the changed and added nets that are left uncovered
+        for (const auto &nets : delta.changed_nets) {
+            this->_cover_net(hyprgraph, nets.second);
+        }
+        for (const auto net : delta.added_nets) {
+            this->_cover_net(hyprgraph, net);
+        }
+
+        if (this->ratio() > this->_baseline_ratio * (1.0 + this->tolerance)) {
+            this->build(hyprgraph, weight);
+            return false;
+        }
+        return true;
+    }
+
+    /// Whether module `v` is in the cover
+    auto contains(index_t v) const -> bool { return this->_in_cover[v] != 0U; }
+
+    /// The total weight of the cover
+    auto primal_cost() const -> T { return this->_total_primal_cost; }
+
+    /// The value of the dual solution, a lower bound of the optimum
+    auto dual_cost() const -> T { return this->_total_dual_cost; }
+
+    /// The certified approximation ratio of the current cover
+    auto ratio() const -> double {
+        return this->_total_dual_cost > T(0)
+                   ? double(this->_total_primal_cost) / double(this->_total_dual_cost)
+                   : 1.0;
+    }
+
+    /// Number of covered pins of the net at offset `i`
+    auto cover_count(size_t i) const -> index_t { return this->_count[this->_slots[i]]; }
+
+    /// The dual value of the net at offset `i`
+    auto net_dual(size_t i) const -> T { return this->_dual[this->_slots[i]]; }
+
+    /// Number of pins and modules visited by the last `update`
+    auto work() const -> size_t { return this->_work; }
+
+    /**
+     * @brief Copies the cover into a set.
+     *
+     * @tparam C2 The type of the cover set.
+     * @param[out] coverset The set receiving the cover modules.
+     */
+    template <typename C2> void export_to(C2 &coverset) const {
+        for (size_t v = 0; v != this->_in_cover.size(); ++v) {
+            if (this->_in_cover[v] != 0U) {
+                coverset.insert(index_t(v));
+            }
+        }
+    }
+
+  private:
+    /**
+     * @brief The primal-dual step of `min_vertex_cover` for one net.
+     */
+    template <typename Gnl> void _cover_net(const Gnl &hyprgraph, index_t net) {
+        const auto base = index_t(hyprgraph.number_of_modules());
+        const auto &pins = hyprgraph.gr[net];
+        const auto slot = this->_slots[net - base];
+        if (this->_count[slot] != 0U || pins.empty()) {
+            return;
+        }
+        const auto min_vtx = index_t(*std::min_element(
+            pins.begin(), pins.end(),
+            [&](const auto &v1, const auto &v2) { return this->_gap[v1] < this->_gap[v2]; }));
+        const auto min_val = this->_gap[min_vtx];
+        this->_in_cover[min_vtx] = 1U;
+        this->_total_primal_cost += this->_weight[min_vtx];
+        this->_total_dual_cost += min_val;
+        this->_dual[slot] += min_val;
+        for (const auto &u : pins) {
+            this->_gap[u] -= min_val;
+        }
+        for (const auto &net2 : hyprgraph.gr[min_vtx]) {
+            ++this->_count[this->_slots[net2 - base]];
+        }
+        this->_work += pins.size() + hyprgraph.gr.degree(min_vtx);
+        assert(this->_total_dual_cost <= this->_total_primal_cost);
+    }
+};
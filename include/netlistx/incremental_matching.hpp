@@ -0,0 +1,248 @@
+#pragma once
+
+#include <algorithm>                  // for sort, unique
+#include <cstddef>                    // for size_t
+#include <cstdint>                    // for uint8_t
+#include <netlistx/csr.hpp>           // for CsrRow
+#include <netlistx/netlist.hpp>       // for index_t
+#include <netlistx/netlist_diff.hpp>  // for EcoDelta, NetSlots
+#include <vector>                     // for vector
+
+/**
+ * @brief Minimum weighted maximal matching that is maintained under ECO edits.
+ *
+ * The engine keeps the state of `min_maximal_matching`: the matched flag and the dual gap of every
+ * net (in stable `NetSlots`, so unchanged nets keep their state), and for every module the matched
+ * net that covers it (the `dep` set of the batch algorithm, stored as an owner array). After an
+ * ECO, `update`
+ *
+ * - drops matched nets that were removed or changed and frees the modules they covered (their
+ *   old pins come with the `EcoDelta`),
+ * - and re-runs the primal-dual selection on the changed and added nets and on every net
+ *   incident to a freed module, which restores maximality.
+ *
+ * Each repaired net costs O(degree^2) like one step of the batch algorithm, so an update costs
+ * O(sum of degree^2 over the touched nets), independent of the size of the design.
+ *
+ * Net node ids are assumed to follow the module ids, as in `SimpleNetlist`.
+ *
+ * @tparam T The weight type.
+ */
+template <typename T> class IncrementalMatching {
+    static constexpr index_t npos = EcoDelta::npos;
+
+    NetSlots _slots;                     // net offset -> slot of the per-net state
+    std::vector<std::uint8_t> _matched;  // per net slot
+    std::vector<T> _weight;              // per net slot
+    std::vector<T> _gap;                 // per net slot
+    std::vector<index_t> _owner;         // per module: slot of the matched net covering it
+    T _total_primal_cost{};
+    size_t _work{};
+
+  public:
+    /**
+     * @brief Constructs the matching with a full primal-dual run.
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @tparam C1 The type of the weight function.
+     * @param[in] hyprgraph The input hypergraph.
+     * @param[in] weight The weight function over nets.
+     */
+    template <typename Gnl, typename C1>
+    IncrementalMatching(const Gnl &hyprgraph, const C1 &weight) {
+        this->build(hyprgraph, weight);
+    }
+
+    /**
+     * @brief Recomputes the matching from scratch.
+     *
+     * The result is the same as `min_maximal_matching` with empty initial sets.
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @tparam C1 The type of the weight function.
+     * @param[in] hyprgraph The input hypergraph.
+     * @param[in] weight The weight function over nets.
+     */
+    template <typename Gnl, typename C1> void build(const Gnl &hyprgraph, const C1 &weight) {
+        const auto num_nets = hyprgraph.number_of_nets();
+        this->_slots.assign(num_nets);
+        this->_matched.assign(num_nets, 0U);
+        this->_weight.resize(num_nets);
+        for (size_t i = 0; i != num_nets; ++i) {
+            this->_weight[i] = weight[hyprgraph.nets[i]];
+        }
+        this->_gap = this->_weight;
+        this->_owner.assign(hyprgraph.number_of_modules(), npos);
+        this->_total_primal_cost = T(0);
+        for (const auto &net : hyprgraph.nets) {
+            this->_match_near(hyprgraph, index_t(net));
+        }
+    }
+
+    /**
+     * @brief Repairs the matching after an ECO.
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @tparam C1 The type of the weight function.
+     * @param[in] hyprgraph The new revision of the hypergraph.
+     * @param[in] weight The weight function over the nets of the new revision.
+     * @param[in] delta The delta from the previous revision, e.g. from `diff`.
+     */
+    template <typename Gnl, typename C1>
+    void update(const Gnl &hyprgraph, const C1 &weight, const EcoDelta &delta) {
+        const auto base = index_t(hyprgraph.number_of_modules());
+        const auto old_base = index_t(this->_owner.size());
+        this->_work = 0U;
+
+        // Changed and removed matched nets are dropped; the modules they covered become free
+        auto freed = std::vector<index_t>{};
+        auto drop = [&](index_t old_net, CsrRow old_pins) {
+            const auto slot = this->_slots[old_net - old_base];
+            if (this->_matched[slot] == 0U) {
+                return;
+            }
+            this->_matched[slot] = 0U;
+            this->_total_primal_cost -= this->_weight[slot];
+            for (const auto v : old_pins) {
+                if (v < base && this->_owner[v] == slot) {
+                    this->_owner[v] = npos;
+                    freed.push_back(v);
+                }
+            }
+            this->_work += old_pins.size();
+        };
+        const auto num_removed = delta.removed_nets.size();
+        for (size_t k = 0; k != num_removed; ++k) {
+            drop(delta.removed_nets[k], delta.old_pins[k]);
+        }
+        for (size_t k = 0; k != delta.changed_nets.size(); ++k) {
+            drop(delta.changed_nets[k].first, delta.old_pins[num_removed + k]);
+        }
+        this->_owner.resize(base, npos);
+
+        // Unchanged nets keep their slot; changed and added nets start afresh
+        this->_slots.apply(delta, old_base, base, hyprgraph.number_of_nets());
+        this->_matched.resize(this->_slots.size(), 0U);
+        this->_weight.resize(this->_slots.size());
+        this->_gap.resize(this->_slots.size());
+        auto candidates = std::vector<index_t>{};
+        auto reset = [&](index_t net) {
+            const auto slot = this->_slots[net - base];
+            this->_matched[slot] = 0U;
+            this->_weight[slot] = T(weight[net]);
+            this->_gap[slot] = this->_weight[slot];
+            candidates.push_back(net);
+        };
+        for (const auto &nets : delta.changed_nets) {
+            reset(nets.second);
+        }
+        for (const auto net : delta.added_nets) {
+            reset(net);
+        }
+
+        // Restore maximality around the freed modules and the new nets
+        for (const auto v : freed) {
+            for (const auto &net : hyprgraph.gr[v]) {
+                candidates.push_back(index_t(net));
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        for (const auto net : candidates) {
+            this->_match_near(hyprgraph, net);
+        }
+    }
+
+    /// Whether the net at offset `i` is in the matching
+    auto is_matched(size_t i) const -> bool { return this->_matched[this->_slots[i]] != 0U; }
+
+    /// Whether module `v` is covered by a matched net (i.e. `v` is in `dep`)
+    auto is_covered(index_t v) const -> bool { return this->_owner[v] != npos; }
+
+    /// Offset of the matched net covering module `v`, or `EcoDelta::npos`
+    auto owner(index_t v) const -> index_t {
+        return this->_owner[v] == npos ? npos : this->_slots.offset(this->_owner[v]);
+    }
+
+    /// Number of pins and nets visited by the last `update`
+    auto work() const -> size_t { return this->_work; }
+
+    /// The total weight of the matching
+    auto primal_cost() const -> T { return this->_total_primal_cost; }
+
+    /**
+     * @brief Copies the matching into the `matchset` and `dep` sets of `min_maximal_matching`.
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @tparam C2 The type of the sets.
+     * @param[in] hyprgraph The hypergraph the matching belongs to.
+     * @param[out] matchset The matched nets.
+     * @param[out] dep The covered modules.
+     */
+    template <typename Gnl, typename C2>
+    void export_to(const Gnl &hyprgraph, C2 &matchset, C2 &dep) const {
+        for (size_t i = 0; i != hyprgraph.number_of_nets(); ++i) {
+            if (this->is_matched(i)) {
+                matchset.insert(hyprgraph.nets[i]);
+            }
+        }
+        for (size_t v = 0; v != this->_owner.size(); ++v) {
+            if (this->_owner[v] != npos) {
+                dep.insert(index_t(v));
+            }
+        }
+    }
+
+  private:
+    /**
+     * @brief Free means no pin of the net is covered by a matched net.
+     */
+    template <typename Gnl> auto _is_free(const Gnl &hyprgraph, index_t net) const -> bool {
+        for (const auto &v : hyprgraph.gr[net]) {
+            if (this->_owner[v] != npos) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief The primal-dual step of `min_maximal_matching` for one net.
+     */
+    template <typename Gnl> void _match_near(const Gnl &hyprgraph, index_t net) {
+        const auto base = index_t(hyprgraph.number_of_modules());
+        this->_work += hyprgraph.gr.degree(net);
+        if (hyprgraph.gr[net].empty() || !this->_is_free(hyprgraph, net)) {
+            return;
+        }
+        auto gap = [&](const auto &net2) -> T & { return this->_gap[this->_slots[net2 - base]]; };
+        auto min_val = gap(net);
+        auto min_net = net;
+        for (const auto &v : hyprgraph.gr[net]) {
+            for (const auto &net2 : hyprgraph.gr[v]) {
+                this->_work += hyprgraph.gr.degree(net2);
+                if (!this->_is_free(hyprgraph, index_t(net2))) {
+                    continue;
+                }
+                if (min_val > gap(net2)) {
+                    min_val = gap(net2);
+                    min_net = index_t(net2);
+                }
+            }
+        }
+        const auto min_slot = this->_slots[min_net - base];
+        this->_matched[min_slot] = 1U;
+        for (const auto &v : hyprgraph.gr[min_net]) {
+            this->_owner[v] = min_slot;
+        }
+        this->_total_primal_cost += this->_weight[min_slot];
+        if (min_net != net) {
+            gap(net) -= min_val;
+            for (const auto &v : hyprgraph.gr[net]) {
+                for (const auto &net2 : hyprgraph.gr[v]) {
+                    gap(net2) -= min_val;
+                }
+            }
+        }
+    }
+};
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>              // for sort, max
+#include <atomic>                 // for atomic
+#include <cstddef>                // for size_t
+#include <cstdint>                // for uint8_t
+#include <netlistx/netlist.hpp>   // for index_t
+#include <netlistx/parallel.hpp>  // for parallel_blocks, num_blocks_for
+#include <utility>                // for pair, swap
+#include <vector>                 // for vector
+
+/**
+ * @brief Result of a hypergraph k-core decomposition.
+ */
+struct CoreDecomposition {
+    std::vector<index_t> core;   ///< Core number of every module
+    std::vector<index_t> order;  ///< Modules in peeling order
+    index_t max_core{};          ///< Largest core number
+};
+
+/**
+ * @brief Computes the core numbers of the modules of a hypergraph.
+ *
+ * The degree of a module is the number of its nets that are still alive, and a net stays alive
+ * while it has at least two unpeeled pins. The k-core is what remains after repeatedly peeling
+ * modules of degree less than k. Modules are peeled with the bucket algorithm of Batagelj and
+ * Zaversnik: the buckets are indexed by degree (at most `max_degree`), every peel and every
+ * degree decrement is O(1), and every net is scanned once when it dies, so the total time is
+ * linear in the number of pins.
+ *
+ * Net node ids are assumed to follow the module ids, as in `SimpleNetlist`.
+ *
+ * @tparam Gnl The type of the hypergraph.
+ * @param[in] hyprgraph The input hypergraph.
+ * @return CoreDecomposition The core numbers and the peeling order.
+ */
+template <typename Gnl> auto core_decomposition(const Gnl &hyprgraph) -> CoreDecomposition {
+    const auto num_modules = hyprgraph.number_of_modules();
+    const auto base = index_t(num_modules);
+    auto alive = std::vector<index_t>(hyprgraph.number_of_nets());  // unpeeled pins per net
+    for (const auto &net : hyprgraph.nets) {
+        alive[net - base] = index_t(hyprgraph.gr.degree(net));
+    }
+    auto deg = std::vector<index_t>(num_modules, 0U);
+    auto max_deg = index_t{0};
+    for (size_t v = 0; v != num_modules; ++v) {
+        for (const auto &net : hyprgraph.gr[index_t(v)]) {
+            deg[v] += alive[net - base] >= 2U ? 1U : 0U;
+        }
+        max_deg = std::max(max_deg, deg[v]);
+    }
+
+    // Bucket sort of the modules by degree
+    auto bin = std::vector<size_t>(max_deg + 2U, 0U);
+    for (const auto d : deg) {
+        ++bin[d + 1U];
+    }
+    for (size_t d = 1; d < bin.size(); ++d) {
+        bin[d] += bin[d - 1];
+    }
+    auto result = CoreDecomposition{};
+    auto &vert = result.order;
+    vert.resize(num_modules);
+    auto pos = std::vector<size_t>(num_modules);
+    {
+        auto next = bin;
+        for (size_t v = 0; v != num_modules; ++v) {
+            pos[v] = next[deg[v]]++;
+            vert[pos[v]] = index_t(v);
+        }
+    }
+
+    auto peeled = std::vector<std::uint8_t>(num_modules, 0U);
+    auto decrement = [&](index_t u) {  // move u from bucket deg[u] to deg[u] - 1
+        const auto du = deg[u];
+        const auto pw = bin[du];
+        const auto w = vert[pw];
+        if (u != w) {
+            std::swap(vert[pos[u]], vert[pw]);
+            pos[w] = pos[u];
+            pos[u] = pw;
+        }
+        ++bin[du];
+        --deg[u];
+    };
+    result.core.resize(num_modules);
+    for (size_t i = 0; i != num_modules; ++i) {
+        const auto v = vert[i];
+        peeled[v] = 1U;
+        result.core[v] = deg[v];
+        result.max_core = std::max(result.max_core, deg[v]);
+        for (const auto &net : hyprgraph.gr[v]) {
+            auto &count = alive[net - base];
+            if (count-- != 2U) {
+                continue;  // the net was already dead or stays alive
+            }
+            for (const auto &u : hyprgraph.gr[net]) {  // the net dies: release the survivor
+                if (peeled[u] == 0U) {
+                    if (deg[u] > deg[v]) {
+                        decrement(index_t(u));
+                    }
+                    break;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Computes the core numbers of the modules of a hypergraph in parallel.
+ *
+ * Same result as `core_decomposition`, peeling by frontiers: at level k all unpeeled modules of
+ * degree at most k are peeled at once, in parallel, with atomic pin counters per net and atomic
+ * degrees per module; modules whose degree drops to k join the next frontier of the same level,
+ * the others are re-filed into the bucket of their new degree. Every pin is handled a constant
+ * number of times, so the work stays linear in the number of pins. Within a frontier the peeling
+ * order is by module id.
+ *
+ * Net node ids are assumed to follow the module ids, as in `SimpleNetlist`.
+ *
+ * @tparam Gnl The type of the hypergraph.
+ * @param[in] hyprgraph The input hypergraph.
+ * @return CoreDecomposition The core numbers and the peeling order.
+ */
+template <typename Gnl>
+auto parallel_core_decomposition(const Gnl &hyprgraph) -> CoreDecomposition {
+    const auto num_modules = hyprgraph.number_of_modules();
+    const auto num_nets = hyprgraph.number_of_nets();
+    const auto base = index_t(num_modules);
+    auto alive = std::vector<std::atomic<index_t>>(num_nets);
+    parallel_for(0U, num_nets, [&](size_t lo, size_t hi) {
+        for (auto i = lo; i != hi; ++i) {
+            alive[i].store(index_t(hyprgraph.gr.degree(base + index_t(i))));
+        }
+    });
+    auto deg = std::vector<std::atomic<index_t>>(num_modules);
+    auto peeled = std::vector<std::atomic<std::uint8_t>>(num_modules);
+    parallel_for(0U, num_modules, [&](size_t lo, size_t hi) {
+        for (auto v = lo; v != hi; ++v) {
+            auto d = index_t{0};
+            for (const auto &net : hyprgraph.gr[index_t(v)]) {
+                d += alive[net - base].load() >= 2U ? 1U : 0U;
+            }
+            deg[v].store(d);
+            peeled[v].store(0U);
+        }
+    });
+
+    auto buckets = std::vector<std::vector<index_t>>{};
+    auto file = [&](index_t v, index_t d) {
+        if (buckets.size() <= d) {
+            buckets.resize(d + 1U);
+        }
+        buckets[d].push_back(v);
+    };
+    for (size_t v = 0; v != num_modules; ++v) {
+        file(index_t(v), deg[v].load());
+    }
+
+    auto result = CoreDecomposition{};
+    result.core.resize(num_modules);
+    result.order.reserve(num_modules);
+    auto frontier = std::vector<index_t>{};
+    for (index_t k = 0; k < buckets.size(); ++k) {
+        frontier.clear();
+        for (const auto v : buckets[k]) {
+            if (peeled[v].load() == 0U && deg[v].load() == k) {
+                peeled[v].store(1U);  // also removes duplicate entries
+                frontier.push_back(v);
+            }
+        }
+        std::vector<index_t>().swap(buckets[k]);
+        while (!frontier.empty()) {
+            std::sort(frontier.begin(), frontier.end());
+            for (const auto v : frontier) {
+                result.core[v] = k;
+                result.order.push_back(v);
+            }
+            result.max_core = k;
+            const auto num_blocks = num_blocks_for(frontier.size(), 1024U);
+            auto next = std::vector<std::vector<index_t>>(num_blocks);
+            auto refile = std::vector<std::vector<std::pair<index_t, index_t>>>(num_blocks);
+            parallel_blocks(0U, frontier.size(), num_blocks, [&](size_t b, size_t lo, size_t hi) {
+                for (auto i = lo; i != hi; ++i) {
+                    for (const auto &net : hyprgraph.gr[frontier[i]]) {
+                        if (alive[net - base].fetch_sub(1U) != 2U) {
+                            continue;
+                        }
+                        for (const auto &u : hyprgraph.gr[net]) {
+                            if (peeled[u].load() != 0U) {
+                                continue;
+                            }
+                            const auto du = deg[u].fetch_sub(1U) - 1U;
+                            if (du == k) {
+                                next[b].push_back(index_t(u));
+                            } else if (du > k) {
+                                refile[b].emplace_back(index_t(u), du);
+                            }
+                            break;
+                        }
+                    }
+                }
+            });
+            frontier.clear();
+            for (size_t b = 0; b != num_blocks; ++b) {
+                for (const auto u : next[b]) {
+                    if (peeled[u].load() == 0U) {
+                        peeled[u].store(1U);
+                        frontier.push_back(u);
+                    }
+                }
+                for (const auto &entry : refile[b]) {
+                    file(entry.first, entry.second);
+                }
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstddef>                        // for size_t
+#include <vector>                         // for vector
+
+/**
+ * @brief A read-only view of the bytes of a file.
+ *
+ * On POSIX systems the file is memory-mapped, so opening costs no read and pages are loaded on
+ * demand; elsewhere the file is read into a buffer.
+ */
+class MappedFile {
+    const unsigned char *_data = nullptr;
+    size_t _size = 0;
+    bool _mapped = false;
+    std::vector<unsigned char> _buffer;  // fallback storage
+
+  public:
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    auto operator=(const MappedFile &) -> MappedFile & = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    auto operator=(MappedFile &&other) noexcept -> MappedFile &;
+    ~MappedFile() { this->close(); }
+
+    /**
+     * @brief Opens (maps) a file, closing the current one.
+     *
+     * @param[in] fileName The path of the file.
+     * @return true on success.
+     */
+    auto open(boost::string_view fileName) -> bool;
+
+    /// Unmaps the file.
+    void close();
+
+    /// The bytes of the file
+    auto data() const -> const unsigned char * { return this->_data; }
+
+    /// The size of the file, in bytes
+    auto size() const -> size_t { return this->_size; }
+
+    /// Whether the bytes are memory-mapped (rather than copied)
+    auto is_mapped() const -> bool { return this->_mapped; }
+};
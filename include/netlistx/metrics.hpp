@@ -0,0 +1,249 @@
+#pragma once
+
+#include <array>    // for array
+#include <atomic>   // for atomic, memory_order_relaxed
+#include <chrono>   // for steady_clock, duration_cast, nanoseconds
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint16_t, uint64_t, int64_t
+#include <map>      // for map
+#include <memory>   // for unique_ptr
+#include <mutex>    // for mutex
+#include <string>   // for string
+#include <thread>   // for thread
+#include <utility>  // for pair
+#include <vector>   // for vector
+
+/**
+ * @brief Number of shards of the counters and histograms.
+ *
+ * Every thread updates the shard picked by `metrics_shard()`, so concurrent updates from up to
+ * this many threads touch different cache lines; reads add up all shards.
+ */
+constexpr size_t metrics_num_shards = 8;
+
+/// The shard of the calling thread (threads are assigned round-robin on first use)
+inline auto metrics_shard() -> size_t {
+    static auto next = std::atomic<size_t>{0};
+    thread_local const auto shard
+        = next.fetch_add(1U, std::memory_order_relaxed) % metrics_num_shards;
+    return shard;
+}
+
+/**
+ * @brief A monotonically increasing counter (lock-free, sharded per thread).
+ */
+class Counter {
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> value{0};
+    };
+    std::array<Shard, metrics_num_shards> _shards{};
+
+  public:
+    /// Adds `n` to the counter.
+    void inc(std::uint64_t n = 1) {
+        this->_shards[metrics_shard()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /// The current value
+    auto value() const -> std::uint64_t;
+};
+
+/**
+ * @brief A value that can go up and down (queue depth, memory in use, busy workers).
+ */
+class Gauge {
+    std::atomic<std::int64_t> _value{0};
+
+  public:
+    void set(std::int64_t value) { this->_value.store(value, std::memory_order_relaxed); }
+    void add(std::int64_t delta) { this->_value.fetch_add(delta, std::memory_order_relaxed); }
+    auto value() const -> std::int64_t { return this->_value.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @brief A consistent copy of the buckets of a `Histogram`.
+ */
+struct HistogramSnapshot {
+    std::vector<std::uint64_t> counts;  ///< Count of every bucket
+    std::uint64_t count{};              ///< Number of recorded values
+    std::uint64_t sum{};                ///< Sum of the recorded values
+
+    /**
+     * @brief The value at quantile `q`, within the relative precision of the buckets.
+     *
+     * @param[in] q The quantile, in [0, 1].
+     * @return The upper bound of the bucket holding the quantile (0 if the histogram is empty).
+     */
+    auto quantile(double q) const -> std::uint64_t;
+};
+
+/**
+ * @brief A high-dynamic-range histogram of non-negative integer values (e.g. nanoseconds).
+ *
+ * Values are counted in log-linear buckets: 16 linear sub-buckets per power of two, so every
+ * value from 0 to 2^64 - 1 is stored with a relative error below 1/16 in 976 buckets. Recording
+ * is two relaxed atomic additions on the shard of the calling thread.
+ */
+class Histogram {
+  public:
+    static constexpr unsigned sub_bucket_bits = 4;
+    static constexpr size_t num_buckets = (64 - sub_bucket_bits + 1) << sub_bucket_bits;
+
+  private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<std::uint64_t>, num_buckets> counts{};
+        std::atomic<std::uint64_t> sum{0};
+    };
+    std::unique_ptr<Shard[]> _shards;
+    double _unit;
+
+  public:
+    /**
+     * @brief Constructs an empty histogram.
+     *
+     * @param[in] unit The size of one recorded unit in the exported metric, e.g. 1e-9 to record
+     *                 nanoseconds and export seconds.
+     */
+    explicit Histogram(double unit = 1.0);
+
+    /// The bucket of `value`
+    static auto bucket_of(std::uint64_t value) -> size_t {
+        if (value < (1U << sub_bucket_bits)) {
+            return static_cast<size_t>(value);
+        }
+        auto exponent = 63U;
+        while ((value >> exponent) == 0U) {
+            --exponent;
+        }
+        const auto sub = (value >> (exponent - sub_bucket_bits)) & ((1U << sub_bucket_bits) - 1U);
+        return ((exponent - sub_bucket_bits + 1U) << sub_bucket_bits) + sub;
+    }
+
+    /// The largest value of bucket `b`
+    static auto upper_bound_of(size_t b) -> std::uint64_t;
+
+    /// Records a value.
+    void record(std::uint64_t value) {
+        auto &shard = this->_shards[metrics_shard()];
+        shard.counts[bucket_of(value)].fetch_add(1U, std::memory_order_relaxed);
+        shard.sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /// The size of one recorded unit in the exported metric
+    auto unit() const -> double { return this->_unit; }
+
+    /// Copies the buckets.
+    auto snapshot() const -> HistogramSnapshot;
+};
+
+/**
+ * @brief Records the lifetime of the timer, in nanoseconds, into a histogram.
+ *
+ *     {
+ *         auto timer = ScopedTimer{latency};
+ *         handle(request);
+ *     }
+ */
+class ScopedTimer {
+    Histogram &_histogram;
+    std::chrono::steady_clock::time_point _start;
+
+  public:
+    explicit ScopedTimer(Histogram &histogram)
+        : _histogram{histogram}, _start{std::chrono::steady_clock::now()} {}
+    ScopedTimer(const ScopedTimer &) = delete;
+    auto operator=(const ScopedTimer &) -> ScopedTimer & = delete;
+    ~ScopedTimer() {
+        const auto elapsed = std::chrono::steady_clock::now() - this->_start;
+        this->_histogram.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+};
+
+/// Metric labels, e.g. {{"type", "partition"}}
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief A set of named metrics, exported in the Prometheus text format.
+ *
+ * Registration takes a lock and returns a reference that stays valid for the lifetime of the
+ * registry; hot paths should keep the reference and update the metric without any lookup.
+ * Registering the same name and labels again returns the existing metric.
+ *
+ *     auto &requests = registry.counter("netlistx_requests_total", "Requests", {{"type", "read"}});
+ *     auto &latency = registry.histogram("netlistx_request_seconds", "Latency", {}, 1e-9);
+ *     auto &queue = registry.gauge("netlistx_queue_depth", "Queued requests");
+ */
+class MetricsRegistry {
+    struct Family {
+        std::string help;
+        char type{};  // 'c'ounter, 'g'auge or 'h'istogram
+        std::vector<std::pair<std::string, std::unique_ptr<Counter>>> counters;
+        std::vector<std::pair<std::string, std::unique_ptr<Gauge>>> gauges;
+        std::vector<std::pair<std::string, std::unique_ptr<Histogram>>> histograms;
+    };
+    mutable std::mutex _mutex;
+    std::map<std::string, Family> _families;
+
+    auto _family(const std::string &name, const std::string &help, char type) -> Family &;
+
+  public:
+    /// The counter with the given name and labels (created on first use)
+    auto counter(const std::string &name, const std::string &help,
+                 const MetricLabels &labels = {}) -> Counter &;
+
+    /// The gauge with the given name and labels (created on first use)
+    auto gauge(const std::string &name, const std::string &help,
+               const MetricLabels &labels = {}) -> Gauge &;
+
+    /// The histogram with the given name and labels (created on first use with `unit`)
+    auto histogram(const std::string &name, const std::string &help,
+                   const MetricLabels &labels = {}, double unit = 1.0) -> Histogram &;
+
+    /**
+     * @brief Renders all metrics in the Prometheus text exposition format (version 0.0.4).
+     *
+     * Histograms are exported with one cumulative bucket per power of two between their lowest
+     * and highest non-empty buckets, plus `+Inf`, `_sum` and `_count`.
+     *
+     * @return The metrics, sorted by name.
+     */
+    auto render() const -> std::string;
+};
+
+/**
+ * @brief A minimal HTTP endpoint serving `MetricsRegistry::render()` (POSIX only).
+ *
+ * A background thread accepts one connection at a time and answers `GET /metrics` (and `GET /`)
+ * with the rendered metrics. Scrapes never block the threads that update the metrics.
+ */
+class MetricsServer {
+    const MetricsRegistry &_registry;
+    int _socket = -1;
+    std::uint16_t _port = 0;
+    std::atomic<bool> _running{false};
+    std::thread _thread;
+
+    void _serve();
+
+  public:
+    explicit MetricsServer(const MetricsRegistry &registry) : _registry{registry} {}
+    MetricsServer(const MetricsServer &) = delete;
+    auto operator=(const MetricsServer &) -> MetricsServer & = delete;
+    ~MetricsServer() { this->stop(); }
+
+    /**
+     * @brief Starts listening on the loopback interface.
+     *
+     * @param[in] port The TCP port, or 0 to pick a free one (see `port()`).
+     * @return true on success; false if the port cannot be bound, the server is already
+     *         running, or sockets are not supported on this platform.
+     */
+    auto start(std::uint16_t port) -> bool;
+
+    /// The port the server listens on
+    auto port() const -> std::uint16_t { return this->_port; }
+
+    /// Stops the server and joins its thread.
+    void stop();
+};
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstddef>                        // for size_t
+#include <cstdint>                        // for int64_t, uint32_t, uint64_t
+#include <netlistx/netlist.hpp>           // for SimpleNetlist, index_t
+#include <string>                         // for string
+#include <utility>                        // for pair
+#include <vector>                         // for vector
+
+/**
+ * @brief Random-access index of an IBM .netD/.net file.
+ *
+ * Records the byte offset of the first pin line (the `s` line) of every net, so any range of nets
+ * can be read by seeking, and the range of module ids of every group of `group_size` nets, so
+ * the nets touching a range of modules can be found without parsing the whole file. The index is
+ * stored next to the netlist as a binary sidecar (`<file>.idx`) and is tied to the size, the
+ * modification time and a sampled content hash (the header and evenly spaced blocks) of the file
+ * it was built from, so an edit that keeps the size still invalidates it.
+ */
+struct NetDIndex {
+    static constexpr size_t group_size = 256;
+
+    std::uint64_t file_size{};     ///< Size of the indexed file, in bytes
+    std::int64_t file_mtime{};     ///< Last write time of the indexed file, in file clock ticks
+    std::uint64_t content_hash{};  ///< Hash of the header and of sampled blocks of the file
+    std::uint32_t num_pins{};
+    std::uint32_t num_nets{};
+    std::uint32_t num_modules{};
+    std::uint32_t pad_offset{};
+    /// Byte offset of every net; the last entry is the end of the pin section
+    std::vector<std::uint64_t> net_offsets;
+    /// (min, max) module id of every group of `group_size` consecutive nets
+    std::vector<std::pair<index_t, index_t>> module_ranges;
+
+    /**
+     * @brief The ranges of nets that may touch modules in [`first`, `last`].
+     *
+     * @param[in] first The smallest module id.
+     * @param[in] last The largest module id.
+     * @return std::vector<std::pair<index_t, index_t>> Disjoint [begin, end) ranges of nets.
+     */
+    auto nets_touching(index_t first, index_t last) const
+        -> std::vector<std::pair<index_t, index_t>>;
+};
+
+/**
+ * @brief Builds the index of a .netD/.net file.
+ *
+ * The file is read into memory and its pin section is split into one chunk per worker at line
+ * boundaries; the chunks are scanned in parallel and their net starts are merged.
+ *
+ * @param[in] netDFileName The path to the .netD/.net file.
+ * @param[out] index The index.
+ * @return true if the file could be read and matches its header.
+ */
+auto buildNetDIndex(boost::string_view netDFileName, NetDIndex &index) -> bool;
+
+/**
+ * @brief Writes an index sidecar.
+ *
+ * The sidecar is written to a temporary file that is then renamed, so a concurrent reader sees
+ * either the old or the new index, never a partial one.
+ *
+ * @param[in] idxFileName The path of the sidecar, usually `<netDFileName>.idx`.
+ * @param[in] index The index.
+ * @return true on success.
+ */
+auto writeNetDIndex(boost::string_view idxFileName, const NetDIndex &index) -> bool;
+
+/**
+ * @brief Reads an index sidecar.
+ *
+ * @param[in] idxFileName The path of the sidecar.
+ * @param[out] index The index.
+ * @return true if the sidecar is valid.
+ */
+auto readNetDIndex(boost::string_view idxFileName, NetDIndex &index) -> bool;
+
+/**
+ * @brief Loads `<netDFileName>.idx` if it is up to date, otherwise builds and writes it.
+ *
+ * The sidecar is up to date if the size, the modification time and the sampled content hash of
+ * the file all match it.
+ *
+ * @param[in] netDFileName The path to the .netD/.net file.
+ * @param[out] index The index.
+ * @return true if an index is available.
+ */
+auto loadNetDIndex(boost::string_view netDFileName, NetDIndex &index) -> bool;
+
+/**
+ * @brief Reads the nets [`first`, `last`) of a .netD/.net file using its index.
+ *
+ * Only the bytes of the requested nets are read; the range is split at net boundaries and parsed
+ * in parallel. Module ids are kept, so the result has all `num_modules` modules (those without
+ * pins in the range are isolated) and `last - first` nets, net `i` being net `first + i` of the
+ * file. Reading [0, num_nets) gives the same netlist as `readNetD`.
+ *
+ * @param[in] netDFileName The path to the .netD/.net file.
+ * @param[in] index The index of the file.
+ * @param[in] first The first net.
+ * @param[in] last One past the last net.
+ * @return SimpleNetlist The sub-netlist.
+ */
+auto readNetDNets(boost::string_view netDFileName, const NetDIndex &index, index_t first,
+                  index_t last) -> SimpleNetlist;
+
+/**
+ * @brief Statistics of a .netD/.net file estimated by `probe`.
+ *
+ * The bounds are approximate 95% confidence intervals. When the file is small enough to be read
+ * completely, `exact` is set and the bounds coincide with the estimates.
+ */
+struct NetDProbe {
+    std::uint64_t file_size{};      ///< Size of the file, in bytes
+    std::uint32_t num_pins{};       ///< Number of pins given by the header
+    std::uint32_t num_nets{};       ///< Number of nets given by the header
+    std::uint32_t num_modules{};    ///< Number of modules given by the header
+    std::uint32_t pad_offset{};     ///< Pad offset given by the header
+    bool exact{};                   ///< Whether the whole pin section was read
+    size_t num_windows{};           ///< Number of windows read
+    size_t num_sampled_nets{};      ///< Number of complete nets seen in the windows
+    size_t num_sampled_pins{};      ///< Number of pins of these nets
+    double mean_net_degree{};       ///< Estimated pins per net
+    double mean_net_degree_low{};   ///< Lower bound of `mean_net_degree`
+    double mean_net_degree_high{};  ///< Upper bound of `mean_net_degree`
+    double estimated_pins{};        ///< Pins estimated from the file size and bytes per pin
+    double estimated_pins_low{};    ///< Lower bound of `estimated_pins`
+    double estimated_pins_high{};   ///< Upper bound of `estimated_pins`
+    /// Fraction of the sampled nets with `d` pins (the last entry counts 64 pins or more)
+    std::vector<double> degree_distribution;
+};
+
+/**
+ * @brief Estimates the statistics of a .netD/.net file without parsing it.
+ *
+ * Reads the header counts and `num_windows` windows of `window_size` bytes at random offsets of
+ * the pin section through a `MappedFile` (only the pages of the windows are loaded, so the cost
+ * does not depend on the file size), and estimates the net degrees and the pin density from the
+ * nets that lie completely inside a window. Nets longer than a window are not seen, so very
+ * large nets are under-represented.
+ *
+ * @param[in] netDFileName The path to the .netD/.net file.
+ * @param[in] num_windows The number of windows.
+ * @param[in] window_size The size of a window, in bytes.
+ * @param[in] seed The seed of the window offsets.
+ * @return NetDProbe The estimates.
+ */
+auto probe(boost::string_view netDFileName, size_t num_windows = 32, size_t window_size = 16384,
+           std::uint64_t seed = 1) -> NetDProbe;
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>               // for size_t
+#include <cstdint>               // for uint32_t
+#include <netlistx/csr.hpp>      // for Csr
+#include <netlistx/netlist.hpp>  // for SimpleNetlist, index_t
+#include <string>                // for string
+#include <utility>               // for pair
+#include <vector>                // for vector
+
+/**
+ * @brief Findings of `NetlistBuilder::validate`.
+ *
+ * Out-of-range pins make the input invalid; duplicate pins are removed, and empty nets and
+ * isolated modules are kept but reported.
+ */
+struct ValidationReport {
+    size_t num_pins{};                      ///< Number of pins added
+    size_t num_duplicate_pins{};            ///< Repeated (module, net) pairs, removed
+    size_t num_out_of_range_pins{};         ///< Pins with a module or net id beyond the counts
+    std::vector<index_t> empty_nets;        ///< Nets without pins (net offsets)
+    std::vector<index_t> isolated_modules;  ///< Modules without pins
+
+    /// Whether the input can be built into a netlist
+    auto ok() const -> bool { return this->num_out_of_range_pins == 0; }
+
+    /// A human-readable summary
+    auto to_string() const -> std::string;
+};
+
+/**
+ * @brief Bulk construction of a `SimpleNetlist` from a list of pins.
+ *
+ * Pins are buffered as (module, net offset) pairs and checked all at once: `validate` checks the
+ * ids against the module and net counts given by the file header, sorts the valid pins by (net,
+ * module) with a parallel radix sort (see `radix_sort`) and drops repeated pins. The work is
+ * linear in the number of pins, so a broken input is rejected before any graph is built.
+ *
+ * Example:
+ *
+ *     auto builder = NetlistBuilder{num_modules, num_nets};
+ *     builder.add_pin(module, net);  // ...
+ *     if (!builder.validate().ok()) {
+ *         std::cerr << builder.report().to_string();
+ *     }
+ *     auto hyprgraph = builder.build();
+ */
+class NetlistBuilder {
+    uint32_t _num_modules;
+    uint32_t _num_nets;
+    std::vector<std::pair<index_t, index_t>> _pins;  // (module, net offset)
+    Csr _net_pins;                                   // valid, distinct pins grouped by net
+    ValidationReport _report;
+    bool _validated = false;
+
+  public:
+    /**
+     * @brief Constructs a builder for the given counts.
+     *
+     * @param[in] numModules The number of modules.
+     * @param[in] numNets The number of nets.
+     */
+    NetlistBuilder(uint32_t numModules, uint32_t numNets)
+        : _num_modules{numModules}, _num_nets{numNets} {}
+
+    /// Reserves room for `num_pins` pins.
+    void reserve(size_t num_pins) { this->_pins.reserve(num_pins); }
+
+    /**
+     * @brief Adds the pin connecting `module` to the net with offset `net`.
+     *
+     * @param[in] module The module id, in [0, numModules).
+     * @param[in] net The net offset, in [0, numNets).
+     */
+    void add_pin(index_t module, index_t net) {
+        this->_pins.emplace_back(module, net);
+        this->_validated = false;
+    }
+
+    /// Changes the number of nets, e.g. when a file holds fewer nets than its header announces.
+    void set_number_of_nets(uint32_t numNets) {
+        this->_num_nets = numNets;
+        this->_validated = false;
+    }
+
+    /// The number of modules
+    auto number_of_modules() const -> uint32_t { return this->_num_modules; }
+
+    /// The number of nets
+    auto number_of_nets() const -> uint32_t { return this->_num_nets; }
+
+    /**
+     * @brief Groups, deduplicates and checks the pins.
+     *
+     * @return const ValidationReport& The findings.
+     */
+    auto validate() -> const ValidationReport &;
+
+    /// The findings of the last `validate`
+    auto report() const -> const ValidationReport & { return this->_report; }
+
+    /**
+     * @brief Builds the netlist from the valid, distinct pins (validating first if needed).
+     *
+     * Out-of-range pins are dropped; check `report().ok()` to reject such inputs.
+     *
+     * @return SimpleNetlist The netlist.
+     */
+    auto build() -> SimpleNetlist;
+};
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <algorithm>                 // for equal, min
+#include <cstddef>                   // for size_t
+#include <cstdint>                   // for uint64_t, uint8_t
+#include <netlistx/csr.hpp>          // for Csr, CsrRow, net_pins_csr
+#include <netlistx/fingerprint.hpp>  // for net_fingerprints
+#include <netlistx/netlist.hpp>      // for index_t
+#include <netlistx/parallel.hpp>     // for parallel_for, num_blocks_for
+#include <unordered_map>             // for unordered_map
+#include <utility>                   // for pair
+#include <vector>                    // for vector
+
+/**
+ * @brief The ECO delta between two revisions of a netlist.
+ *
+ * Modules are identified by their id (the `a<n>`/`p<n>` name in the input file), so a module is
+ * added or removed only when the module count changes. Nets have no names; they are identified by
+ * their pin lists. An old net whose pin list re-appears anywhere in the new netlist is unchanged
+ * (possibly moved); an unmatched old net and an unmatched new net at the same position form a
+ * changed pair; all other unmatched nets are removed or added.
+ *
+ * All module ids refer to the new netlist except `removed_modules`; all net ids are net node ids
+ * (not offsets) of the netlist they come from. As in `SimpleNetlist`, net node ids are assumed to
+ * follow the module ids, so the offset of a net is `net - number_of_modules()`.
+ *
+ * Apart from `net_map`, the size of the delta is proportional to the edit (moved nets count as
+ * edited), and it carries the old pin lists it refers to, so an engine with per-net state can be
+ * repaired from the delta and the new revision alone.
+ */
+struct EcoDelta {
+    static constexpr index_t npos = ~index_t{0};
+
+    std::vector<index_t> added_modules;    ///< Modules only in the new netlist
+    std::vector<index_t> removed_modules;  ///< Modules only in the old netlist
+    std::vector<index_t> changed_modules;  ///< Modules whose weight differs
+    std::vector<index_t> added_nets;       ///< New nets without a counterpart
+    std::vector<index_t> removed_nets;     ///< Old nets without a counterpart
+    std::vector<std::pair<index_t, index_t>> changed_nets;  ///< (old net, new net) pairs
+    /// (old net, new net) pairs of unchanged nets whose offset differs
+    std::vector<std::pair<index_t, index_t>> moved_nets;
+    /// The old pin lists of `removed_nets`, then of the old nets of `changed_nets`
+    Csr old_pins;
+    /// Old net offset -> new net node (unchanged or changed), or `npos` if removed
+    std::vector<index_t> net_map;
+    /// New modules incident to an added, removed or changed net, plus added/changed modules
+    std::vector<index_t> touched_modules;
+
+    /**
+     * @brief Whether the two netlists are structurally identical.
+     *
+     * Moved nets do not count as a change.
+     */
+    auto empty() const -> bool {
+        return this->added_modules.empty() && this->removed_modules.empty()
+               && this->changed_modules.empty() && this->added_nets.empty()
+               && this->removed_nets.empty() && this->changed_nets.empty();
+    }
+};
+
+/**
+ * @brief Stable slots for per-net state that is kept across ECOs.
+ *
+ * Net ids are positions, so an ECO may move nets around. An engine that keeps per-net state
+ * indexes it by slot instead of net offset: `apply` gives every moved or changed net the slot of
+ * its old net, frees the slots of removed nets and hands free slots to added nets. Per-slot
+ * arrays only have to grow to `size()`, and nets that the delta does not name keep their slot, so
+ * the cost of `apply` is proportional to the edit.
+ */
+class NetSlots {
+    static constexpr index_t npos = EcoDelta::npos;
+
+    std::vector<index_t> _slot;    // per net offset
+    std::vector<index_t> _offset;  // per slot: the net offset, or npos if free
+    std::vector<index_t> _free;
+
+  public:
+    /// Gives the net at offset `i` slot `i`, for `num_nets` nets
+    void assign(size_t num_nets) {
+        this->_slot.resize(num_nets);
+        for (size_t i = 0; i != num_nets; ++i) {
+            this->_slot[i] = index_t(i);
+        }
+        this->_offset = this->_slot;
+        this->_free.clear();
+    }
+
+    /// The slot of the net at offset `i`
+    auto operator[](size_t i) const -> index_t { return this->_slot[i]; }
+
+    /// The offset of the net in `slot`, or `EcoDelta::npos` if the slot is free
+    auto offset(index_t slot) const -> index_t { return this->_offset[slot]; }
+
+    /// The number of slots, free ones included
+    auto size() const -> size_t { return this->_offset.size(); }
+
+    /**
+     * @brief Moves the slots to the nets of the new revision.
+     *
+     * @param[in] delta The delta from the previous revision.
+     * @param[in] old_base The number of modules of the previous revision.
+     * @param[in] new_base The number of modules of the new revision.
+     * @param[in] num_nets The number of nets of the new revision.
+     */
+    void apply(const EcoDelta &delta, index_t old_base, index_t new_base, size_t num_nets) {
+        // Read all old slots before any is overwritten: moves may form cycles
+        auto moves = std::vector<std::pair<index_t, index_t>>{};  // (new offset, slot)
+        moves.reserve(delta.moved_nets.size() + delta.changed_nets.size());
+        for (const auto &nets : delta.moved_nets) {
+            moves.emplace_back(nets.second - new_base, this->_slot[nets.first - old_base]);
+        }
+        for (const auto &nets : delta.changed_nets) {
+            moves.emplace_back(nets.second - new_base, this->_slot[nets.first - old_base]);
+        }
+        for (const auto net : delta.removed_nets) {
+            const auto slot = this->_slot[net - old_base];
+            this->_offset[slot] = npos;
+            this->_free.push_back(slot);
+        }
+        this->_slot.resize(num_nets, npos);
+        for (const auto &move : moves) {
+            this->_slot[move.first] = move.second;
+            this->_offset[move.second] = move.first;
+        }
+        for (const auto net : delta.added_nets) {
+            auto slot = index_t(this->_offset.size());
+            if (this->_free.empty()) {
+                this->_offset.push_back(npos);
+            } else {
+                slot = this->_free.back();
+                this->_free.pop_back();
+            }
+            this->_slot[net - new_base] = slot;
+            this->_offset[slot] = net - new_base;
+        }
+    }
+};
+
+/**
+ * @brief Computes the structural difference between two netlists.
+ *
+ * Nets are fingerprinted by hashing their sorted pin lists. Nets that stay at the same position
+ * are matched first; the remaining nets are matched by a hash join that is partitioned on the
+ * fingerprint so that each partition is joined by its own thread. Every fingerprint match is
+ * confirmed by comparing the pin lists, so hash collisions cannot produce false matches. The
+ * whole diff runs in time linear in the number of pins (plus sorting the pins of each net).
+ *
+ * @tparam Gnl The type of the hypergraph.
+ * @param[in] old_hgr The old revision.
+ * @param[in] new_hgr The new revision.
+ * @return EcoDelta The delta that transforms `old_hgr` into `new_hgr`.
+ */
+template <typename Gnl> auto diff(const Gnl &old_hgr, const Gnl &new_hgr) -> EcoDelta {
+    constexpr auto npos = EcoDelta::npos;
+    const auto old_pins = net_pins_csr(old_hgr);
+    const auto new_pins = net_pins_csr(new_hgr);
+    const auto old_fp = net_fingerprints(old_pins);
+    const auto new_fp = net_fingerprints(new_pins);
+    const auto num_old = old_pins.size();
+    const auto num_new = new_pins.size();
+
+    auto same = [&](size_t i, size_t j) {
+        const auto r1 = old_pins[i];
+        const auto r2 = new_pins[j];
+        return old_fp[i] == new_fp[j] && r1.size() == r2.size()
+               && std::equal(r1.begin(), r1.end(), r2.begin());
+    };
+
+    auto delta = EcoDelta{};
+    delta.net_map.assign(num_old, npos);
+    auto new_used = std::vector<std::uint8_t>(num_new, 0U);
+
+    // Fast path: nets that did not move
+    parallel_for(0U, std::min(num_old, num_new), [&](size_t lo, size_t hi) {
+        for (auto i = lo; i != hi; ++i) {
+            if (same(i, i)) {
+                delta.net_map[i] = index_t(new_hgr.nets[i]);
+                new_used[i] = 1U;
+            }
+        }
+    });
+
+    // Hash join of the remaining nets, partitioned by fingerprint
+    const auto num_parts = num_blocks_for(num_old + num_new, 4096U) * 4U;
+    auto old_parts = std::vector<std::vector<index_t>>(num_parts);
+    auto new_parts = std::vector<std::vector<index_t>>(num_parts);
+    for (size_t i = 0; i != num_old; ++i) {
+        if (delta.net_map[i] == npos) {
+            old_parts[old_fp[i] % num_parts].push_back(index_t(i));
+        }
+    }
+    for (size_t j = 0; j != num_new; ++j) {
+        if (new_used[j] == 0U) {
+            new_parts[new_fp[j] % num_parts].push_back(index_t(j));
+        }
+    }
+    parallel_for(
+        0U, num_parts,
+        [&](size_t lo, size_t hi) {
+            for (auto p = lo; p != hi; ++p) {
+                auto table = std::unordered_map<std::uint64_t, std::vector<index_t>>{};
+                for (const auto j : new_parts[p]) {
+                    table[new_fp[j]].push_back(j);
+                }
+                for (const auto i : old_parts[p]) {
+                    const auto it = table.find(old_fp[i]);
+                    if (it == table.end()) {
+                        continue;
+                    }
+                    // A matched net leaves its bucket (swap-pop), so identical nets do not
+                    // rescan each other; only fingerprint collisions are visited twice
+                    auto &bucket = it->second;
+                    for (size_t k = 0; k != bucket.size(); ++k) {
+                        const auto j = bucket[k];
+                        if (same(i, j)) {
+                            delta.net_map[i] = index_t(new_hgr.nets[j]);
+                            new_used[j] = 1U;
+                            bucket[k] = bucket.back();
+                            bucket.pop_back();
+                            break;
+                        }
+                    }
+                }
+            }
+        },
+        1U);
+
+    // Unmatched nets at the same position are changed, the rest are removed/added
+    for (size_t i = 0; i != num_old; ++i) {
+        if (delta.net_map[i] != npos) {
+            if (i >= num_new || delta.net_map[i] != index_t(new_hgr.nets[i])) {
+                delta.moved_nets.emplace_back(index_t(old_hgr.nets[i]), delta.net_map[i]);
+            }
+            continue;
+        }
+        if (i < num_new && new_used[i] == 0U) {
+            delta.net_map[i] = index_t(new_hgr.nets[i]);
+            new_used[i] = 1U;
+            delta.changed_nets.emplace_back(index_t(old_hgr.nets[i]), index_t(new_hgr.nets[i]));
+        } else {
+            delta.removed_nets.push_back(index_t(old_hgr.nets[i]));
+        }
+    }
+    for (size_t j = 0; j != num_new; ++j) {
+        if (new_used[j] == 0U) {
+            delta.added_nets.push_back(index_t(new_hgr.nets[j]));
+        }
+    }
+
+    // Modules are matched by id
+    const auto old_modules = old_hgr.number_of_modules();
+    const auto new_modules = new_hgr.number_of_modules();
+    for (auto v = old_modules; v < new_modules; ++v) {
+        delta.added_modules.push_back(index_t(v));
+    }
+    for (auto v = new_modules; v < old_modules; ++v) {
+        delta.removed_modules.push_back(index_t(v));
+    }
+    for (size_t v = 0; v < std::min(old_modules, new_modules); ++v) {
+        if (old_hgr.get_module_weight(index_t(v)) != new_hgr.get_module_weight(index_t(v))) {
+            delta.changed_modules.push_back(index_t(v));
+        }
+    }
+
+    auto touched = std::vector<std::uint8_t>(new_modules, 0U);
+    auto touch_row = [&](const CsrRow &row) {
+        for (const auto v : row) {
+            if (v < new_modules) {
+                touched[v] = 1U;
+            }
+        }
+    };
+    auto keep_old_row = [&](const CsrRow &row) {
+        touch_row(row);
+        delta.old_pins.targets.insert(delta.old_pins.targets.end(), row.begin(), row.end());
+        delta.old_pins.offsets.push_back(delta.old_pins.targets.size());
+    };
+    const auto old_base = index_t(old_modules);
+    const auto new_base = index_t(new_modules);
+    for (const auto net : delta.removed_nets) {
+        keep_old_row(old_pins[net - old_base]);
+    }
+    for (const auto &nets : delta.changed_nets) {
+        keep_old_row(old_pins[nets.first - old_base]);
+        touch_row(new_pins[nets.second - new_base]);
+    }
+    for (const auto net : delta.added_nets) {
+        touch_row(new_pins[net - new_base]);
+    }
+    for (const auto v : delta.added_modules) {
+        touched[v] = 1U;
+    }
+    for (const auto v : delta.changed_modules) {
+        touched[v] = 1U;
+    }
+    for (size_t v = 0; v != new_modules; ++v) {
+        if (touched[v] != 0U) {
+            delta.touched_modules.push_back(index_t(v));
+        }
+    }
+    return delta;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstddef>                        // for size_t
+#include <cstdint>                        // for uint8_t
+#include <netlistx/netlist.hpp>           // for SimpleNetlist
+#include <optional>                       // for optional
+#include <vector>                         // for vector
+
+/**
+ * @brief Encodes a netlist as MessagePack, in the node-link layout of `writeJSON`.
+ *
+ * The top-level map has the same keys as the JSON output (`directed`, `multigraph`, `graph`,
+ * `nodes`, `links`), but `nodes` is a plain array of node ids and `links` is a map of two
+ * parallel integer arrays, `source` and `target`, instead of one map per node or link. With
+ * MessagePack's variable-width integers this is 5-10x smaller than the JSON text.
+ *
+ * @param[in] hyprgraph The netlist.
+ * @return The encoded bytes.
+ */
+auto encodeMsgPack(const SimpleNetlist &hyprgraph) -> std::vector<std::uint8_t>;
+
+/**
+ * @brief Decodes a netlist from MessagePack node-link data.
+ *
+ * Accepts the packed layout of `encodeMsgPack` as well as the per-node and per-link maps of
+ * the JSON layout (e.g. a networkx `node_link_data` dictionary packed with `msgpack`), with the
+ * keys in any order; unknown keys are skipped. `graph` must hold `num_modules` and `num_nets`,
+ * and every link must join a module and a net.
+ *
+ * @param[in] data The encoded bytes.
+ * @param[in] size The number of bytes.
+ * @return The netlist, or nothing if the data is malformed.
+ */
+auto decodeMsgPack(const unsigned char *data, size_t size) -> std::optional<SimpleNetlist>;
+
+/**
+ * @brief Writes a netlist as a MessagePack node-link file (see `encodeMsgPack`).
+ *
+ * @param[in] msgpackFileName The path of the output file.
+ * @param[in] hyprgraph The netlist.
+ */
+void writeMsgPack(boost::string_view msgpackFileName, const SimpleNetlist &hyprgraph);
+
+/**
+ * @brief Reads a netlist from a MessagePack node-link file (see `decodeMsgPack`).
+ *
+ * @param[in] msgpackFileName The path of the input file.
+ * @return The netlist.
+ */
+auto readMsgPack(boost::string_view msgpackFileName) -> SimpleNetlist;
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>  // for min, max
+#include <cstddef>    // for size_t
+#include <exception>  // for exception_ptr, current_exception, rethrow_exception
+#include <thread>     // for thread
+#include <vector>     // for vector
+
+/**
+ * @brief Number of worker threads used by the parallel passes.
+ *
+ * @return size_t The hardware concurrency, or 1 if it cannot be determined.
+ */
+inline auto num_workers() -> size_t {
+    const auto num = std::thread::hardware_concurrency();
+    return num == 0U ? 1U : num;
+}
+
+/**
+ * @brief Runs `fn(block, lo, hi)` over `num_blocks` contiguous blocks of `[first, last)`.
+ *
+ * Block `b` covers `[first + b * len / num_blocks, first + (b + 1) * len / num_blocks)`, so the
+ * partition is deterministic and callers can keep per-block buffers. Every block is executed on
+ * its own thread except the last one, which runs on the calling thread. The first exception
+ * thrown by any block is rethrown after all threads have joined.
+ *
+ * @tparam Fn The type of the block function.
+ * @param[in] first The first index.
+ * @param[in] last One past the last index.
+ * @param[in] num_blocks The number of blocks.
+ * @param[in] fn The function called as `fn(size_t block, size_t lo, size_t hi)`.
+ */
+template <typename Fn>
+void parallel_blocks(size_t first, size_t last, size_t num_blocks, const Fn &fn) {
+    if (last <= first) {
+        return;
+    }
+    const auto len = last - first;
+    num_blocks = std::max<size_t>(1U, std::min(num_blocks, len));
+    auto bound = [&](size_t b) { return first + b * len / num_blocks; };
+    if (num_blocks == 1U) {
+        fn(size_t{0}, first, last);
+        return;
+    }
+
+    auto errors = std::vector<std::exception_ptr>(num_blocks);
+    auto run = [&](size_t b) {
+        try {
+            fn(b, bound(b), bound(b + 1));
+        } catch (...) {
+            errors[b] = std::current_exception();
+        }
+    };
+    auto threads = std::vector<std::thread>{};
+    threads.reserve(num_blocks - 1);
+    for (size_t b = 0; b + 1 < num_blocks; ++b) {
+        threads.emplace_back(run, b);
+    }
+    run(num_blocks - 1);
+    for (auto &t : threads) {
+        t.join();
+    }
+    for (const auto &e : errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+}
+
+/**
+ * @brief Number of blocks `parallel_for` uses for a range of `len` items.
+ *
+ * @param[in] len The number of items.
+ * @param[in] grain The minimum number of items per block.
+ * @return size_t The number of blocks (at least 1).
+ */
+inline auto num_blocks_for(size_t len, size_t grain) -> size_t {
+    const auto by_grain = (len + grain - 1) / std::max<size_t>(grain, 1U);
+    return std::max<size_t>(1U, std::min(num_workers(), by_grain));
+}
+
+/**
+ * @brief Runs `fn(lo, hi)` over contiguous chunks of `[first, last)` in parallel.
+ *
+ * Ranges shorter than `grain` are executed inline on the calling thread, so small netlists pay
+ * no thread start-up cost.
+ *
+ * @tparam Fn The type of the chunk function.
+ * @param[in] first The first index.
+ * @param[in] last One past the last index.
+ * @param[in] fn The function called as `fn(size_t lo, size_t hi)`.
+ * @param[in] grain The minimum number of items per chunk.
+ */
+template <typename Fn>
+void parallel_for(size_t first, size_t last, const Fn &fn, size_t grain = 4096U) {
+    if (last <= first) {
+        return;
+    }
+    parallel_blocks(first, last, num_blocks_for(last - first, grain),
+                    [&](size_t /*block*/, size_t lo, size_t hi) { fn(lo, hi); });
+}
@@ -0,0 +1,409 @@
+#pragma once
+
+#include <atomic>                 // for atomic
+#include <cstddef>                // for size_t
+#include <cstdint>                // for uint8_t, uint64_t
+#include <netlistx/netlist.hpp>   // for index_t
+#include <netlistx/parallel.hpp>  // for parallel_blocks, parallel_for, num_workers
+#include <queue>                  // for priority_queue
+#include <tuple>                  // for tuple
+#include <unordered_map>          // for unordered_map
+#include <unordered_set>          // for unordered_set
+#include <vector>                 // for vector
+
+/**
+ * @brief Pin counts and move gains of a k-way partition under the connectivity metric.
+ *
+ * For every module `v` in block `s`, the cache holds the benefit (total weight of the nets in
+ * which `v` is the only pin of `s`) and, for every block `b`, the penalty (total weight of the
+ * nets of `v` without a pin in `b`). The gain of moving `v` to `b` is the benefit minus the
+ * penalty of `b`. `move` applies a move and updates the cache by deltas: only the nets of the
+ * moved module whose pin count in the source block drops to 0 or 1, or whose pin count in the
+ * target block rises to 1 or 2, touch the entries of their pins.
+ *
+ * Net node ids are assumed to follow the module ids, as in `SimpleNetlist`.
+ */
+class GainCache {
+    size_t _num_parts{};
+    std::vector<index_t> _pin_count;   // nets x blocks
+    std::vector<long long> _benefit;   // per module
+    std::vector<long long> _penalty;   // modules x blocks
+
+  public:
+    /**
+     * @brief Computes the pin counts and the gains from scratch (in parallel).
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @param[in] hyprgraph The input hypergraph.
+     * @param[in] part The block of every module.
+     * @param[in] num_parts The number of blocks.
+     */
+    template <typename Gnl>
+    void init(const Gnl &hyprgraph, const std::vector<std::uint8_t> &part, size_t num_parts) {
+        const auto num_modules = hyprgraph.number_of_modules();
+        const auto base = index_t(num_modules);
+        this->_num_parts = num_parts;
+        this->_pin_count.assign(hyprgraph.number_of_nets() * num_parts, 0U);
+        this->_benefit.assign(num_modules, 0LL);
+        this->_penalty.assign(num_modules * num_parts, 0LL);
+        parallel_for(0U, hyprgraph.number_of_nets(), [&](size_t lo, size_t hi) {
+            for (auto i = lo; i != hi; ++i) {
+                for (const auto &v : hyprgraph.gr[base + index_t(i)]) {
+                    ++this->_pin_count[i * num_parts + part[v]];
+                }
+            }
+        });
+        parallel_for(0U, num_modules, [&](size_t lo, size_t hi) {
+            for (auto v = lo; v != hi; ++v) {
+                for (const auto &net : hyprgraph.gr[index_t(v)]) {
+                    const auto w = static_cast<long long>(hyprgraph.get_net_weight(net));
+                    const auto *count = &this->_pin_count[(size_t(net) - base) * num_parts];
+                    this->_benefit[v] += count[part[v]] == 1U ? w : 0LL;
+                    for (size_t b = 0; b != num_parts; ++b) {
+                        this->_penalty[v * num_parts + b] += count[b] == 0U ? w : 0LL;
+                    }
+                }
+            }
+        });
+    }
+
+    /// The number of blocks
+    auto num_parts() const -> size_t { return this->_num_parts; }
+
+    /// The number of pins of the net with offset `i` in block `b`
+    auto pin_count(size_t i, size_t b) const -> index_t {
+        return this->_pin_count[i * this->_num_parts + b];
+    }
+
+    /// The gain of moving module `v` to block `to` (another block than its own)
+    auto gain(index_t v, size_t to) const -> long long {
+        return this->_benefit[v] - this->_penalty[size_t(v) * this->_num_parts + to];
+    }
+
+    /**
+     * @brief Moves module `v` to block `to` and updates the cache.
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @param[in] hyprgraph The input hypergraph.
+     * @param[in,out] part The block of every module.
+     * @param[in] v The module.
+     * @param[in] to The target block.
+     * @return long long The exact gain of the move at the current partition.
+     */
+    template <typename Gnl>
+    auto move(const Gnl &hyprgraph, std::vector<std::uint8_t> &part, index_t v, std::uint8_t to)
+        -> long long {
+        const auto k = this->_num_parts;
+        const auto base = index_t(hyprgraph.number_of_modules());
+        const auto from = part[v];
+        part[v] = to;
+        auto gain = 0LL;
+        for (const auto &net : hyprgraph.gr[v]) {
+            const auto w = static_cast<long long>(hyprgraph.get_net_weight(net));
+            auto *count = &this->_pin_count[(size_t(net) - base) * k];
+            gain += (count[from] == 1U ? w : 0LL) - (count[to] == 0U ? w : 0LL);
+            const auto from_count = --count[from];
+            const auto to_count = ++count[to];
+            this->_benefit[v] += (to_count == 1U ? w : 0LL) - (from_count == 0U ? w : 0LL);
+            if (from_count > 1U && to_count > 2U) {
+                continue;
+            }
+            for (const auto &u : hyprgraph.gr[net]) {
+                if (from_count == 0U) {
+                    this->_penalty[size_t(u) * k + from] += w;
+                } else if (from_count == 1U && part[u] == from) {
+                    this->_benefit[u] += w;
+                }
+                if (to_count == 1U) {
+                    this->_penalty[size_t(u) * k + to] -= w;
+                } else if (to_count == 2U && part[u] == to && u != v) {
+                    this->_benefit[u] -= w;
+                }
+            }
+        }
+        return gain;
+    }
+};
+
+/**
+ * @brief Options of `parallel_fm`.
+ */
+struct ParallelFmOptions {
+    size_t num_parts = 2;              ///< Number of blocks
+    double balance_tol = 0.1;          ///< Allowed block weight above the average, relative
+    size_t num_threads = 0;            ///< Number of threads (0: `num_workers()`)
+    size_t seeds_per_search = 16;      ///< Boundary modules that start a localized search
+    size_t max_fruitless_moves = 25;   ///< A search stops after this many non-improving moves
+    unsigned int max_rounds = 8;       ///< Maximum number of rounds
+};
+
+/**
+ * @brief Statistics of `parallel_fm`.
+ */
+struct ParallelFmStats {
+    size_t num_rounds{};    ///< Number of rounds
+    size_t num_searches{};  ///< Number of localized searches
+    size_t num_moves{};     ///< Number of moves that were kept
+    std::uint64_t gain{};   ///< Reduction of the connectivity cost
+};
+
+/**
+ * @brief Refines a k-way partition with parallel localized FM searches.
+ *
+ * Every round, the threads take boundary modules from a shared list and run localized FM
+ * searches: a search claims its seeds, and later the neighbors of its moved modules, with an
+ * atomic owner per module, so no module is moved by two searches in a round. The moves of a
+ * search are kept in a thread-local delta of the pin counts; the gain of a module is its entry in
+ * the shared `GainCache`, corrected for the nets touched by the search. A search ends after
+ * `max_fruitless_moves` moves without improvement and keeps its best prefix.
+ *
+ * The searches of a round do not see each other's moves, so their gains may be stale. After all
+ * searches have finished, the kept moves are applied to the global partition one after another;
+ * `GainCache::move` recalculates the exact (attributed) gain of every move and updates the cache.
+ * The round is then rolled back to its best balanced prefix. Rounds are repeated until one does
+ * not improve or after `max_rounds`.
+ *
+ * The partition should be balanced on entry (block weights at most the average times
+ * `1 + balance_tol`); it stays balanced. With several threads the result depends on the
+ * scheduling of the searches; with one thread it is deterministic.
+ *
+ * @tparam Gnl The type of the hypergraph.
+ * @param[in] hyprgraph The input hypergraph.
+ * @param[in,out] part The block of every module.
+ * @param[in] options The refinement options.
+ * @return ParallelFmStats Statistics of the refinement.
+ */
+template <typename Gnl>
+auto parallel_fm(const Gnl &hyprgraph, std::vector<std::uint8_t> &part,
+                 const ParallelFmOptions &options = {}) -> ParallelFmStats {
+    struct Move {
+        index_t v;
+        std::uint8_t from;
+        std::uint8_t to;
+    };
+    using Candidate = std::tuple<long long, index_t, std::uint8_t>;  // (gain, module, target)
+
+    const auto num_modules = hyprgraph.number_of_modules();
+    const auto num_parts = options.num_parts;
+    const auto base = index_t(num_modules);
+    const auto num_threads = options.num_threads == 0U ? num_workers() : options.num_threads;
+    auto stats = ParallelFmStats{};
+
+    auto block_weight = std::vector<std::uint64_t>(num_parts, 0U);
+    for (const auto &v : hyprgraph) {
+        block_weight[part[v]] += hyprgraph.get_module_weight(v);
+    }
+    auto total_weight = std::uint64_t{0};
+    for (const auto w : block_weight) {
+        total_weight += w;
+    }
+    const auto max_weight = static_cast<std::uint64_t>(
+        (1.0 + options.balance_tol) * double(total_weight) / double(num_parts) + 1.0);
+    auto is_balanced = [&]() {
+        for (const auto w : block_weight) {
+            if (w > max_weight) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    auto cache = GainCache{};
+    cache.init(hyprgraph, part, num_parts);
+    auto owner = std::vector<std::atomic<std::uint32_t>>(num_modules);
+
+    // One localized search; returns its best prefix of moves
+    auto search = [&](std::uint32_t id, std::vector<index_t> &claimed) {
+        auto moves = std::vector<Move>{};
+        auto moved = std::unordered_set<index_t>{};
+        auto delta = std::unordered_map<size_t, int>{};  // pin count deltas (net x block)
+        auto touched = std::unordered_set<size_t>{};     // nets with a delta
+        auto weight_delta = std::vector<long long>(num_parts, 0LL);
+        auto gains = std::vector<long long>(num_parts);
+        auto count = [&](size_t i, size_t b) -> long long {
+            const auto it = delta.find(i * num_parts + b);
+            return static_cast<long long>(cache.pin_count(i, b))
+                   + (it == delta.end() ? 0 : it->second);
+        };
+        // The best feasible move of `v` in the view of this search
+        auto best_move = [&](index_t v, Candidate &candidate) {
+            const auto from = size_t(part[v]);
+            for (size_t b = 0; b != num_parts; ++b) {
+                gains[b] = b == from ? 0LL : cache.gain(v, b);
+            }
+            for (const auto &net : hyprgraph.gr[v]) {
+                const auto i = size_t(net) - base;
+                if (touched.count(i) == 0U) {
+                    continue;
+                }
+                const auto w = static_cast<long long>(hyprgraph.get_net_weight(net));
+                const auto global_from = cache.pin_count(i, from) == 1U ? w : 0LL;
+                const auto local_from = count(i, from) == 1 ? w : 0LL;
+                for (size_t b = 0; b != num_parts; ++b) {
+                    const auto global_to = cache.pin_count(i, b) == 0U ? w : 0LL;
+                    const auto local_to = count(i, b) == 0 ? w : 0LL;
+                    gains[b] += (local_from - local_to) - (global_from - global_to);
+                }
+            }
+            const auto vw = static_cast<long long>(hyprgraph.get_module_weight(v));
+            auto found = false;
+            for (size_t b = 0; b != num_parts; ++b) {
+                const auto weight = static_cast<long long>(block_weight[b]) + weight_delta[b];
+                if (b == from || weight + vw > static_cast<long long>(max_weight)) {
+                    continue;
+                }
+                if (!found || gains[b] > std::get<0>(candidate)) {
+                    candidate = Candidate{gains[b], v, std::uint8_t(b)};
+                    found = true;
+                }
+            }
+            return found;
+        };
+
+        auto queue = std::priority_queue<Candidate>{};
+        auto candidate = Candidate{};
+        for (const auto v : claimed) {
+            if (best_move(v, candidate)) {
+                queue.push(candidate);
+            }
+        }
+        auto total = 0LL;
+        auto best_total = 0LL;
+        auto best_size = size_t{0};
+        auto fruitless = size_t{0};
+        while (!queue.empty() && fruitless < options.max_fruitless_moves) {
+            const auto top = queue.top();
+            queue.pop();
+            const auto v = std::get<1>(top);
+            if (moved.count(v) != 0U || !best_move(v, candidate)) {
+                continue;
+            }
+            if (candidate != top) {
+                queue.push(candidate);  // stale, retry with the current gain
+                continue;
+            }
+            const auto from = part[v];
+            const auto to = std::get<2>(candidate);
+            for (const auto &net : hyprgraph.gr[v]) {
+                const auto i = size_t(net) - base;
+                --delta[i * num_parts + from];
+                ++delta[i * num_parts + to];
+                touched.insert(i);
+            }
+            const auto vw = static_cast<long long>(hyprgraph.get_module_weight(v));
+            weight_delta[from] -= vw;
+            weight_delta[to] += vw;
+            moved.insert(v);
+            moves.push_back(Move{v, from, to});
+            total += std::get<0>(candidate);
+            if (total > best_total) {
+                best_total = total;
+                best_size = moves.size();
+                fruitless = 0;
+            } else {
+                ++fruitless;
+            }
+            for (const auto &net : hyprgraph.gr[v]) {
+                for (const auto &u : hyprgraph.gr[net]) {
+                    auto expected = std::uint32_t{0};
+                    if (owner[u].compare_exchange_strong(expected, id)) {
+                        claimed.push_back(index_t(u));
+                        if (best_move(index_t(u), candidate)) {
+                            queue.push(candidate);
+                        }
+                    }
+                }
+            }
+        }
+        moves.resize(best_size);
+        // Kept modules stay claimed for the rest of the round; the others are released
+        auto kept = std::unordered_set<index_t>{};
+        for (const auto &m : moves) {
+            kept.insert(m.v);
+        }
+        for (const auto v : claimed) {
+            if (kept.count(v) == 0U) {
+                owner[v].store(0U);
+            }
+        }
+        return moves;
+    };
+
+    for (auto round = 0U; round != options.max_rounds; ++round) {
+        ++stats.num_rounds;
+        auto seeds = std::vector<index_t>{};
+        for (const auto &v : hyprgraph) {
+            for (const auto &net : hyprgraph.gr[v]) {
+                if (cache.pin_count(size_t(net) - base, part[v]) != hyprgraph.gr.degree(net)) {
+                    seeds.push_back(index_t(v));
+                    break;
+                }
+            }
+        }
+        for (auto &o : owner) {
+            o.store(0U, std::memory_order_relaxed);
+        }
+
+        auto next_seed = std::atomic<size_t>{0};
+        auto next_id = std::atomic<std::uint32_t>{1};
+        auto thread_moves = std::vector<std::vector<Move>>(num_threads);
+        auto thread_searches = std::vector<size_t>(num_threads, 0U);
+        parallel_blocks(0U, num_threads, num_threads, [&](size_t t, size_t, size_t) {
+            auto claimed = std::vector<index_t>{};
+            while (true) {
+                const auto id = next_id.fetch_add(1U);
+                claimed.clear();
+                while (claimed.size() < options.seeds_per_search) {
+                    const auto i = next_seed.fetch_add(1U);
+                    if (i >= seeds.size()) {
+                        break;
+                    }
+                    auto expected = std::uint32_t{0};
+                    if (owner[seeds[i]].compare_exchange_strong(expected, id)) {
+                        claimed.push_back(seeds[i]);
+                    }
+                }
+                if (claimed.empty()) {
+                    break;
+                }
+                ++thread_searches[t];
+                const auto moves = search(id, claimed);
+                thread_moves[t].insert(thread_moves[t].end(), moves.begin(), moves.end());
+            }
+        });
+
+        // Apply all moves with their attributed gains and roll back to the best prefix
+        auto applied = std::vector<Move>{};
+        auto total = 0LL;
+        auto best_total = 0LL;
+        auto best_size = size_t{0};
+        for (size_t t = 0; t != num_threads; ++t) {
+            stats.num_searches += thread_searches[t];
+            for (const auto &m : thread_moves[t]) {
+                total += cache.move(hyprgraph, part, m.v, m.to);
+                const auto vw = hyprgraph.get_module_weight(m.v);
+                block_weight[m.from] -= vw;
+                block_weight[m.to] += vw;
+                applied.push_back(m);
+                if (total > best_total && is_balanced()) {
+                    best_total = total;
+                    best_size = applied.size();
+                }
+            }
+        }
+        while (applied.size() > best_size) {
+            const auto m = applied.back();
+            applied.pop_back();
+            cache.move(hyprgraph, part, m.v, m.from);
+            const auto vw = hyprgraph.get_module_weight(m.v);
+            block_weight[m.to] -= vw;
+            block_weight[m.from] += vw;
+        }
+        stats.num_moves += best_size;
+        stats.gain += std::uint64_t(best_total);
+        if (best_total == 0) {
+            break;
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>               // for size_t
+#include <cstdint>               // for uint8_t, uint64_t
+#include <netlistx/netlist.hpp>  // for index_t
+#include <vector>                // for vector
+
+/**
+ * @brief Computes the weight of every block of a partition.
+ *
+ * @tparam Gnl The type of the hypergraph.
+ * @param[in] hyprgraph The input hypergraph.
+ * @param[in] part The block of every module.
+ * @param[in] num_parts The number of blocks.
+ * @return std::vector<uint64_t> The total module weight of every block.
+ */
+template <typename Gnl>
+auto block_weights(const Gnl &hyprgraph, const std::vector<std::uint8_t> &part, size_t num_parts)
+    -> std::vector<std::uint64_t> {
+    auto weights = std::vector<std::uint64_t>(num_parts, 0U);
+    for (const auto &v : hyprgraph) {
+        weights[part[v]] += hyprgraph.get_module_weight(v);
+    }
+    return weights;
+}
+
+/**
+ * @brief Computes the connectivity cost (sum over nets of weight * (blocks spanned - 1)).
+ *
+ * For a bipartition this is the weighted cut.
+ *
+ * @tparam Gnl The type of the hypergraph.
+ * @param[in] hyprgraph The input hypergraph.
+ * @param[in] part The block of every module.
+ * @param[in] num_parts The number of blocks.
+ * @return uint64_t The connectivity cost.
+ */
+template <typename Gnl>
+auto connectivity_cost(const Gnl &hyprgraph, const std::vector<std::uint8_t> &part,
+                       size_t num_parts) -> std::uint64_t {
+    auto cost = std::uint64_t{0};
+    auto seen = std::vector<std::uint8_t>(num_parts, 0U);
+    for (const auto &net : hyprgraph.nets) {
+        auto lambda = 0U;
+        for (const auto &v : hyprgraph.gr[net]) {
+            if (seen[part[v]] == 0U) {
+                seen[part[v]] = 1U;
+                ++lambda;
+            }
+        }
+        for (const auto &v : hyprgraph.gr[net]) {
+            seen[part[v]] = 0U;
+        }
+        if (lambda > 1U) {
+            cost += std::uint64_t(hyprgraph.get_net_weight(net)) * (lambda - 1U);
+        }
+    }
+    return cost;
+}
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <algorithm>                  // for fill
+#include <cstddef>                    // for size_t
+#include <cstdint>                    // for uint8_t, uint64_t
+#include <netlistx/netlist.hpp>       // for index_t
+#include <netlistx/netlist_diff.hpp>  // for EcoDelta
+#include <netlistx/partition.hpp>     // for block_weights
+#include <queue>                      // for priority_queue
+#include <tuple>                      // for tuple
+#include <unordered_map>              // for unordered_map
+#include <unordered_set>              // for unordered_set
+#include <utility>                    // for pair
+#include <vector>                     // for vector
+
+/**
+ * @brief Options of `repair_partition`.
+ */
+struct RepairOptions {
+    size_t num_parts = 2;             ///< Number of blocks
+    double balance_tol = 0.1;         ///< Allowed block weight above the average, relative
+    unsigned int num_hops = 2;        ///< Radius (in module-net-module hops) of the region
+    size_t max_expand_degree = 64;    ///< Larger nets do not extend the region
+    long long stability_penalty = 1;  ///< Gain penalty for moving an untouched module
+    unsigned int max_passes = 4;      ///< Maximum number of FM passes
+};
+
+/**
+ * @brief Statistics of `repair_partition`.
+ */
+struct RepairStats {
+    size_t region_size{};  ///< Number of modules that were allowed to move
+    size_t num_moves{};    ///< Number of moves that were kept
+    long long gain{};      ///< Reduction of the connectivity cost by the kept moves
+};
+
+/**
+ * @brief Repairs a k-way partition after an ECO instead of recomputing it.
+ *
+ * Modules added by the ECO are assigned greedily to the feasible block holding most of their
+ * pins. Then a localized FM refinement moves modules of the region, which is the `num_hops`
+ * neighborhood of `EcoDelta::touched_modules`, to reduce the connectivity cost (see
+ * `connectivity_cost`). Moving a module that was not touched by the ECO costs an extra
+ * `stability_penalty`, so the partition of the unchanged design stays stable. Each pass applies
+ * the best feasible move of the region repeatedly and rolls back to the best prefix.
+ *
+ * Apart from one pass over the module weights to get the block weights, the work is bounded by
+ * the pins of the region: the state of the modules and nets of the region is kept in hash maps
+ * keyed by node id. Up to 256 blocks are supported.
+ *
+ * @tparam Gnl The type of the hypergraph.
+ * @param[in] hyprgraph The new revision of the hypergraph.
+ * @param[in] delta The delta from the previous revision, e.g. from `diff`.
+ * @param[in,out] part The block of every module of the previous revision; on return, the block of
+ *                     every module of the new revision.
+ * @param[in] options The repair options.
+ * @return RepairStats Statistics of the repair.
+ */
+template <typename Gnl>
+auto repair_partition(const Gnl &hyprgraph, const EcoDelta &delta, std::vector<std::uint8_t> &part,
+                      const RepairOptions &options = {}) -> RepairStats {
+    using Move = std::tuple<long long, index_t, std::uint8_t, unsigned int>;
+    const auto num_parts = options.num_parts;
+    const auto num_modules = hyprgraph.number_of_modules();
+    // Every value of a block id is a valid block, so the new modules are tracked aside
+    auto unassigned = std::unordered_set<index_t>(delta.added_modules.begin(),
+                                                  delta.added_modules.end());
+    part.resize(num_modules, 0U);
+
+    // Block weights and the balance bound
+    auto weights = std::vector<std::uint64_t>(num_parts, 0U);
+    auto total_weight = std::uint64_t{0};
+    for (const auto &v : hyprgraph) {
+        weights[part[v]] += hyprgraph.get_module_weight(v);
+        total_weight += hyprgraph.get_module_weight(v);
+    }
+    for (const auto v : unassigned) {
+        weights[part[v]] -= hyprgraph.get_module_weight(v);
+    }
+    const auto max_weight = static_cast<std::uint64_t>(
+        (1.0 + options.balance_tol) * double(total_weight) / double(num_parts) + 1.0);
+
+    // Greedy assignment of the new modules
+    auto conn = std::vector<std::uint64_t>(num_parts);
+    for (const auto v : delta.added_modules) {
+        std::fill(conn.begin(), conn.end(), 0U);
+        for (const auto &net : hyprgraph.gr[v]) {
+            for (const auto &u : hyprgraph.gr[net]) {
+                if (unassigned.count(index_t(u)) == 0) {
+                    ++conn[part[u]];
+                }
+            }
+        }
+        const auto vw = hyprgraph.get_module_weight(v);
+        auto best = std::uint8_t{0};
+        auto found = false;
+        for (size_t b = 0; b != num_parts; ++b) {
+            if (weights[b] + vw > max_weight) {
+                continue;
+            }
+            if (!found || conn[b] > conn[best]
+                || (conn[b] == conn[best] && weights[b] < weights[best])) {
+                best = std::uint8_t(b);
+                found = true;
+            }
+        }
+        if (!found) {
+            for (size_t b = 1; b != num_parts; ++b) {
+                if (weights[b] < weights[best]) {
+                    best = std::uint8_t(b);
+                }
+            }
+        }
+        weights[best] += vw;
+        part[v] = best;
+        unassigned.erase(v);
+    }
+
+    // The region: k-hop neighborhood of the touched modules
+    auto stats = RepairStats{};
+    auto slot = std::unordered_map<index_t, index_t>{};  // position of a module in `region`
+    auto region = std::vector<index_t>{};
+    for (const auto v : delta.touched_modules) {
+        if (slot.emplace(v, index_t(region.size())).second) {
+            region.push_back(v);
+        }
+    }
+    const auto num_touched = region.size();  // the touched modules come first
+    auto is_touched = [&](index_t v) { return size_t(slot.find(v)->second) < num_touched; };
+    for (size_t hop = 0, first = 0; hop != options.num_hops; ++hop) {
+        const auto last = region.size();
+        for (auto i = first; i != last; ++i) {
+            for (const auto &net : hyprgraph.gr[region[i]]) {
+                if (hyprgraph.gr.degree(net) > options.max_expand_degree) {
+                    continue;
+                }
+                for (const auto &u : hyprgraph.gr[net]) {
+                    if (slot.emplace(index_t(u), index_t(region.size())).second) {
+                        region.push_back(index_t(u));
+                    }
+                }
+            }
+        }
+        first = last;
+    }
+    stats.region_size = region.size();
+    if (region.empty() || num_parts < 2) {
+        return stats;
+    }
+
+    // Pin counts per block of the nets incident to the region
+    auto local = std::unordered_map<index_t, index_t>{};
+    auto counts = std::vector<index_t>{};
+    for (const auto v : region) {
+        for (const auto &net : hyprgraph.gr[v]) {
+            if (local.emplace(index_t(net), index_t(local.size())).second) {
+                counts.resize(counts.size() + num_parts, 0U);
+                auto *cnt = &counts[counts.size() - num_parts];
+                for (const auto &u : hyprgraph.gr[net]) {
+                    ++cnt[part[u]];
+                }
+            }
+        }
+    }
+    auto count_of = [&](index_t net) { return &counts[size_t(local[net]) * num_parts]; };
+
+    // Best feasible move of a module and its gain
+    auto loss = std::vector<long long>(num_parts);
+    auto best_move = [&](index_t v, std::uint8_t &target) -> long long {
+        const auto from = part[v];
+        auto gain_from = 0LL;
+        std::fill(loss.begin(), loss.end(), 0LL);
+        for (const auto &net : hyprgraph.gr[v]) {
+            const auto *cnt = count_of(index_t(net));
+            const auto w = static_cast<long long>(hyprgraph.get_net_weight(net));
+            if (cnt[from] == 1U) {
+                gain_from += w;
+            }
+            for (size_t b = 0; b != num_parts; ++b) {
+                if (cnt[b] == 0U) {
+                    loss[b] += w;
+                }
+            }
+        }
+        const auto vw = hyprgraph.get_module_weight(v);
+        auto best = 0LL;
+        auto found = false;
+        for (size_t b = 0; b != num_parts; ++b) {
+            if (b == from || weights[b] + vw > max_weight) {
+                continue;
+            }
+            const auto gain = gain_from - loss[b];
+            if (!found || gain > best) {
+                best = gain;
+                target = std::uint8_t(b);
+                found = true;
+            }
+        }
+        if (!found) {
+            target = from;
+            return 0LL;
+        }
+        return best - (is_touched(v) ? 0LL : options.stability_penalty);
+    };
+    auto apply = [&](index_t v, std::uint8_t to) {
+        const auto from = part[v];
+        for (const auto &net : hyprgraph.gr[v]) {
+            auto *cnt = count_of(index_t(net));
+            --cnt[from];
+            ++cnt[to];
+        }
+        weights[from] -= hyprgraph.get_module_weight(v);
+        weights[to] += hyprgraph.get_module_weight(v);
+        part[v] = to;
+    };
+
+    // Localized FM passes with rollback to the best prefix
+    // Indexed by the position in `region`
+    auto stamp = std::vector<unsigned int>(region.size(), 0U);
+    auto locked = std::vector<std::uint8_t>(region.size(), 0U);
+    for (unsigned int pass = 0; pass != options.max_passes; ++pass) {
+        auto heap = std::priority_queue<Move>{};
+        for (size_t i = 0; i != region.size(); ++i) {
+            const auto v = region[i];
+            locked[i] = 0U;
+            auto to = std::uint8_t{0};
+            const auto gain = best_move(v, to);
+            if (to != part[v]) {
+                heap.emplace(gain, v, to, ++stamp[i]);
+            }
+        }
+        auto moves = std::vector<std::pair<index_t, std::uint8_t>>{};  // (module, from)
+        auto total = 0LL;
+        auto best_total = 0LL;
+        auto structural = 0LL;
+        auto best_structural = 0LL;
+        size_t best_len = 0;
+        while (!heap.empty()) {
+            const auto [gain, v, to, st] = heap.top();
+            heap.pop();
+            const auto i = size_t(slot.find(v)->second);
+            if (locked[i] != 0U || st != stamp[i]) {
+                continue;
+            }
+            auto target = std::uint8_t{0};
+            const auto actual = best_move(v, target);
+            if (target == part[v]) {
+                continue;
+            }
+            if (actual != gain || target != to) {
+                heap.emplace(actual, v, target, ++stamp[i]);  // stale entry, re-evaluate
+                continue;
+            }
+            moves.emplace_back(v, part[v]);
+            apply(v, target);
+            locked[i] = 1U;
+            total += actual;
+            structural += actual + (is_touched(v) ? 0LL : options.stability_penalty);
+            if (total > best_total) {
+                best_total = total;
+                best_structural = structural;
+                best_len = moves.size();
+            }
+            for (const auto &net : hyprgraph.gr[v]) {
+                if (hyprgraph.gr.degree(net) > options.max_expand_degree) {
+                    continue;
+                }
+                for (const auto &u : hyprgraph.gr[net]) {
+                    const auto it = slot.find(index_t(u));
+                    if (it == slot.end() || locked[it->second] != 0U) {
+                        continue;
+                    }
+                    auto to2 = std::uint8_t{0};
+                    const auto gain2 = best_move(index_t(u), to2);
+                    if (to2 != part[u]) {
+                        heap.emplace(gain2, index_t(u), to2, ++stamp[it->second]);
+                    }
+                }
+            }
+        }
+        while (moves.size() > best_len) {
+            apply(moves.back().first, moves.back().second);
+            moves.pop_back();
+        }
+        stats.num_moves += best_len;
+        stats.gain += best_structural;
+        if (best_len == 0) {
+            break;
+        }
+    }
+    return stats;
+}
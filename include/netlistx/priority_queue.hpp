@@ -0,0 +1,405 @@
+#pragma once
+
+#include <array>                 // for array
+#include <cassert>               // for assert
+#include <cstddef>               // for size_t
+#include <cstdint>               // for uint8_t, uint64_t
+#include <functional>            // for less
+#include <limits>                // for numeric_limits
+#include <netlistx/netlist.hpp>  // for index_t
+#include <utility>               // for swap
+#include <vector>                // for vector
+
+/// The id of an item that is not in a queue
+constexpr index_t queue_npos = std::numeric_limits<index_t>::max();
+
+/**
+ * @brief An addressable max-priority queue of items with integer keys in a bounded range.
+ *
+ * Items are ids in [0, num_items), e.g. modules. Every key in [-max_key, max_key] has a bucket,
+ * and every bucket is a doubly linked list threaded through dense per-item arrays, so `push`,
+ * `update`, `remove` and `contains` are O(1). `top` scans down from the highest non-empty bucket;
+ * the scan is amortized over the updates that raised the bound. In FM the gain of a module is
+ * bounded by its degree times the maximum net weight, so `max_key` is `max_degree` times the
+ * maximum net weight.
+ *
+ * For a min-queue, negate the keys.
+ */
+class BucketQueue {
+    long long _max_key;
+    std::vector<index_t> _head;  // first item of every bucket
+    std::vector<index_t> _next;  // per item
+    std::vector<index_t> _prev;  // per item; queue_npos for the head of a bucket
+    std::vector<long long> _key;
+    std::vector<std::uint8_t> _in;
+    size_t _top{};  // no bucket above it is non-empty
+    size_t _size{};
+
+    auto _bucket(long long key) const -> size_t {
+        assert(-this->_max_key <= key && key <= this->_max_key);
+        return static_cast<size_t>(key + this->_max_key);
+    }
+
+    void _link(index_t v) {
+        const auto b = this->_bucket(this->_key[v]);
+        this->_prev[v] = queue_npos;
+        this->_next[v] = this->_head[b];
+        if (this->_head[b] != queue_npos) {
+            this->_prev[this->_head[b]] = v;
+        }
+        this->_head[b] = v;
+        this->_top = b > this->_top ? b : this->_top;
+    }
+
+    void _unlink(index_t v) {
+        if (this->_prev[v] == queue_npos) {
+            this->_head[this->_bucket(this->_key[v])] = this->_next[v];
+        } else {
+            this->_next[this->_prev[v]] = this->_next[v];
+        }
+        if (this->_next[v] != queue_npos) {
+            this->_prev[this->_next[v]] = this->_prev[v];
+        }
+    }
+
+  public:
+    /**
+     * @brief Constructs an empty queue.
+     *
+     * @param[in] num_items The number of item ids.
+     * @param[in] max_key The largest absolute value of a key.
+     */
+    BucketQueue(size_t num_items, long long max_key)
+        : _max_key{max_key},
+          _head(static_cast<size_t>(2 * max_key + 1), queue_npos),
+          _next(num_items, queue_npos),
+          _prev(num_items, queue_npos),
+          _key(num_items, 0),
+          _in(num_items, 0U) {}
+
+    /// Whether the queue is empty
+    auto empty() const -> bool { return this->_size == 0U; }
+
+    /// The number of items in the queue
+    auto size() const -> size_t { return this->_size; }
+
+    /// Whether item `v` is in the queue
+    auto contains(index_t v) const -> bool { return this->_in[v] != 0U; }
+
+    /// The key of item `v` (which is in the queue)
+    auto key(index_t v) const -> long long { return this->_key[v]; }
+
+    /// Inserts item `v` (not in the queue) with key `key`.
+    void push(index_t v, long long key) {
+        assert(!this->contains(v));
+        this->_key[v] = key;
+        this->_in[v] = 1U;
+        ++this->_size;
+        this->_link(v);
+    }
+
+    /// Changes the key of item `v` (which is in the queue).
+    void update(index_t v, long long key) {
+        assert(this->contains(v));
+        this->_unlink(v);
+        this->_key[v] = key;
+        this->_link(v);
+    }
+
+    /// Removes item `v` (which is in the queue).
+    void remove(index_t v) {
+        assert(this->contains(v));
+        this->_unlink(v);
+        this->_in[v] = 0U;
+        --this->_size;
+    }
+
+    /// An item with the largest key (the queue must not be empty)
+    auto top() -> index_t {
+        assert(!this->empty());
+        while (this->_head[this->_top] == queue_npos) {
+            --this->_top;
+        }
+        return this->_head[this->_top];
+    }
+
+    /// Removes and returns an item with the largest key.
+    auto pop() -> index_t {
+        const auto v = this->top();
+        this->remove(v);
+        return v;
+    }
+
+    /// Removes all items in O(size()).
+    void clear() {
+        while (!this->empty()) {
+            this->pop();
+        }
+        this->_top = 0;
+    }
+};
+
+/**
+ * @brief An addressable d-ary heap (a max-heap with the default `Compare`).
+ *
+ * Items are ids in [0, num_items). The heap is one array of ids, and the position and key of
+ * every item are dense per-item arrays, so `contains` is O(1) and `push`, `update`, `remove` and
+ * `pop` are O(log_D n). With D = 4 the children of a node share a cache line and the heap is
+ * half as deep as a binary heap.
+ *
+ * @tparam Key The type of the keys.
+ * @tparam D The arity.
+ * @tparam Compare The order; `top` is an item whose key is not less than any other key.
+ */
+template <typename Key, size_t D = 4, typename Compare = std::less<Key>> class DaryHeap {
+    static_assert(D >= 2, "the arity must be at least 2");
+
+    std::vector<index_t> _heap;
+    std::vector<index_t> _pos;  // per item; queue_npos if not in the heap
+    std::vector<Key> _key;
+    Compare _less;
+
+    void _place(size_t i, index_t v) {
+        this->_heap[i] = v;
+        this->_pos[v] = index_t(i);
+    }
+
+    void _sift_up(size_t i) {
+        const auto v = this->_heap[i];
+        while (i != 0) {
+            const auto parent = (i - 1) / D;
+            if (!this->_less(this->_key[this->_heap[parent]], this->_key[v])) {
+                break;
+            }
+            this->_place(i, this->_heap[parent]);
+            i = parent;
+        }
+        this->_place(i, v);
+    }
+
+    void _sift_down(size_t i) {
+        const auto v = this->_heap[i];
+        const auto n = this->_heap.size();
+        while (true) {
+            const auto first = i * D + 1;
+            if (first >= n) {
+                break;
+            }
+            const auto last = first + D < n ? first + D : n;
+            auto best = first;
+            for (auto c = first + 1; c < last; ++c) {
+                if (this->_less(this->_key[this->_heap[best]], this->_key[this->_heap[c]])) {
+                    best = c;
+                }
+            }
+            if (!this->_less(this->_key[v], this->_key[this->_heap[best]])) {
+                break;
+            }
+            this->_place(i, this->_heap[best]);
+            i = best;
+        }
+        this->_place(i, v);
+    }
+
+  public:
+    /**
+     * @brief Constructs an empty heap.
+     *
+     * @param[in] num_items The number of item ids.
+     * @param[in] less The order of the keys.
+     */
+    explicit DaryHeap(size_t num_items, Compare less = Compare{})
+        : _pos(num_items, queue_npos), _key(num_items), _less{less} {}
+
+    /// Whether the heap is empty
+    auto empty() const -> bool { return this->_heap.empty(); }
+
+    /// The number of items in the heap
+    auto size() const -> size_t { return this->_heap.size(); }
+
+    /// Whether item `v` is in the heap
+    auto contains(index_t v) const -> bool { return this->_pos[v] != queue_npos; }
+
+    /// The key of item `v` (which is in the heap)
+    auto key(index_t v) const -> const Key & { return this->_key[v]; }
+
+    /// Inserts item `v` (not in the heap) with key `key`.
+    void push(index_t v, Key key) {
+        assert(!this->contains(v));
+        this->_key[v] = std::move(key);
+        this->_heap.push_back(v);
+        this->_sift_up(this->_heap.size() - 1);
+    }
+
+    /// Changes the key of item `v` (which is in the heap).
+    void update(index_t v, Key key) {
+        assert(this->contains(v));
+        const auto up = this->_less(this->_key[v], key);
+        this->_key[v] = std::move(key);
+        if (up) {
+            this->_sift_up(this->_pos[v]);
+        } else {
+            this->_sift_down(this->_pos[v]);
+        }
+    }
+
+    /// Removes item `v` (which is in the heap).
+    void remove(index_t v) {
+        assert(this->contains(v));
+        const auto i = size_t(this->_pos[v]);
+        const auto last = this->_heap.back();
+        this->_heap.pop_back();
+        this->_pos[v] = queue_npos;
+        if (last == v) {
+            return;
+        }
+        this->_place(i, last);
+        if (i != 0 && this->_less(this->_key[this->_heap[(i - 1) / D]], this->_key[last])) {
+            this->_sift_up(i);
+        } else {
+            this->_sift_down(i);
+        }
+    }
+
+    /// The item with the largest key (the heap must not be empty)
+    auto top() const -> index_t { return this->_heap.front(); }
+
+    /// Removes and returns the item with the largest key.
+    auto pop() -> index_t {
+        const auto v = this->top();
+        this->remove(v);
+        return v;
+    }
+
+    /// Removes all items in O(size()).
+    void clear() {
+        for (const auto v : this->_heap) {
+            this->_pos[v] = queue_npos;
+        }
+        this->_heap.clear();
+    }
+};
+
+/**
+ * @brief An addressable monotone min-priority queue with unsigned integer keys (radix heap).
+ *
+ * A key may not be smaller than the last key returned by `pop` (e.g. Dijkstra distances or
+ * growing costs). Bucket `b > 0` holds the keys that first differ from the last popped key in bit
+ * `b - 1`, bucket 0 those equal to it. `pop` empties the lowest non-empty bucket into lower
+ * buckets, and every key can only move down, so `pop` is amortized O(log C) for keys below C.
+ * Buckets are arrays, and the bucket and index of every item are dense per-item arrays, so
+ * `contains`, `update` (to a key not below the last popped key) and `remove` are O(1).
+ */
+class RadixHeap {
+    static constexpr size_t num_buckets = 65;
+
+    std::array<std::vector<index_t>, num_buckets> _buckets;
+    std::vector<std::uint8_t> _bucket;  // per item
+    std::vector<index_t> _index;        // per item; queue_npos if not in the heap
+    std::vector<std::uint64_t> _key;
+    std::uint64_t _last{};
+    size_t _size{};
+
+    auto _bucket_of(std::uint64_t key) const -> size_t {
+        assert(key >= this->_last);
+        auto diff = key ^ this->_last;
+        auto b = size_t{0};
+        while (diff != 0U) {
+            ++b;
+            diff >>= 1U;
+        }
+        return b;
+    }
+
+    void _insert(index_t v) {
+        const auto b = this->_bucket_of(this->_key[v]);
+        this->_bucket[v] = std::uint8_t(b);
+        this->_index[v] = index_t(this->_buckets[b].size());
+        this->_buckets[b].push_back(v);
+    }
+
+    void _erase(index_t v) {
+        auto &bucket = this->_buckets[this->_bucket[v]];
+        const auto i = this->_index[v];
+        const auto last = bucket.back();
+        bucket[i] = last;
+        this->_index[last] = i;
+        bucket.pop_back();
+    }
+
+  public:
+    /**
+     * @brief Constructs an empty heap.
+     *
+     * @param[in] num_items The number of item ids.
+     */
+    explicit RadixHeap(size_t num_items)
+        : _bucket(num_items, 0U), _index(num_items, queue_npos), _key(num_items, 0U) {}
+
+    /// Whether the heap is empty
+    auto empty() const -> bool { return this->_size == 0U; }
+
+    /// The number of items in the heap
+    auto size() const -> size_t { return this->_size; }
+
+    /// Whether item `v` is in the heap
+    auto contains(index_t v) const -> bool { return this->_index[v] != queue_npos; }
+
+    /// The key of item `v` (which is in the heap)
+    auto key(index_t v) const -> std::uint64_t { return this->_key[v]; }
+
+    /// The last key returned by `pop` (0 before the first pop); keys may not be smaller
+    auto last_key() const -> std::uint64_t { return this->_last; }
+
+    /// Inserts item `v` (not in the heap) with key `key` (at least `last_key()`).
+    void push(index_t v, std::uint64_t key) {
+        assert(!this->contains(v));
+        this->_key[v] = key;
+        this->_insert(v);
+        ++this->_size;
+    }
+
+    /// Changes the key of item `v` (which is in the heap) to `key` (at least `last_key()`).
+    void update(index_t v, std::uint64_t key) {
+        assert(this->contains(v));
+        this->_erase(v);
+        this->_key[v] = key;
+        this->_insert(v);
+    }
+
+    /// Removes item `v` (which is in the heap).
+    void remove(index_t v) {
+        assert(this->contains(v));
+        this->_erase(v);
+        this->_index[v] = queue_npos;
+        --this->_size;
+    }
+
+    /// Removes and returns an item with the smallest key (the heap must not be empty).
+    auto pop() -> index_t {
+        assert(!this->empty());
+        if (this->_buckets[0].empty()) {
+            auto b = size_t{1};
+            while (this->_buckets[b].empty()) {
+                ++b;
+            }
+            auto items = std::vector<index_t>{};
+            std::swap(items, this->_buckets[b]);
+            auto min_key = std::numeric_limits<std::uint64_t>::max();
+            for (const auto v : items) {
+                min_key = this->_key[v] < min_key ? this->_key[v] : min_key;
+            }
+            this->_last = min_key;
+            for (const auto v : items) {
+                this->_insert(v);
+            }
+            items.clear();
+            std::swap(items, this->_buckets[b]);  // keep the capacity
+        }
+        const auto v = this->_buckets[0].back();
+        this->_buckets[0].pop_back();
+        this->_index[v] = queue_npos;
+        --this->_size;
+        return v;
+    }
+};
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>              // for sort
+#include <atomic>                 // for atomic
+#include <cstddef>                // for size_t, ptrdiff_t
+#include <cstdint>                // for uint8_t, uint64_t
+#include <netlistx/csr.hpp>       // for Csr, CsrRow
+#include <netlistx/netlist.hpp>   // for index_t, Snapshot
+#include <netlistx/parallel.hpp>  // for parallel_blocks, parallel_for, num_blocks_for
+#include <utility>                // for pair
+#include <vector>                 // for vector
+
+/**
+ * @brief The quotient graph of a k-way partition and the boundary of every block.
+ *
+ * Block `b` is adjacent to block `c` with the total weight of the nets that have pins in both.
+ * The external nets of a block are the nets with pins in it and in some other block; its boundary
+ * modules are its modules incident to an external net. Both are stored as CSR rows (one row per
+ * block) sorted by node id.
+ */
+struct QuotientGraph {
+    size_t num_parts{};                       ///< Number of blocks
+    std::vector<std::uint64_t> block_weight;  ///< Total module weight of every block
+    std::vector<std::uint64_t> edge_weight;   ///< Dense `num_parts` x `num_parts` adjacency
+    Csr extern_nets;                          ///< External nets of every block
+    Csr boundary_modules;                     ///< Boundary modules of every block
+    size_t num_cut_nets{};                    ///< Number of nets spanning several blocks
+
+    /// The weight of the nets shared by blocks `b` and `c` (`b != c`)
+    auto weight(size_t b, size_t c) const -> std::uint64_t {
+        return this->edge_weight[b * this->num_parts + c];
+    }
+
+    /// The blocks adjacent to block `b`
+    auto neighbors(size_t b) const -> std::vector<std::uint8_t> {
+        auto result = std::vector<std::uint8_t>{};
+        for (size_t c = 0; c != this->num_parts; ++c) {
+            if (c != b && this->weight(b, c) != 0U) {
+                result.push_back(std::uint8_t(c));
+            }
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief Builds the quotient graph and the block boundaries of a partition.
+ *
+ * One parallel sweep over the nets: every thread finds the blocks spanned by each net of its
+ * range, accumulates the quotient edges into a private matrix and records the (block, net) pairs
+ * of the cut nets. The boundary modules are claimed with one atomic flag per module, and the
+ * per-thread lists are merged into the CSR rows by counting sort, so the total work is linear in
+ * the number of pins plus `num_parts` squared per thread (a net spanning `l` blocks adds `l^2`
+ * to its edges).
+ *
+ * Net node ids are assumed to follow the module ids, as in `SimpleNetlist`.
+ *
+ * @tparam Gnl The type of the hypergraph.
+ * @param[in] hyprgraph The input hypergraph.
+ * @param[in] part The block of every module.
+ * @param[in] num_parts The number of blocks.
+ * @return QuotientGraph The quotient graph and the boundaries.
+ */
+template <typename Gnl>
+auto quotient_graph(const Gnl &hyprgraph, const std::vector<std::uint8_t> &part, size_t num_parts)
+    -> QuotientGraph {
+    const auto num_modules = hyprgraph.number_of_modules();
+    const auto num_nets = hyprgraph.number_of_nets();
+    const auto base = index_t(num_modules);
+    auto result = QuotientGraph{};
+    result.num_parts = num_parts;
+
+    auto claimed = std::vector<std::atomic<std::uint8_t>>(num_modules);
+    const auto num_blocks = num_blocks_for(num_nets + num_modules, 4096U);
+    // Sized up front: `parallel_blocks` may run fewer blocks than `num_blocks` on a short range
+    auto weights = std::vector<std::vector<std::uint64_t>>(
+        num_blocks, std::vector<std::uint64_t>(num_parts, 0U));
+    auto edges = std::vector<std::vector<std::uint64_t>>(
+        num_blocks, std::vector<std::uint64_t>(num_parts * num_parts, 0U));
+    auto cut = std::vector<std::vector<std::pair<std::uint8_t, index_t>>>(num_blocks);
+    auto boundary = std::vector<std::vector<std::pair<std::uint8_t, index_t>>>(num_blocks);
+    auto num_cut = std::vector<size_t>(num_blocks, 0U);
+    parallel_blocks(0U, num_modules, num_blocks, [&](size_t b, size_t lo, size_t hi) {
+        for (auto v = lo; v != hi; ++v) {
+            weights[b][part[v]] += hyprgraph.get_module_weight(index_t(v));
+            claimed[v].store(0U, std::memory_order_relaxed);
+        }
+    });
+    parallel_blocks(0U, num_nets, num_blocks, [&](size_t b, size_t lo, size_t hi) {
+        auto &matrix = edges[b];
+        auto seen = std::vector<std::uint8_t>(num_parts, 0U);
+        auto spanned = std::vector<std::uint8_t>{};
+        for (auto i = lo; i != hi; ++i) {
+            const auto net = base + index_t(i);
+            for (const auto &v : hyprgraph.gr[net]) {
+                if (seen[part[v]] == 0U) {
+                    seen[part[v]] = 1U;
+                    spanned.push_back(part[v]);
+                }
+            }
+            for (const auto p : spanned) {
+                seen[p] = 0U;
+            }
+            if (spanned.size() > 1) {
+                ++num_cut[b];
+                const auto w = std::uint64_t(hyprgraph.get_net_weight(net));
+                for (const auto p : spanned) {
+                    cut[b].emplace_back(p, net);
+                    for (const auto q : spanned) {
+                        matrix[size_t(p) * num_parts + q] += p != q ? w : 0U;
+                    }
+                }
+                for (const auto &v : hyprgraph.gr[net]) {
+                    if (claimed[v].exchange(1U, std::memory_order_relaxed) == 0U) {
+                        boundary[b].emplace_back(part[v], index_t(v));
+                    }
+                }
+            }
+            spanned.clear();
+        }
+    });
+
+    result.block_weight.assign(num_parts, 0U);
+    result.edge_weight.assign(num_parts * num_parts, 0U);
+    for (size_t b = 0; b != num_blocks; ++b) {
+        for (size_t p = 0; p != num_parts; ++p) {
+            result.block_weight[p] += weights[b][p];
+        }
+        for (size_t j = 0; j != result.edge_weight.size(); ++j) {
+            result.edge_weight[j] += edges[b][j];
+        }
+        result.num_cut_nets += num_cut[b];
+    }
+
+    // Counting sort of the (block, node) lists into one CSR row per block
+    auto to_csr = [&](const std::vector<std::vector<std::pair<std::uint8_t, index_t>>> &lists) {
+        auto csr = Csr{};
+        csr.offsets.assign(num_parts + 1, 0U);
+        for (const auto &list : lists) {
+            for (const auto &entry : list) {
+                ++csr.offsets[size_t(entry.first) + 1];
+            }
+        }
+        for (size_t p = 0; p != num_parts; ++p) {
+            csr.offsets[p + 1] += csr.offsets[p];
+        }
+        csr.targets.resize(csr.offsets[num_parts]);
+        auto pos = std::vector<size_t>(csr.offsets.begin(), csr.offsets.end() - 1);
+        for (const auto &list : lists) {
+            for (const auto &entry : list) {
+                csr.targets[pos[entry.first]++] = entry.second;
+            }
+        }
+        return csr;
+    };
+    result.extern_nets = to_csr(cut);  // already sorted: the net ranges are in order
+    result.boundary_modules = to_csr(boundary);
+    auto &rows = result.boundary_modules;
+    auto sort_rows = [&](size_t lo, size_t hi) {
+        for (auto p = lo; p != hi; ++p) {
+            std::sort(rows.targets.begin() + static_cast<std::ptrdiff_t>(rows.offsets[p]),
+                      rows.targets.begin() + static_cast<std::ptrdiff_t>(rows.offsets[p + 1]));
+        }
+    };
+    parallel_for(0U, num_parts, sort_rows, 1U);
+    return result;
+}
+
+/**
+ * @brief Fills the snapshot of one block from its boundary.
+ *
+ * The external nets are those of `quotient`; the external modules are the pins of these nets
+ * that lie in other blocks, mapped to their block.
+ *
+ * @tparam Gnl The type of the hypergraph.
+ * @param[in] hyprgraph The input hypergraph.
+ * @param[in] part The block of every module.
+ * @param[in] quotient The result of `quotient_graph` for `part`.
+ * @param[in] block The block.
+ * @return Snapshot<typename Gnl::node_t> The snapshot of the block.
+ */
+template <typename Gnl>
+auto take_snapshot(const Gnl &hyprgraph, const std::vector<std::uint8_t> &part,
+                   const QuotientGraph &quotient, std::uint8_t block)
+    -> Snapshot<typename Gnl::node_t> {
+    auto snapshot = Snapshot<typename Gnl::node_t>{};
+    for (const auto net : quotient.extern_nets[block]) {
+        snapshot.extern_nets.insert(net);
+        for (const auto &v : hyprgraph.gr[net]) {
+            if (part[v] != block) {
+                snapshot.extern_modules[index_t(v)] = part[v];
+            }
+        }
+    }
+    return snapshot;
+}
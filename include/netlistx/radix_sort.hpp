@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>              // for max, sort, stable_sort
+#include <array>                  // for array
+#include <cstddef>                // for size_t
+#include <netlistx/netlist.hpp>   // for index_t
+#include <netlistx/parallel.hpp>  // for parallel_blocks, parallel_for, num_blocks_for
+#include <type_traits>            // for is_unsigned
+#include <utility>                // for pair
+#include <vector>                 // for vector
+
+namespace detail {
+    constexpr unsigned int radix_bits = 8U;
+    constexpr size_t radix_size = size_t{1} << radix_bits;
+    constexpr size_t radix_cutoff = 4096U;  // smaller arrays are sorted by comparison
+    constexpr size_t radix_grain = 65536U;
+
+    /**
+     * @brief LSD radix sort of `keys`, permuting `values` (if any) alongside.
+     *
+     * Every pass handles one 8-bit digit: per-block histograms are computed in parallel, turned
+     * into scatter positions (digit-major, then block order, which keeps the sort stable) and
+     * the keys are scattered in parallel into a second buffer. Only the digits below the bit
+     * width of the largest key are sorted, and a pass is skipped when all keys share its digit.
+     */
+    template <typename Key, typename Value>
+    void radix_sort_impl(std::vector<Key> &keys, std::vector<Value> *values) {
+        static_assert(std::is_unsigned<Key>::value, "radix_sort needs unsigned keys");
+        const auto len = keys.size();
+        const auto num_blocks = num_blocks_for(len, radix_grain);
+        auto block_max = std::vector<Key>(num_blocks, Key{0});
+        parallel_blocks(0U, len, num_blocks, [&](size_t b, size_t lo, size_t hi) {
+            for (auto i = lo; i != hi; ++i) {
+                block_max[b] = std::max(block_max[b], keys[i]);
+            }
+        });
+        auto max_key = Key{0};
+        for (const auto key : block_max) {
+            max_key = std::max(max_key, key);
+        }
+        auto bits = 0U;
+        while (bits < sizeof(Key) * 8U && (max_key >> bits) != 0U) {
+            bits += radix_bits;
+        }
+
+        auto key_buffer = std::vector<Key>(len);
+        auto value_buffer = std::vector<Value>(values != nullptr ? len : 0U);
+        auto hist = std::vector<std::array<size_t, radix_size>>(num_blocks);
+        for (auto shift = 0U; shift < bits; shift += radix_bits) {
+            auto digit = [shift](Key key) { return size_t(key >> shift) & (radix_size - 1U); };
+            parallel_blocks(0U, len, num_blocks, [&](size_t b, size_t lo, size_t hi) {
+                hist[b].fill(0U);
+                for (auto i = lo; i != hi; ++i) {
+                    ++hist[b][digit(keys[i])];
+                }
+            });
+            auto pos = size_t{0};
+            auto trivial = false;
+            for (size_t d = 0; d != radix_size; ++d) {
+                const auto start = pos;
+                for (auto &h : hist) {
+                    const auto count = h[d];
+                    h[d] = pos;
+                    pos += count;
+                }
+                trivial = trivial || pos - start == len;
+            }
+            if (trivial) {
+                continue;  // every key has the same digit
+            }
+            parallel_blocks(0U, len, num_blocks, [&](size_t b, size_t lo, size_t hi) {
+                auto &next = hist[b];
+                for (auto i = lo; i != hi; ++i) {
+                    const auto p = next[digit(keys[i])]++;
+                    key_buffer[p] = keys[i];
+                    if (values != nullptr) {
+                        value_buffer[p] = (*values)[i];
+                    }
+                }
+            });
+            keys.swap(key_buffer);
+            if (values != nullptr) {
+                values->swap(value_buffer);
+            }
+        }
+    }
+}  // namespace detail
+
+/**
+ * @brief Sorts unsigned integer keys with a parallel LSD radix sort.
+ *
+ * The number of passes depends on the largest key, not on the key type: sorting node ids of a
+ * netlist with fewer than 2^16 nodes takes two passes even for 64-bit keys. Small arrays fall
+ * back to `std::sort`.
+ *
+ * @tparam Key An unsigned integer type.
+ * @param[in,out] keys The keys to sort.
+ */
+template <typename Key> void radix_sort(std::vector<Key> &keys) {
+    if (keys.size() < detail::radix_cutoff) {
+        std::sort(keys.begin(), keys.end());
+        return;
+    }
+    detail::radix_sort_impl(keys, static_cast<std::vector<char> *>(nullptr));
+}
+
+/**
+ * @brief Sorts (key, value) pairs by key with a stable parallel LSD radix sort.
+ *
+ * Pairs with equal keys keep their relative order; e.g. sorting net ids with pin indices as
+ * values groups the pins by net in input order.
+ *
+ * @tparam Key An unsigned integer type.
+ * @tparam Value The type of the values.
+ * @param[in,out] keys The keys to sort.
+ * @param[in,out] values The values, permuted like the keys (same length as `keys`).
+ */
+template <typename Key, typename Value>
+void radix_sort_pairs(std::vector<Key> &keys, std::vector<Value> &values) {
+    if (keys.size() < detail::radix_cutoff) {
+        auto pairs = std::vector<std::pair<Key, Value>>(keys.size());
+        for (size_t i = 0; i != keys.size(); ++i) {
+            pairs[i] = {keys[i], values[i]};
+        }
+        std::stable_sort(pairs.begin(), pairs.end(),
+                         [](const auto &p1, const auto &p2) { return p1.first < p2.first; });
+        for (size_t i = 0; i != keys.size(); ++i) {
+            keys[i] = pairs[i].first;
+            values[i] = pairs[i].second;
+        }
+        return;
+    }
+    detail::radix_sort_impl(keys, &values);
+}
+
+/**
+ * @brief Computes the permutation that sorts `keys` stably.
+ *
+ * @tparam Key An unsigned integer type.
+ * @param[in] keys The keys.
+ * @return std::vector<index_t> The indices of `keys` in sorted order.
+ */
+template <typename Key> auto radix_argsort(std::vector<Key> keys) -> std::vector<index_t> {
+    auto perm = std::vector<index_t>(keys.size());
+    parallel_for(0U, perm.size(), [&](size_t lo, size_t hi) {
+        for (auto i = lo; i != hi; ++i) {
+            perm[i] = index_t(i);
+        }
+    });
+    radix_sort_pairs(keys, perm);
+    return perm;
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstddef>                        // for size_t
+#include <cstdint>                        // for uint8_t, uint32_t, uint64_t
+#include <netlistx/fingerprint.hpp>       // for Fingerprint128
+#include <netlistx/mapped_file.hpp>       // for MappedFile
+#include <string>                         // for string
+#include <utility>                        // for pair
+#include <vector>                         // for vector
+
+/**
+ * @brief The kind of per-module result stored in a result file.
+ */
+enum class ResultKind : std::uint32_t {
+    partition = 1,  ///< Block id of every module (8 bits)
+    cover = 2,      ///< Membership bit of every module (1 bit)
+    cluster = 3,    ///< Cluster id of every module (32 bits)
+};
+
+/**
+ * @brief Header metadata of a result file.
+ */
+struct ResultMetadata {
+    static constexpr size_t max_values = 12;     ///< Capacity of `values`
+    static constexpr size_t max_name_size = 23;  ///< Longer value names are truncated
+
+    Fingerprint128 netlist;  ///< Fingerprint of the netlist (see `fingerprint`)
+    ResultKind kind = ResultKind::partition;
+    std::uint32_t num_parts{};  ///< k for partitions, number of clusters for clusterings
+    /// Named objective values and timings, e.g. {"cut", 129}, {"seconds", 0.8}
+    std::vector<std::pair<std::string, double>> values;
+
+    /// The value named `name`, or `fallback` if there is none
+    auto value(boost::string_view name, double fallback = 0.0) const -> double {
+        for (const auto &entry : this->values) {
+            if (entry.first == name) {
+                return entry.second;
+            }
+        }
+        return fallback;
+    }
+};
+
+/**
+ * @brief Writes a partition (one byte per module) or a cover (0/1 per module, stored as bits).
+ *
+ * The file is a 512-byte little-endian header (magic, kind, entry width, netlist fingerprint,
+ * number of entries, `num_parts`, payload checksum and up to 12 named values) followed by the
+ * packed entries, so readers can map it and use the payload in place. The file is written to a
+ * temporary file that is then renamed, so a reader that has the old file mapped keeps it intact.
+ *
+ * @param[in] fileName The path of the result file.
+ * @param[in] metadata The metadata; `kind` must be `partition` or `cover`.
+ * @param[in] entries The entry of every module.
+ * @return true on success.
+ */
+auto writeResult(boost::string_view fileName, const ResultMetadata &metadata,
+                 const std::vector<std::uint8_t> &entries) -> bool;
+
+/**
+ * @brief Writes a clustering (one 32-bit id per module).
+ *
+ * @param[in] fileName The path of the result file.
+ * @param[in] metadata The metadata; `kind` must be `cluster`.
+ * @param[in] entries The cluster id of every module.
+ * @return true on success.
+ */
+auto writeResult(boost::string_view fileName, const ResultMetadata &metadata,
+                 const std::vector<std::uint32_t> &entries) -> bool;
+
+/**
+ * @brief Read access to a result file without parsing.
+ *
+ * `open` maps the file and decodes the fixed-size header only; the entries are read from the
+ * mapping on access. `verify` checks the payload checksum, and `matches` checks that the result
+ * belongs to a given netlist.
+ */
+class ResultFile {
+    MappedFile _file;
+    ResultMetadata _metadata;
+    std::uint64_t _num_entries{};
+    std::uint32_t _entry_bits{};
+    std::uint64_t _checksum{};
+    const unsigned char *_payload = nullptr;
+
+  public:
+    /**
+     * @brief Opens a result file.
+     *
+     * @param[in] fileName The path of the result file.
+     * @return true if the file has a valid header and its payload is complete.
+     */
+    auto open(boost::string_view fileName) -> bool;
+
+    /// The header metadata
+    auto metadata() const -> const ResultMetadata & { return this->_metadata; }
+
+    /// The number of entries (modules)
+    auto size() const -> size_t { return static_cast<size_t>(this->_num_entries); }
+
+    /// The width of an entry, in bits (1, 8 or 32)
+    auto entry_bits() const -> std::uint32_t { return this->_entry_bits; }
+
+    /// The packed entries (little-endian, bits in LSB-first order)
+    auto payload() const -> const unsigned char * { return this->_payload; }
+
+    /// The entry of module `v`
+    auto operator[](size_t v) const -> std::uint32_t {
+        switch (this->_entry_bits) {
+            case 1:
+                return (this->_payload[v / 8U] >> (v % 8U)) & 1U;
+            case 8:
+                return this->_payload[v];
+            default:
+                return std::uint32_t(this->_payload[4U * v])
+                       | std::uint32_t(this->_payload[4U * v + 1U]) << 8U
+                       | std::uint32_t(this->_payload[4U * v + 2U]) << 16U
+                       | std::uint32_t(this->_payload[4U * v + 3U]) << 24U;
+        }
+    }
+
+    /// Whether the payload checksum matches (reads the whole payload)
+    auto verify() const -> bool;
+
+    /**
+     * @brief Whether the result belongs to the netlist with the given fingerprint and size.
+     *
+     * @param[in] netlist The fingerprint of the netlist.
+     * @param[in] num_modules The number of modules of the netlist.
+     * @return true if the fingerprints and the number of entries agree.
+     */
+    auto matches(const Fingerprint128 &netlist, size_t num_modules) const -> bool {
+        return this->_metadata.netlist == netlist && this->_num_entries == num_modules;
+    }
+
+    /// Copies the entries into a vector of bytes (partitions and covers)
+    auto to_bytes() const -> std::vector<std::uint8_t>;
+};
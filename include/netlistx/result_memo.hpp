@@ -0,0 +1,112 @@
+#pragma once
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstring>                        // for memcpy
+#include <netlistx/fingerprint.hpp>       // for Fingerprint128
+#include <string>                         // for string
+#include <type_traits>                    // for is_trivially_copyable
+#include <vector>                         // for vector
+
+/**
+ * @brief On-disk memo of algorithm results keyed by (netlist fingerprint, algorithm, parameters).
+ *
+ * Each entry is stored in its own file inside `directory`, named after a hash of the key. The
+ * file repeats the full key, so hash collisions are detected and reported as misses. Entries are
+ * written to a temporary file first and then renamed, so concurrent jobs never observe partial
+ * entries. Keys computed with `module_relabeling` match renumbered copies of a netlist, so they
+ * must not be used for per-module results, which depend on the module numbering.
+ *
+ * Example:
+ *
+ *     auto memo = ResultMemo{"cache"};
+ *     const auto key = fingerprint(hyprgraph);
+ *     auto cover = std::vector<std::uint8_t>{};
+ *     if (!memo.load_vector(key, "min_vertex_cover", "unit", cover)) {
+ *         cover = ...;  // run the job
+ *         memo.store_vector(key, "min_vertex_cover", "unit", cover);
+ *     }
+ */
+class ResultMemo {
+    std::string _directory;
+
+  public:
+    /**
+     * @brief Constructs a memo stored in `directory` (created on demand).
+     *
+     * @param[in] directory The cache directory.
+     */
+    explicit ResultMemo(boost::string_view directory);
+
+    /**
+     * @brief Get the path of the file holding the given key.
+     *
+     * @param[in] key The netlist fingerprint.
+     * @param[in] algorithm The algorithm name.
+     * @param[in] parameters The canonical parameter string.
+     * @return std::string The path of the entry.
+     */
+    auto path_of(const Fingerprint128 &key, boost::string_view algorithm,
+                 boost::string_view parameters) const -> std::string;
+
+    /**
+     * @brief Looks up an entry.
+     *
+     * @param[in] key The netlist fingerprint.
+     * @param[in] algorithm The algorithm name.
+     * @param[in] parameters The canonical parameter string.
+     * @param[out] payload The stored bytes, if found.
+     * @return true if a valid entry exists.
+     */
+    auto load(const Fingerprint128 &key, boost::string_view algorithm,
+              boost::string_view parameters, std::string &payload) const -> bool;
+
+    /**
+     * @brief Stores an entry, replacing any previous one.
+     *
+     * @param[in] key The netlist fingerprint.
+     * @param[in] algorithm The algorithm name.
+     * @param[in] parameters The canonical parameter string.
+     * @param[in] payload The bytes to store.
+     * @return true if the entry was written.
+     */
+    auto store(const Fingerprint128 &key, boost::string_view algorithm,
+               boost::string_view parameters, boost::string_view payload) const -> bool;
+
+    /**
+     * @brief Removes an entry.
+     *
+     * @return true if an entry was removed.
+     */
+    auto erase(const Fingerprint128 &key, boost::string_view algorithm,
+               boost::string_view parameters) const -> bool;
+
+    /**
+     * @brief Looks up an entry holding an array of trivially copyable values.
+     */
+    template <typename T>
+    auto load_vector(const Fingerprint128 &key, boost::string_view algorithm,
+                     boost::string_view parameters, std::vector<T> &values) const -> bool {
+        static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+        auto payload = std::string{};
+        if (!this->load(key, algorithm, parameters, payload) || payload.size() % sizeof(T) != 0) {
+            return false;
+        }
+        values.resize(payload.size() / sizeof(T));
+        if (!payload.empty()) {
+            std::memcpy(values.data(), payload.data(), payload.size());
+        }
+        return true;
+    }
+
+    /**
+     * @brief Stores an array of trivially copyable values.
+     */
+    template <typename T>
+    auto store_vector(const Fingerprint128 &key, boost::string_view algorithm,
+                      boost::string_view parameters, const std::vector<T> &values) const -> bool {
+        static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+        const auto *data = reinterpret_cast<const char *>(values.data());
+        return this->store(key, algorithm, parameters,
+                           boost::string_view{data, values.size() * sizeof(T)});
+    }
+};
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <algorithm>              // for lower_bound, min, nth_element, sort
+#include <cstddef>                // for size_t
+#include <netlistx/csr.hpp>       // for Csr, CsrRow, module_nets_csr
+#include <netlistx/netlist.hpp>   // for index_t
+#include <netlistx/parallel.hpp>  // for parallel_blocks, num_blocks_for
+#include <utility>                // for pair, swap
+#include <vector>                 // for vector
+
+/**
+ * @brief Counts the common entries of two sorted rows.
+ *
+ * Rows of similar length are merged with a branch-light linear scan; when one row is much
+ * shorter, each of its entries is located in the longer row by galloping (exponential then
+ * binary search), which costs O(m log(n/m)).
+ *
+ * @param[in] a A sorted row.
+ * @param[in] b A sorted row.
+ * @return size_t The size of the intersection.
+ */
+inline auto intersection_size(CsrRow a, CsrRow b) -> size_t {
+    if (a.size() > b.size()) {
+        std::swap(a, b);
+    }
+    auto count = size_t{0};
+    if (a.size() * 16U < b.size()) {
+        const auto *data = b.begin();
+        const auto len = b.size();
+        auto lo = size_t{0};
+        for (const auto x : a) {
+            auto hi = lo;
+            for (auto step = size_t{1}; hi < len && data[hi] < x; step *= 2U) {
+                lo = hi + 1;
+                hi = std::min(lo + step, len);
+            }
+            lo = static_cast<size_t>(std::lower_bound(data + lo, data + hi, x) - data);
+            if (lo == len) {
+                break;
+            }
+            count += data[lo] == x ? 1U : 0U;
+        }
+        return count;
+    }
+    const auto *p = a.begin();
+    const auto *q = b.begin();
+    while (p != a.end() && q != b.end()) {
+        const auto x = *p;
+        const auto y = *q;
+        count += x == y ? 1U : 0U;
+        p += x <= y ? 1 : 0;
+        q += y <= x ? 1 : 0;
+    }
+    return count;
+}
+
+/**
+ * @brief Answers "how many nets do modules u and v share?" queries.
+ *
+ * The index keeps the sorted net list of every module (CSR), so a general query is one sorted
+ * intersection (see `intersection_size`). For hot queries, `build_top_k` precomputes for every
+ * module its k most connected neighbors with their exact shared-net counts; `count` answers from
+ * this sparse table by binary search when the pair is in it.
+ */
+class SharedNetIndex {
+    Csr _nets;                                      // sorted nets of every module
+    std::vector<size_t> _top_offsets;               // per module, into `_top`
+    std::vector<std::pair<index_t, index_t>> _top;  // (neighbor, count), sorted by neighbor
+
+  public:
+    /**
+     * @brief Builds the sorted adjacency of the modules.
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @param[in] hyprgraph The input hypergraph.
+     */
+    template <typename Gnl>
+    explicit SharedNetIndex(const Gnl &hyprgraph) : _nets{module_nets_csr(hyprgraph)} {}
+
+    /**
+     * @brief Number of nets shared by modules `u` and `v`.
+     *
+     * @param[in] u A module.
+     * @param[in] v A module.
+     * @return size_t The number of shared nets.
+     */
+    auto count(index_t u, index_t v) const -> size_t {
+        if (!this->_top_offsets.empty()) {
+            const auto *first = this->_top.data() + this->_top_offsets[u];
+            const auto *last = this->_top.data() + this->_top_offsets[u + 1];
+            const auto *it = std::lower_bound(
+                first, last, v, [](const auto &entry, index_t w) { return entry.first < w; });
+            if (it != last && it->first == v) {
+                return it->second;
+            }
+        }
+        return intersection_size(this->_nets[u], this->_nets[v]);
+    }
+
+    /// The sorted nets of module `v`
+    auto nets(index_t v) const -> CsrRow { return this->_nets[v]; }
+
+    /**
+     * @brief The precomputed neighbors of module `v` with their shared-net counts.
+     *
+     * @param[in] v A module.
+     * @return std::vector<std::pair<index_t, index_t>> (neighbor, count) pairs sorted by neighbor.
+     */
+    auto top_k(index_t v) const -> std::vector<std::pair<index_t, index_t>> {
+        if (this->_top_offsets.empty()) {
+            return {};
+        }
+        return {this->_top.begin() + static_cast<std::ptrdiff_t>(this->_top_offsets[v]),
+                this->_top.begin() + static_cast<std::ptrdiff_t>(this->_top_offsets[v + 1])};
+    }
+
+    /**
+     * @brief Precomputes the `k` most connected neighbors of every module.
+     *
+     * Candidates are ranked by the number of shared nets of degree at most `max_net_degree` (so
+     * huge nets do not make the build quadratic), then the exact counts of the selected
+     * neighbors are computed by intersection. Modules are processed in parallel, each thread
+     * with its own sparse accumulator.
+     *
+     * @tparam Gnl The type of the hypergraph.
+     * @param[in] hyprgraph The hypergraph the index was built from.
+     * @param[in] k The number of neighbors per module.
+     * @param[in] max_net_degree Nets with more pins are ignored when ranking candidates.
+     */
+    template <typename Gnl>
+    void build_top_k(const Gnl &hyprgraph, size_t k, size_t max_net_degree = 64U) {
+        const auto num_modules = this->_nets.size();
+        auto rows = std::vector<std::vector<std::pair<index_t, index_t>>>(num_modules);
+        const auto num_blocks = num_blocks_for(num_modules, 1024U);
+        parallel_blocks(0U, num_modules, num_blocks, [&](size_t /*b*/, size_t lo, size_t hi) {
+            auto acc = std::vector<index_t>(num_modules, 0U);
+            auto touched = std::vector<index_t>{};
+            for (auto u = lo; u != hi; ++u) {
+                for (const auto net : this->_nets[u]) {
+                    if (hyprgraph.gr.degree(net) > max_net_degree) {
+                        continue;
+                    }
+                    for (const auto &w : hyprgraph.gr[net]) {
+                        if (w != u && acc[w]++ == 0U) {
+                            touched.push_back(index_t(w));
+                        }
+                    }
+                }
+                auto &row = rows[u];
+                row.reserve(touched.size());
+                for (const auto w : touched) {
+                    row.emplace_back(w, acc[w]);
+                    acc[w] = 0U;
+                }
+                touched.clear();
+                if (row.size() > k) {
+                    std::nth_element(row.begin(), row.begin() + static_cast<std::ptrdiff_t>(k),
+                                     row.end(), [](const auto &e1, const auto &e2) {
+                                         return e1.second > e2.second
+                                                || (e1.second == e2.second && e1.first < e2.first);
+                                     });
+                    row.resize(k);
+                }
+                for (auto &entry : row) {
+                    entry.second
+                        = index_t(intersection_size(this->_nets[u], this->_nets[entry.first]));
+                }
+                std::sort(row.begin(), row.end());
+            }
+        });
+        this->_top_offsets.assign(num_modules + 1, 0U);
+        for (size_t u = 0; u != num_modules; ++u) {
+            this->_top_offsets[u + 1] = this->_top_offsets[u] + rows[u].size();
+        }
+        this->_top.clear();
+        this->_top.reserve(this->_top_offsets[num_modules]);
+        for (auto &row : rows) {
+            this->_top.insert(this->_top.end(), row.begin(), row.end());
+            std::vector<std::pair<index_t, index_t>>().swap(row);
+        }
+    }
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <netlistx/csr.hpp>  // for Csr, CsrRow
+#include <vector>            // for vector
+
+/**
+ * @brief Half-perimeter wirelength of a placed net.
+ *
+ * @param[in] pins The modules of the net.
+ * @param[in] x The x coordinate of every module.
+ * @param[in] y The y coordinate of every module.
+ * @return double The half perimeter of the bounding box of the pins.
+ */
+auto net_hpwl(CsrRow pins, const std::vector<double> &x, const std::vector<double> &y) -> double;
+
+/**
+ * @brief Rectilinear Steiner minimal tree (RSMT) estimate of the wirelength of a placed net.
+ *
+ * HPWL is exact for up to three pins and underestimates larger nets. Here:
+ *
+ * - nets of up to 6 pins are exact, FLUTE-style: the pins sorted by x give a permutation of
+ *   their y ranks, and the RSMT length is the minimum over a few precomputed vectors of their
+ *   dot product with the gaps between consecutive sorted coordinates. The vectors are generated
+ *   at build time by tools/rsmt_tablegen.cpp;
+ * - nets of up to 64 pins take a rectilinear minimum spanning tree, in which every pin then
+ *   routes two of its edges through a Steiner point when they share an L-shaped part;
+ * - larger nets are split at the median of their wider extent into two halves that share the
+ *   median pin, recursively, and the trees of the parts are added up (O(64 * pins)).
+ *
+ * The estimates of nets of more than 6 pins are lengths of actual trees, so they never fall
+ * below the RSMT.
+ *
+ * @param[in] pins The modules of the net.
+ * @param[in] x The x coordinate of every module.
+ * @param[in] y The y coordinate of every module.
+ * @return double The estimated length of a rectilinear Steiner tree of the pins.
+ */
+auto net_rsmt(CsrRow pins, const std::vector<double> &x, const std::vector<double> &y) -> double;
+
+/**
+ * @brief Total HPWL of all nets, computed in parallel.
+ *
+ * @param[in] net_pins The pins of every net, e.g. from `net_pins_csr`.
+ * @param[in] x The x coordinate of every module.
+ * @param[in] y The y coordinate of every module.
+ * @return double The sum of `net_hpwl` over the nets (independent of the number of threads).
+ */
+auto total_hpwl(const Csr &net_pins, const std::vector<double> &x, const std::vector<double> &y)
+    -> double;
+
+/**
+ * @brief Total RSMT estimate of all nets, computed in parallel.
+ *
+ * @param[in] net_pins The pins of every net, e.g. from `net_pins_csr`.
+ * @param[in] x The x coordinate of every module.
+ * @param[in] y The y coordinate of every module.
+ * @return double The sum of `net_rsmt` over the nets (independent of the number of threads).
+ */
+auto total_rsmt(const Csr &net_pins, const std::vector<double> &x, const std::vector<double> &y)
+    -> double;
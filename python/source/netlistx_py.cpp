@@ -0,0 +1,320 @@
+#include <pybind11/numpy.h>     // for array_t, capsule
+#include <pybind11/pybind11.h>  // for module_, class_, gil_scoped_release
+
+#include <algorithm>                       // for copy_n
+#include <boost/utility/string_view.hpp>   // for boost::string_view
+#include <cstddef>                         // for size_t, ptrdiff_t
+#include <cstdint>                         // for uint8_t, uint32_t, uint64_t
+#include <fstream>                         // for ifstream
+#include <memory>                          // for unique_ptr
+#include <netlistx/csr.hpp>                // for Csr, net_pins_csr, module_nets_csr
+#include <netlistx/fingerprint.hpp>        // for fingerprint
+#include <netlistx/mapped_file.hpp>        // for MappedFile
+#include <netlistx/netlist.hpp>            // for SimpleNetlist, index_t
+#include <netlistx/netlist_algo.hpp>       // for min_vertex_cover, min_maximal_matching
+#include <netlistx/node_link_msgpack.hpp>  // for decodeMsgPack, encodeMsgPack
+#include <netlistx/partition.hpp>          // for block_weights, connectivity_cost
+#include <optional>                        // for optional
+#include <stdexcept>                       // for runtime_error
+#include <string>                          // for string, to_string
+#include <string_view>                     // for string_view
+#include <utility>                         // for move
+#include <vector>                          // for vector
+
+// `py` is the namespace of py2cpp
+namespace pyb = pybind11;
+
+extern auto tryReadNetD(boost::string_view netDFileName, std::string &error)
+    -> std::optional<SimpleNetlist>;
+extern auto tryReadAre(SimpleNetlist &hyprgraph, boost::string_view areFileName,
+                       std::string &error) -> bool;
+extern void writeJSON(boost::string_view jsonFileName, const SimpleNetlist &hyprgraph);
+
+namespace {
+    // Weight function over node ids, as expected by the primal-dual algorithms
+    template <typename T> struct NodeMap {
+        using mapped_type = T;
+        std::vector<T> values;
+
+        auto operator[](index_t v) -> T & { return this->values[v]; }
+        auto operator[](index_t v) const -> const T & { return this->values[v]; }
+    };
+
+    // Node set of the primal-dual algorithms, one flag per node id
+    struct NodeFlags {
+        std::vector<std::uint8_t> flags;
+
+        auto contains(index_t v) const -> bool { return this->flags[v] != 0U; }
+        void insert(index_t v) { this->flags[v] = 1U; }
+    };
+
+    // Hands a vector over to NumPy without copying; the array owns the vector
+    template <typename T> auto to_numpy(std::vector<T> &&values) -> pyb::array_t<T> {
+        auto owner = std::make_unique<std::vector<T>>(std::move(values));
+        const auto size = owner->size();
+        const auto *data = owner->data();
+        auto base = pyb::capsule(owner.get(),
+                                 [](void *ptr) { delete static_cast<std::vector<T> *>(ptr); });
+        owner.release();
+        return pyb::array_t<T>(size, data, base);
+    }
+
+    // Returns a CSR array as the NumPy arrays (offsets, targets) sharing one owner
+    auto to_numpy(Csr &&csr) -> pyb::tuple {
+        static_assert(sizeof(size_t) == sizeof(std::uint64_t), "offsets are exposed as uint64");
+        auto owner = std::make_unique<Csr>(std::move(csr));
+        const auto *offsets = reinterpret_cast<const std::uint64_t *>(owner->offsets.data());
+        const auto *raw = owner.get();
+        auto base
+            = pyb::capsule(owner.get(), [](void *ptr) { delete static_cast<Csr *>(ptr); });
+        owner.release();
+        return pyb::make_tuple(
+            pyb::array_t<std::uint64_t>(raw->offsets.size(), offsets, base),
+            pyb::array_t<index_t>(raw->targets.size(), raw->targets.data(), base));
+    }
+
+    void check_readable(const std::string &fileName) {
+        if (!std::ifstream{fileName}.good()) {
+            throw std::runtime_error("can't open file " + fileName);
+        }
+    }
+
+    using WeightArray = pyb::array_t<double, pyb::array::c_style | pyb::array::forcecast>;
+    using PartArray = pyb::array_t<std::uint8_t, pyb::array::c_style | pyb::array::forcecast>;
+
+    // The weights of the netlist (`module_weight` for the modules), with a per-module or per-net
+    // weight array, if given, copied over them starting at `first`
+    auto node_weights(const SimpleNetlist &hyprgraph, const pyb::object &weight, size_t first,
+                      size_t count) -> NodeMap<double> {
+        auto map = NodeMap<double>{std::vector<double>(hyprgraph.number_of_nodes())};
+        const auto num_modules = hyprgraph.number_of_modules();
+        for (size_t v = 0; v != map.values.size(); ++v) {
+            map.values[v] = v < num_modules ? hyprgraph.get_module_weight(index_t(v))
+                                            : hyprgraph.get_net_weight(index_t(v));
+        }
+        if (weight.is_none()) {
+            return map;
+        }
+        const auto values = weight.cast<WeightArray>();
+        if (values.ndim() != 1 || size_t(values.shape(0)) != count) {
+            throw pyb::value_error("weight must be a 1-D array of length "
+                                   + std::to_string(count));
+        }
+        std::copy_n(values.data(), count, map.values.begin() + std::ptrdiff_t(first));
+        return map;
+    }
+
+    auto to_part(const SimpleNetlist &hyprgraph, const PartArray &part, size_t num_parts)
+        -> std::vector<std::uint8_t> {
+        if (part.ndim() != 1 || size_t(part.shape(0)) != hyprgraph.number_of_modules()) {
+            throw pyb::value_error("part must be a 1-D array with one entry per module");
+        }
+        auto result = std::vector<std::uint8_t>(part.data(), part.data() + part.shape(0));
+        for (const auto block : result) {
+            if (block >= num_parts) {
+                throw pyb::value_error("part has a block id >= num_parts");
+            }
+        }
+        return result;
+    }
+}  // namespace
+
+PYBIND11_MODULE(netlistx, m) {
+    m.doc() = "Python bindings of netlistx (netlists, primal-dual covers and matchings)";
+
+    pyb::class_<SimpleNetlist>(m, "Netlist")
+        .def_property_readonly("num_modules", &SimpleNetlist::number_of_modules)
+        .def_property_readonly("num_nets", &SimpleNetlist::number_of_nets)
+        .def_property_readonly("num_nodes", &SimpleNetlist::number_of_nodes)
+        .def_readwrite("num_pads", &SimpleNetlist::num_pads)
+        .def_property_readonly("max_degree", &SimpleNetlist::get_max_degree)
+        .def_property_readonly("max_net_degree", &SimpleNetlist::get_max_net_degree)
+        .def_readonly("has_fixed_modules", &SimpleNetlist::has_fixed_modules)
+        .def_property_readonly(
+            "module_weight",
+            [](pyb::object self) {
+                // a writable view: assignments through NumPy change the netlist
+                auto &hyprgraph = self.cast<SimpleNetlist &>();
+                if (hyprgraph.module_weight.empty()) {
+                    hyprgraph.module_weight.assign(hyprgraph.number_of_modules(), 1U);
+                }
+                return pyb::array_t<unsigned int>(hyprgraph.module_weight.size(),
+                                                  hyprgraph.module_weight.data(), self);
+            },
+            "Module weights (a view; unit weights are materialized on first access)")
+        .def(
+            "net_pins",
+            [](const SimpleNetlist &hyprgraph) {
+                auto csr = Csr{};
+                {
+                    pyb::gil_scoped_release release;
+                    csr = net_pins_csr(hyprgraph);
+                }
+                return to_numpy(std::move(csr));
+            },
+            "CSR arrays (offsets, module ids) of the pins of every net")
+        .def(
+            "module_nets",
+            [](const SimpleNetlist &hyprgraph) {
+                auto csr = Csr{};
+                {
+                    pyb::gil_scoped_release release;
+                    csr = module_nets_csr(hyprgraph);
+                }
+                return to_numpy(std::move(csr));
+            },
+            "CSR arrays (offsets, net node ids) of the nets of every module")
+        .def("fingerprint",
+             [](const SimpleNetlist &hyprgraph) {
+                 const auto key = fingerprint(hyprgraph);
+                 return pyb::make_tuple(key.hi, key.lo);
+             })
+        .def("__repr__", [](const SimpleNetlist &hyprgraph) {
+            return "<netlistx.Netlist with " + std::to_string(hyprgraph.number_of_modules())
+                   + " modules and " + std::to_string(hyprgraph.number_of_nets()) + " nets>";
+        });
+
+    // ---- Readers and writers ----
+
+    m.def(
+        "read_netd",
+        [](const std::string &fileName) {
+            check_readable(fileName);
+            auto error = std::string{};
+            auto hyprgraph = [&] {
+                pyb::gil_scoped_release release;
+                return tryReadNetD(fileName, error);
+            }();
+            if (!hyprgraph) {
+                throw pyb::value_error(fileName + ": " + error);
+            }
+            return std::move(*hyprgraph);
+        },
+        pyb::arg("file_name"), "Reads an IBM .netD/.net file");
+    m.def(
+        "read_are",
+        [](SimpleNetlist &hyprgraph, const std::string &fileName) {
+            check_readable(fileName);
+            auto error = std::string{};
+            auto ok = false;
+            {
+                // overwrites the weights in place, so `module_weight` views stay valid
+                pyb::gil_scoped_release release;
+                ok = tryReadAre(hyprgraph, fileName, error);
+            }
+            if (!ok) {
+                throw pyb::value_error(fileName + ": " + error);
+            }
+        },
+        pyb::arg("netlist"), pyb::arg("file_name"),
+        "Reads module weights from an IBM .are file; the weights are unchanged on error");
+    m.def(
+        "read_msgpack",
+        [](const std::string &fileName) {
+            auto hyprgraph = [&] {
+                pyb::gil_scoped_release release;
+                auto file = MappedFile{};
+                if (!file.open(fileName)) {
+                    throw std::runtime_error("can't open file " + fileName);
+                }
+                return decodeMsgPack(file.data(), file.size());
+            }();
+            if (!hyprgraph) {
+                throw pyb::value_error("invalid MessagePack node-link file " + fileName);
+            }
+            return std::move(*hyprgraph);
+        },
+        pyb::arg("file_name"), "Reads a MessagePack node-link file");
+    m.def(
+        "to_msgpack",
+        [](const SimpleNetlist &hyprgraph) {
+            auto bytes = std::vector<std::uint8_t>{};
+            {
+                pyb::gil_scoped_release release;
+                bytes = encodeMsgPack(hyprgraph);
+            }
+            return pyb::bytes(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+        },
+        pyb::arg("netlist"), "Encodes a netlist as MessagePack node-link data");
+    m.def(
+        "from_msgpack",
+        [](const pyb::bytes &data) {
+            const auto view = std::string_view(data);
+            auto hyprgraph = decodeMsgPack(reinterpret_cast<const unsigned char *>(view.data()),
+                                           view.size());
+            if (!hyprgraph) {
+                throw pyb::value_error("invalid MessagePack node-link data");
+            }
+            return std::move(*hyprgraph);
+        },
+        pyb::arg("data"), "Decodes a netlist from MessagePack node-link data");
+    m.def(
+        "write_json",
+        [](const SimpleNetlist &hyprgraph, const std::string &fileName) {
+            pyb::gil_scoped_release release;
+            writeJSON(fileName, hyprgraph);
+        },
+        pyb::arg("netlist"), pyb::arg("file_name"), "Writes a node-link JSON file");
+
+    // ---- Algorithms ----
+
+    m.def(
+        "min_vertex_cover",
+        [](const SimpleNetlist &hyprgraph, const pyb::object &weight) {
+            const auto num_modules = hyprgraph.number_of_modules();
+            auto map = node_weights(hyprgraph, weight, 0, num_modules);
+            auto coverset = NodeFlags{std::vector<std::uint8_t>(hyprgraph.number_of_nodes(), 0U)};
+            auto cost = 0.0;
+            {
+                pyb::gil_scoped_release release;
+                cost = min_vertex_cover(hyprgraph, map, coverset);
+                coverset.flags.resize(num_modules);
+            }
+            return pyb::make_tuple(cost, to_numpy(std::move(coverset.flags)));
+        },
+        pyb::arg("netlist"), pyb::arg("weight") = pyb::none(),
+        "Primal-dual weighted vertex cover of the nets; returns (cost, in_cover per module). "
+        "Without `weight`, the module weights of the netlist are used (see `module_weight`)");
+    m.def(
+        "min_maximal_matching",
+        [](const SimpleNetlist &hyprgraph, const pyb::object &weight) {
+            const auto num_modules = hyprgraph.number_of_modules();
+            auto map = node_weights(hyprgraph, weight, num_modules, hyprgraph.number_of_nets());
+            const auto num_nodes = hyprgraph.number_of_nodes();
+            auto matchset = NodeFlags{std::vector<std::uint8_t>(num_nodes, 0U)};
+            auto dep = NodeFlags{std::vector<std::uint8_t>(num_nodes, 0U)};
+            auto cost = 0.0;
+            {
+                pyb::gil_scoped_release release;
+                cost = min_maximal_matching(hyprgraph, map, matchset, dep);
+                matchset.flags.erase(matchset.flags.begin(),
+                                     matchset.flags.begin() + std::ptrdiff_t(num_modules));
+            }
+            return pyb::make_tuple(cost, to_numpy(std::move(matchset.flags)));
+        },
+        pyb::arg("netlist"), pyb::arg("weight") = pyb::none(),
+        "Primal-dual weighted maximal matching; returns (cost, in_matching per net). "
+        "Without `weight`, the net weights of the netlist are used");
+    m.def(
+        "block_weights",
+        [](const SimpleNetlist &hyprgraph, const PartArray &part, size_t num_parts) {
+            const auto blocks = to_part(hyprgraph, part, num_parts);
+            auto weights = std::vector<std::uint64_t>{};
+            {
+                pyb::gil_scoped_release release;
+                weights = block_weights(hyprgraph, blocks, num_parts);
+            }
+            return to_numpy(std::move(weights));
+        },
+        pyb::arg("netlist"), pyb::arg("part"), pyb::arg("num_parts"),
+        "Total module weight of every block of a partition");
+    m.def(
+        "connectivity_cost",
+        [](const SimpleNetlist &hyprgraph, const PartArray &part, size_t num_parts) {
+            const auto blocks = to_part(hyprgraph, part, num_parts);
+            pyb::gil_scoped_release release;
+            return connectivity_cost(hyprgraph, blocks, num_parts);
+        },
+        pyb::arg("netlist"), pyb::arg("part"), pyb::arg("num_parts"),
+        "Connectivity cost (the cut for bipartitions) of a partition");
+}
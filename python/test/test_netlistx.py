@@ -0,0 +1,131 @@
+"""Smoke test of the Python bindings (run from python/test)."""
+
+import os
+import tempfile
+import threading
+
+import numpy as np
+
+import netlistx
+
+
+def test_netlist():
+    hyprgraph = netlistx.read_netd("../../testcases/p1.net")
+    assert hyprgraph.num_modules == 833
+    assert hyprgraph.num_nets == 902
+    assert hyprgraph.max_degree == 9
+    assert hyprgraph.max_net_degree == 18
+
+    offsets, pins = hyprgraph.net_pins()
+    assert offsets.shape == (hyprgraph.num_nets + 1,)
+    assert offsets[-1] == pins.shape[0]
+    assert pins.max() < hyprgraph.num_modules
+    assert not pins.flags.owndata  # a view over C++ memory
+
+    weight = hyprgraph.module_weight
+    assert weight.shape == (hyprgraph.num_modules,)
+    weight[0] = 5
+    assert hyprgraph.module_weight[0] == 5
+
+
+def test_algorithms():
+    hyprgraph = netlistx.read_netd("../../testcases/p1.net")
+    offsets, pins = hyprgraph.net_pins()
+
+    cost, in_cover = netlistx.min_vertex_cover(hyprgraph)
+    assert cost == in_cover.sum()
+    for net in range(hyprgraph.num_nets):
+        assert in_cover[pins[offsets[net] : offsets[net + 1]]].any()
+
+    weight = np.ones(hyprgraph.num_nets)
+    cost, in_matching = netlistx.min_maximal_matching(hyprgraph, weight)
+    assert cost == in_matching.sum()
+
+    part = np.arange(hyprgraph.num_modules, dtype=np.uint8) % 2
+    assert netlistx.block_weights(hyprgraph, part, 2).sum() == hyprgraph.num_modules
+    assert netlistx.connectivity_cost(hyprgraph, part, 2) > 0
+
+
+def write_temp(text):
+    fd, path = tempfile.mkstemp(suffix=".net")
+    with os.fdopen(fd, "w") as file:
+        file.write(text)
+    return path
+
+
+def test_malformed():
+    path = write_temp("0\n4\n2\n3\n0\na0 s 1\nx1 l 1\na2 s 1\na0 l 1\n")
+    try:
+        netlistx.read_netd(path)
+        assert False, "expected ValueError"
+    except ValueError:
+        pass
+    finally:
+        os.remove(path)
+
+    hyprgraph = netlistx.read_netd("../../testcases/p1.net")
+    path = write_temp("a0 3\nb1 4\n")
+    try:
+        netlistx.read_are(hyprgraph, path)
+        assert False, "expected ValueError"
+    except ValueError:
+        pass
+    finally:
+        os.remove(path)
+
+
+def test_are_keeps_views():
+    hyprgraph = netlistx.read_netd("../../testcases/p1.net")
+    weight = hyprgraph.module_weight
+    path = write_temp("a0 7\na1 3\n")
+    try:
+        netlistx.read_are(hyprgraph, path)
+    finally:
+        os.remove(path)
+    assert weight[0] == 7 and weight[1] == 3  # the view sees the new weights
+    assert hyprgraph.module_weight[0] == 7
+
+
+def test_cover_uses_netlist_weights():
+    hyprgraph = netlistx.read_netd("../../testcases/dwarf1.netD")
+    netlistx.read_are(hyprgraph, "../../testcases/dwarf1.are")
+    weight = hyprgraph.module_weight.astype(float)
+    cost, in_cover = netlistx.min_vertex_cover(hyprgraph)
+    assert cost == weight[in_cover != 0].sum()
+    expected_cost, expected_cover = netlistx.min_vertex_cover(hyprgraph, weight)
+    assert cost == expected_cost and (in_cover == expected_cover).all()
+
+    hyprgraph.module_weight[:] = 1  # written through the view
+    cost, in_cover = netlistx.min_vertex_cover(hyprgraph)
+    assert cost == in_cover.sum()
+
+
+def test_msgpack():
+    hyprgraph = netlistx.read_netd("../../testcases/p1.net")
+    copy = netlistx.from_msgpack(netlistx.to_msgpack(hyprgraph))
+    assert copy.fingerprint() == hyprgraph.fingerprint()
+
+
+def test_threads():
+    results = []
+
+    def job():
+        hyprgraph = netlistx.read_netd("../../testcases/ibm01.net")
+        results.append(netlistx.min_vertex_cover(hyprgraph)[0])
+
+    threads = [threading.Thread(target=job) for _ in range(4)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    assert len(set(results)) == 1
+
+
+if __name__ == "__main__":
+    test_netlist()
+    test_algorithms()
+    test_malformed()
+    test_are_keeps_views()
+    test_cover_uses_netlist_weights()
+    test_msgpack()
+    test_threads()
@@ -0,0 +1,433 @@
+#include <algorithm>               // for max, copy
+#include <cstdint>                 // for uint8_t, uint16_t, uint32_t, int32_t, int64_t
+#include <cstring>                 // for memcpy
+#include <fstream>                 // for ofstream
+#include <limits>                  // for numeric_limits
+#include <netlistx/arrow_ipc.hpp>  // for ArrowFileWriter, writeArrowNets, writeArrowModules
+#include <netlistx/binary_io.hpp>  // for store_le
+#include <netlistx/csr.hpp>        // for Csr, net_pins_csr, module_nets_csr
+#include <netlistx/netlist.hpp>    // for SimpleNetlist, index_t
+#include <string>                  // for string, to_string
+#include <utility>                 // for move, pair
+#include <vector>                  // for vector
+
+namespace {
+    constexpr char arrow_magic[8] = {'A', 'R', 'R', 'O', 'W', '1', '\0', '\0'};
+    constexpr size_t buffer_alignment = 64;
+
+    // Enum values of the Arrow FlatBuffers schema (Schema.fbs, Message.fbs)
+    constexpr std::int16_t metadata_v5 = 4;
+    constexpr std::uint8_t type_int = 2;
+    constexpr std::uint8_t type_bool = 6;
+    constexpr std::uint8_t type_list = 12;
+    constexpr std::uint8_t header_schema = 1;
+    constexpr std::uint8_t header_record_batch = 3;
+
+    auto host_is_little_endian() -> bool {
+        const auto one = std::uint16_t{1};
+        auto byte = std::uint8_t{};
+        std::memcpy(&byte, &one, 1);
+        return byte == 1U;
+    }
+
+    /**
+     * @brief A minimal FlatBuffers builder.
+     *
+     * Like the reference implementation, the buffer grows from the back to the front and
+     * objects are referred to by their distance from the back. Tables are built with
+     * `start_table`, `add_scalar`/`add_offset` and `end_table`; their children (strings,
+     * vectors, tables) must be created before `start_table`.
+     */
+    class FlatBuilder {
+        std::vector<std::uint8_t> _buf;  // the data is the last `_size` bytes
+        size_t _size = 0;
+        size_t _min_align = 1;
+        std::vector<std::pair<std::uint16_t, std::uint32_t>> _fields;  // (slot, position)
+        std::uint32_t _table_start = 0;
+
+        auto _front() -> std::uint8_t * {
+            return this->_buf.data() + this->_buf.size() - this->_size;
+        }
+
+        void _grow(size_t n) {
+            this->_size += n;
+            if (this->_size <= this->_buf.size()) {
+                return;
+            }
+            const auto used = static_cast<std::ptrdiff_t>(this->_size - n);
+            auto bigger
+                = std::vector<std::uint8_t>(std::max(2 * this->_buf.size(), this->_size + 256));
+            std::copy(this->_buf.end() - used, this->_buf.end(), bigger.end() - used);
+            this->_buf.swap(bigger);
+        }
+
+        template <typename T> void _put(T value) {
+            this->_grow(sizeof(T));
+            store_le(this->_front(), value);
+        }
+
+      public:
+        auto size() const -> std::uint32_t { return static_cast<std::uint32_t>(this->_size); }
+
+        /// Pads so that `extra` more bytes end at a multiple of `alignment`.
+        void align(size_t alignment, size_t extra = 0) {
+            this->_min_align = std::max(this->_min_align, alignment);
+            const auto padding = (alignment - (this->_size + extra) % alignment) % alignment;
+            this->_grow(padding);
+            std::fill_n(this->_front(), padding, std::uint8_t{0});
+        }
+
+        template <typename T> auto push(T value) -> std::uint32_t {
+            this->align(sizeof(T));
+            this->_put(value);
+            return this->size();
+        }
+
+        auto push_offset(std::uint32_t target) -> std::uint32_t {
+            this->align(4);
+            this->_put(this->size() + 4U - target);
+            return this->size();
+        }
+
+        auto create_string(const std::string &str) -> std::uint32_t {
+            this->align(4, str.size() + 1);
+            this->_put(std::uint8_t{0});
+            for (auto i = str.size(); i-- != 0;) {
+                this->_put(static_cast<std::uint8_t>(str[i]));
+            }
+            this->_put(static_cast<std::uint32_t>(str.size()));
+            return this->size();
+        }
+
+        auto create_offset_vector(const std::vector<std::uint32_t> &targets) -> std::uint32_t {
+            this->align(4, 4 * targets.size());
+            for (auto i = targets.size(); i-- != 0;) {
+                this->_put(this->size() + 4U - targets[i]);
+            }
+            this->_put(static_cast<std::uint32_t>(targets.size()));
+            return this->size();
+        }
+
+        /// Vector of structs made of 8-byte words (`words.size()` is a multiple of `struct_words`)
+        auto create_struct_vector(const std::vector<std::uint64_t> &words, size_t struct_words)
+            -> std::uint32_t {
+            this->align(8, 8 * words.size());
+            for (auto i = words.size(); i-- != 0;) {
+                this->_put(words[i]);
+            }
+            this->_put(static_cast<std::uint32_t>(words.size() / struct_words));
+            return this->size();
+        }
+
+        void start_table() {
+            this->_fields.clear();
+            this->_table_start = this->size();
+        }
+
+        template <typename T> void add_scalar(std::uint16_t slot, T value) {
+            this->_fields.emplace_back(slot, this->push(value));
+        }
+
+        void add_offset(std::uint16_t slot, std::uint32_t target) {
+            this->_fields.emplace_back(slot, this->push_offset(target));
+        }
+
+        auto end_table() -> std::uint32_t {
+            const auto table = this->push(std::int32_t{0});  // soffset to the vtable, patched below
+            auto num_slots = size_t{0};
+            for (const auto &field : this->_fields) {
+                num_slots = std::max(num_slots, size_t{field.first} + 1U);
+            }
+            auto entries = std::vector<std::uint16_t>(num_slots, 0U);
+            for (const auto &field : this->_fields) {
+                entries[field.first] = static_cast<std::uint16_t>(table - field.second);
+            }
+            for (auto i = num_slots; i-- != 0;) {
+                this->_put(entries[i]);
+            }
+            this->_put(static_cast<std::uint16_t>(table - this->_table_start));
+            this->_put(static_cast<std::uint16_t>(4U + 2U * num_slots));
+            const auto vtable = this->size();
+            store_le(this->_buf.data() + this->_buf.size() - table,
+                     static_cast<std::int32_t>(vtable - table));
+            this->_fields.clear();
+            return table;
+        }
+
+        /// Finishes the buffer with the root table and returns its bytes.
+        auto finish(std::uint32_t root) -> std::vector<std::uint8_t> {
+            this->align(std::max(this->_min_align, size_t{4}), 4);
+            this->_put(this->size() + 4U - root);
+            return std::vector<std::uint8_t>(this->_front(), this->_front() + this->_size);
+        }
+    };
+
+    struct BodyBuffer {
+        const void *data;
+        size_t size;
+    };
+
+    auto padded(size_t size, size_t alignment) -> size_t {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    auto create_int_type(FlatBuilder &builder) -> std::uint32_t {
+        builder.start_table();
+        builder.add_scalar(0, std::int32_t{32});  // bitWidth
+        builder.add_scalar(1, std::uint8_t{0});   // is_signed
+        return builder.end_table();
+    }
+
+    auto create_field(FlatBuilder &builder, const std::string &name, std::uint8_t type_type,
+                      std::uint32_t type, const std::vector<std::uint32_t> &children)
+        -> std::uint32_t {
+        const auto name_off = builder.create_string(name);
+        const auto children_off = builder.create_offset_vector(children);
+        builder.start_table();
+        builder.add_offset(0, name_off);
+        builder.add_scalar(1, std::uint8_t{0});  // nullable
+        builder.add_scalar(2, type_type);
+        builder.add_offset(3, type);
+        builder.add_offset(5, children_off);
+        return builder.end_table();
+    }
+
+    auto create_schema(FlatBuilder &builder, const std::vector<ArrowFileWriter::Column> &columns,
+                       const std::vector<std::pair<std::string, std::string>> &metadata)
+        -> std::uint32_t {
+        using Type = ArrowFileWriter::Type;
+        auto fields = std::vector<std::uint32_t>{};
+        for (const auto &column : columns) {
+            if (column.type == Type::boolean) {
+                builder.start_table();
+                const auto type = builder.end_table();
+                fields.push_back(create_field(builder, column.name, type_bool, type, {}));
+                continue;
+            }
+            const auto int_type = create_int_type(builder);
+            if (column.type == Type::uint32) {
+                fields.push_back(create_field(builder, column.name, type_int, int_type, {}));
+                continue;
+            }
+            const auto item = create_field(builder, "item", type_int, int_type, {});
+            builder.start_table();
+            const auto type = builder.end_table();
+            fields.push_back(create_field(builder, column.name, type_list, type, {item}));
+        }
+        auto pairs = std::vector<std::uint32_t>{};
+        for (const auto &entry : metadata) {
+            const auto key = builder.create_string(entry.first);
+            const auto value = builder.create_string(entry.second);
+            builder.start_table();
+            builder.add_offset(0, key);
+            builder.add_offset(1, value);
+            pairs.push_back(builder.end_table());
+        }
+        const auto fields_off = builder.create_offset_vector(fields);
+        const auto pairs_off = builder.create_offset_vector(pairs);
+        builder.start_table();
+        const auto endianness = static_cast<std::int16_t>(host_is_little_endian() ? 0 : 1);
+        builder.add_scalar(0, endianness);
+        builder.add_offset(1, fields_off);
+        builder.add_offset(2, pairs_off);
+        return builder.end_table();
+    }
+
+    auto create_message(FlatBuilder &builder, std::uint8_t header_type, std::uint32_t header,
+                        std::int64_t body_length) -> std::vector<std::uint8_t> {
+        builder.start_table();
+        builder.add_scalar(0, metadata_v5);
+        builder.add_scalar(1, header_type);
+        builder.add_offset(2, header);
+        builder.add_scalar(3, body_length);
+        return builder.finish(builder.end_table());
+    }
+
+    /// Writes an encapsulated message and returns the size of its metadata (with the prefix).
+    auto write_message(std::ofstream &out, const std::vector<std::uint8_t> &message) -> size_t {
+        const auto metadata_size = padded(message.size(), 8);
+        unsigned char prefix[8];
+        store_le(prefix, std::uint32_t{0xFFFFFFFFU});  // continuation marker
+        store_le(prefix + 4, static_cast<std::int32_t>(metadata_size));
+        out.write(reinterpret_cast<const char *>(prefix), 8);
+        out.write(reinterpret_cast<const char *>(message.data()),
+                  static_cast<std::streamsize>(message.size()));
+        static constexpr char zeros[buffer_alignment] = {};
+        out.write(zeros, static_cast<std::streamsize>(metadata_size - message.size()));
+        return 8 + metadata_size;
+    }
+}  // namespace
+
+void ArrowFileWriter::add_column(boost::string_view name, std::vector<std::uint32_t> values) {
+    auto column = Column{};
+    column.name = name.to_string();
+    column.type = Type::uint32;
+    column.length = values.size();
+    column.values = std::move(values);
+    this->_columns.push_back(std::move(column));
+}
+
+void ArrowFileWriter::add_bool_column(boost::string_view name,
+                                      const std::vector<std::uint8_t> &flags) {
+    auto column = Column{};
+    column.name = name.to_string();
+    column.type = Type::boolean;
+    column.length = flags.size();
+    column.bits.assign((flags.size() + 7) / 8, 0U);
+    for (size_t i = 0; i != flags.size(); ++i) {
+        if (flags[i] != 0U) {
+            column.bits[i / 8] = static_cast<std::uint8_t>(column.bits[i / 8] | 1U << (i % 8));
+        }
+    }
+    this->_columns.push_back(std::move(column));
+}
+
+void ArrowFileWriter::add_list_column(boost::string_view name, Csr lists) {
+    auto column = Column{};
+    column.name = name.to_string();
+    column.type = Type::list_uint32;
+    column.length = lists.size();
+    column.values = std::move(lists.targets);
+    column.offsets.reserve(lists.offsets.size());
+    for (const auto offset : lists.offsets) {
+        // entries beyond the int32 range are rejected by `write`
+        column.offsets.push_back(static_cast<std::int32_t>(
+            std::min(offset, size_t(std::numeric_limits<std::int32_t>::max()))));
+    }
+    this->_columns.push_back(std::move(column));
+}
+
+void ArrowFileWriter::add_metadata(boost::string_view key, boost::string_view value) {
+    this->_metadata.emplace_back(key.to_string(), value.to_string());
+}
+
+auto ArrowFileWriter::write(boost::string_view fileName) const -> bool {
+    const auto num_rows = this->_columns.empty() ? size_t{0} : this->_columns.front().length;
+    for (const auto &column : this->_columns) {
+        if (column.length != num_rows
+            || column.values.size() >= size_t(std::numeric_limits<std::int32_t>::max())) {
+            return false;
+        }
+    }
+
+    // Body buffers and field nodes, in pre-order of the fields
+    auto buffers = std::vector<BodyBuffer>{};
+    auto nodes = std::vector<std::uint64_t>{};
+    for (const auto &column : this->_columns) {
+        nodes.insert(nodes.end(), {column.length, 0U});
+        buffers.push_back({nullptr, 0});  // validity bitmap (none)
+        switch (column.type) {
+            case Type::uint32:
+                buffers.push_back({column.values.data(), 4 * column.values.size()});
+                break;
+            case Type::boolean:
+                buffers.push_back({column.bits.data(), column.bits.size()});
+                break;
+            case Type::list_uint32:
+                buffers.push_back({column.offsets.data(), 4 * column.offsets.size()});
+                nodes.insert(nodes.end(), {column.values.size(), 0U});
+                buffers.push_back({nullptr, 0});
+                buffers.push_back({column.values.data(), 4 * column.values.size()});
+                break;
+        }
+    }
+    auto buffer_words = std::vector<std::uint64_t>{};
+    auto body_length = size_t{0};
+    for (const auto &buffer : buffers) {
+        buffer_words.insert(buffer_words.end(), {body_length, buffer.size});
+        body_length += padded(buffer.size, buffer_alignment);
+    }
+
+    auto schema_builder = FlatBuilder{};
+    const auto schema_message = create_message(
+        schema_builder, header_schema,
+        create_schema(schema_builder, this->_columns, this->_metadata), 0);
+
+    auto batch_builder = FlatBuilder{};
+    const auto nodes_off = batch_builder.create_struct_vector(nodes, 2);
+    const auto buffers_off = batch_builder.create_struct_vector(buffer_words, 2);
+    batch_builder.start_table();
+    batch_builder.add_scalar(0, static_cast<std::int64_t>(num_rows));
+    batch_builder.add_offset(1, nodes_off);
+    batch_builder.add_offset(2, buffers_off);
+    const auto batch = batch_builder.end_table();
+    const auto batch_message = create_message(batch_builder, header_record_batch, batch,
+                                              static_cast<std::int64_t>(body_length));
+
+    auto out = std::ofstream{fileName.data(), std::ios::binary | std::ios::trunc};
+    if (out.fail()) {
+        return false;
+    }
+    out.write(arrow_magic, 8);
+    write_message(out, schema_message);
+    const auto batch_offset = static_cast<std::uint64_t>(out.tellp());
+    const auto batch_metadata = write_message(out, batch_message);
+    static constexpr char zeros[buffer_alignment] = {};
+    for (const auto &buffer : buffers) {
+        if (buffer.size != 0) {
+            out.write(static_cast<const char *>(buffer.data),
+                      static_cast<std::streamsize>(buffer.size));
+        }
+        out.write(zeros, static_cast<std::streamsize>(padded(buffer.size, buffer_alignment)
+                                                      - buffer.size));
+    }
+
+    // Footer: the schema again plus the location of the record batch
+    auto footer_builder = FlatBuilder{};
+    const auto schema = create_schema(footer_builder, this->_columns, this->_metadata);
+    const auto dictionaries = footer_builder.create_struct_vector({}, 3);
+    const auto blocks = footer_builder.create_struct_vector(
+        {batch_offset, batch_metadata, body_length}, 3);
+    footer_builder.start_table();
+    footer_builder.add_scalar(0, metadata_v5);
+    footer_builder.add_offset(1, schema);
+    footer_builder.add_offset(2, dictionaries);
+    footer_builder.add_offset(3, blocks);
+    const auto footer = footer_builder.finish(footer_builder.end_table());
+    out.write(reinterpret_cast<const char *>(footer.data()),
+              static_cast<std::streamsize>(footer.size()));
+    unsigned char footer_size[4];
+    store_le(footer_size, static_cast<std::int32_t>(footer.size()));
+    out.write(reinterpret_cast<const char *>(footer_size), 4);
+    out.write(arrow_magic, 6);
+    return static_cast<bool>(out.flush());
+}
+
+auto writeArrowNets(boost::string_view fileName, const SimpleNetlist &hyprgraph) -> bool {
+    auto weights = std::vector<std::uint32_t>{};
+    weights.reserve(hyprgraph.number_of_nets());
+    for (const auto &net : hyprgraph.nets) {
+        weights.push_back(hyprgraph.get_net_weight(net));
+    }
+    auto writer = ArrowFileWriter{};
+    writer.add_list_column("pins", net_pins_csr(hyprgraph));
+    writer.add_column("weight", std::move(weights));
+    writer.add_metadata("num_modules", std::to_string(hyprgraph.number_of_modules()));
+    writer.add_metadata("num_nets", std::to_string(hyprgraph.number_of_nets()));
+    writer.add_metadata("num_pads", std::to_string(hyprgraph.num_pads));
+    return writer.write(fileName);
+}
+
+auto writeArrowModules(boost::string_view fileName, const SimpleNetlist &hyprgraph) -> bool {
+    const auto num_modules = hyprgraph.number_of_modules();
+    auto weights = std::vector<std::uint32_t>{};
+    auto is_pad = std::vector<std::uint8_t>{};
+    auto is_fixed = std::vector<std::uint8_t>{};
+    weights.reserve(num_modules);
+    is_pad.reserve(num_modules);
+    is_fixed.reserve(num_modules);
+    for (const auto &v : hyprgraph.modules) {
+        weights.push_back(hyprgraph.get_module_weight(v));
+        is_pad.push_back(v + hyprgraph.num_pads >= num_modules ? 1U : 0U);
+        is_fixed.push_back(hyprgraph.module_fixed.contains(v) ? 1U : 0U);
+    }
+    auto writer = ArrowFileWriter{};
+    writer.add_list_column("nets", module_nets_csr(hyprgraph));
+    writer.add_column("weight", std::move(weights));
+    writer.add_bool_column("is_pad", is_pad);
+    writer.add_bool_column("is_fixed", is_fixed);
+    writer.add_metadata("num_modules", std::to_string(num_modules));
+    writer.add_metadata("num_nets", std::to_string(hyprgraph.number_of_nets()));
+    writer.add_metadata("num_pads", std::to_string(hyprgraph.num_pads));
+    return writer.write(fileName);
+}
@@ -0,0 +1,244 @@
+#include <algorithm>                 // for equal
+#include <chrono>                    // for steady_clock
+#include <cstdint>                   // for uint8_t, uint32_t, uint64_t
+#include <filesystem>                // for rename, remove
+#include <fstream>                   // for ofstream
+#include <functional>                // for hash
+#include <netlistx/binary_io.hpp>    // for store_le, load_le
+#include <netlistx/checkpoint.hpp>   // for Checkpoint, CheckpointWriter
+#include <netlistx/hash.hpp>         // for hash_combine
+#include <netlistx/mapped_file.hpp>  // for MappedFile
+#include <string>                    // for string, to_string
+#include <system_error>              // for error_code
+#include <thread>                    // for this_thread
+#include <utility>                   // for move
+#include <vector>                    // for vector
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char checkpoint_magic[8] = {'N', 'X', 'C', 'K', 'P', 'T', '1', '\n'};
+    constexpr size_t header_size = 40;  // magic, step, fingerprint, sections, reserved
+    constexpr size_t max_name_size = 4096;
+
+    auto checksum(const unsigned char *data, size_t size) -> std::uint64_t {
+        auto hash = hash_combine(0U, size);
+        auto i = size_t{0};
+        for (; i + 8U <= size; i += 8U) {
+            hash = hash_combine(hash, load_le<std::uint64_t>(data + i));
+        }
+        for (; i != size; ++i) {
+            hash = hash_combine(hash, data[i]);
+        }
+        return hash;
+    }
+
+    template <typename T> void append_le(std::vector<unsigned char> &bytes, T value) {
+        const auto offset = bytes.size();
+        bytes.resize(offset + sizeof(T));
+        store_le(&bytes[offset], value);
+    }
+
+    // Bounds-checked reads from the mapped file
+    class Cursor {
+        const unsigned char *_pos;
+        const unsigned char *_end;
+
+      public:
+        Cursor(const unsigned char *first, const unsigned char *last) : _pos{first}, _end{last} {}
+
+        auto take(size_t n) -> const unsigned char * {
+            if (static_cast<size_t>(this->_end - this->_pos) < n) {
+                return nullptr;
+            }
+            const auto *first = this->_pos;
+            this->_pos += n;
+            return first;
+        }
+
+        template <typename T> auto read(T &value) -> bool {
+            const auto *bytes = this->take(sizeof(T));
+            if (bytes == nullptr) {
+                return false;
+            }
+            value = load_le<T>(bytes);
+            return true;
+        }
+
+        auto at_end() const -> bool { return this->_pos == this->_end; }
+    };
+}  // namespace
+
+auto Checkpoint::find(boost::string_view name) const -> const Section * {
+    for (const auto &section : this->sections) {
+        if (section.name == name) {
+            return &section;
+        }
+    }
+    return nullptr;
+}
+
+void Checkpoint::_put(boost::string_view name, size_t element_size,
+                      std::vector<unsigned char> bytes) {
+    for (auto &section : this->sections) {
+        if (section.name == name) {
+            section.element_size = static_cast<std::uint8_t>(element_size);
+            section.bytes = std::move(bytes);
+            return;
+        }
+    }
+    this->sections.push_back(
+        Section{name.to_string(), static_cast<std::uint8_t>(element_size), std::move(bytes)});
+}
+
+auto writeCheckpoint(boost::string_view fileName, const Checkpoint &checkpoint) -> bool {
+    auto size = header_size + 8U;
+    for (const auto &section : checkpoint.sections) {
+        if (section.name.size() > max_name_size) {
+            return false;
+        }
+        size += 13U + section.name.size() + section.bytes.size();
+    }
+    auto bytes = std::vector<unsigned char>{};
+    bytes.reserve(size);
+    bytes.insert(bytes.end(), checkpoint_magic, checkpoint_magic + 8);
+    append_le(bytes, checkpoint.step);
+    append_le(bytes, checkpoint.netlist.hi);
+    append_le(bytes, checkpoint.netlist.lo);
+    append_le(bytes, static_cast<std::uint32_t>(checkpoint.sections.size()));
+    append_le(bytes, std::uint32_t{0});
+    for (const auto &section : checkpoint.sections) {
+        append_le(bytes, static_cast<std::uint32_t>(section.name.size()));
+        bytes.insert(bytes.end(), section.name.begin(), section.name.end());
+        append_le(bytes, section.element_size);
+        append_le(bytes, static_cast<std::uint64_t>(section.bytes.size()));
+        bytes.insert(bytes.end(), section.bytes.begin(), section.bytes.end());
+    }
+    append_le(bytes, checksum(bytes.data(), bytes.size()));
+
+    // A unique temporary name, so concurrent writers of the same checkpoint do not collide
+    const auto target = fileName.to_string();
+    const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    const auto tag = hash_combine(std::hash<std::thread::id>{}(std::this_thread::get_id()),
+                                  static_cast<std::uint64_t>(now));
+    const auto temporary = target + ".tmp" + std::to_string(tag);
+    auto ec = std::error_code{};
+    {
+        auto out = std::ofstream{temporary, std::ios::binary | std::ios::trunc};
+        if (out.fail()) {
+            return false;
+        }
+        if (!out.write(reinterpret_cast<const char *>(bytes.data()),
+                       static_cast<std::streamsize>(bytes.size()))
+            || !out.flush()) {
+            out.close();
+            fs::remove(temporary, ec);
+            return false;
+        }
+    }
+    // Replaces the target on every platform, so there is no moment without a checkpoint
+    fs::rename(temporary, target, ec);
+    if (ec) {
+        fs::remove(temporary, ec);
+        return false;
+    }
+    return true;
+}
+
+auto readCheckpoint(boost::string_view fileName, Checkpoint &checkpoint) -> bool {
+    auto file = MappedFile{};
+    if (!file.open(fileName) || file.size() < header_size + 8U) {
+        return false;
+    }
+    const auto *data = file.data();
+    const auto body_size = file.size() - 8U;
+    if (!std::equal(checkpoint_magic, checkpoint_magic + 8, reinterpret_cast<const char *>(data))
+        || checksum(data, body_size) != load_le<std::uint64_t>(data + body_size)) {
+        return false;
+    }
+    auto result = Checkpoint{};
+    auto in = Cursor{data + 8, data + body_size};
+    auto num_sections = std::uint32_t{0};
+    auto reserved = std::uint32_t{0};
+    if (!in.read(result.step) || !in.read(result.netlist.hi) || !in.read(result.netlist.lo)
+        || !in.read(num_sections) || !in.read(reserved)) {
+        return false;
+    }
+    for (auto i = 0U; i != num_sections; ++i) {
+        auto section = Checkpoint::Section{};
+        auto name_size = std::uint32_t{0};
+        auto num_bytes = std::uint64_t{0};
+        const unsigned char *name = nullptr;
+        const unsigned char *payload = nullptr;
+        if (!in.read(name_size) || name_size > max_name_size
+            || (name = in.take(name_size)) == nullptr || !in.read(section.element_size)
+            || section.element_size == 0U || !in.read(num_bytes)
+            || (payload = in.take(static_cast<size_t>(num_bytes))) == nullptr
+            || num_bytes % section.element_size != 0U) {
+            return false;
+        }
+        section.name.assign(reinterpret_cast<const char *>(name), name_size);
+        section.bytes.assign(payload, payload + num_bytes);
+        result.sections.push_back(std::move(section));
+    }
+    if (!in.at_end()) {
+        return false;
+    }
+    checkpoint = std::move(result);
+    return true;
+}
+
+CheckpointWriter::CheckpointWriter(boost::string_view fileName)
+    : _fileName{fileName.to_string()}, _thread{[this] { this->_run(); }} {}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        const auto lock = std::lock_guard<std::mutex>{this->_mutex};
+        this->_stop = true;
+    }
+    this->_wakeup.notify_one();
+    this->_thread.join();
+}
+
+void CheckpointWriter::submit(Checkpoint checkpoint) {
+    {
+        const auto lock = std::lock_guard<std::mutex>{this->_mutex};
+        this->_pending = std::make_unique<Checkpoint>(std::move(checkpoint));
+    }
+    this->_wakeup.notify_one();
+}
+
+void CheckpointWriter::flush() {
+    auto lock = std::unique_lock<std::mutex>{this->_mutex};
+    this->_idle.wait(lock, [this] { return this->_pending == nullptr && !this->_writing; });
+}
+
+auto CheckpointWriter::num_written() const -> size_t {
+    const auto lock = std::lock_guard<std::mutex>{this->_mutex};
+    return this->_num_written;
+}
+
+auto CheckpointWriter::ok() const -> bool {
+    const auto lock = std::lock_guard<std::mutex>{this->_mutex};
+    return this->_ok;
+}
+
+void CheckpointWriter::_run() {
+    auto lock = std::unique_lock<std::mutex>{this->_mutex};
+    while (true) {
+        this->_wakeup.wait(lock, [this] { return this->_pending != nullptr || this->_stop; });
+        if (this->_pending == nullptr) {
+            return;  // stopped with nothing left to write
+        }
+        auto checkpoint = std::move(this->_pending);
+        this->_writing = true;
+        lock.unlock();
+        const auto ok = writeCheckpoint(this->_fileName, *checkpoint);
+        checkpoint.reset();
+        lock.lock();
+        this->_writing = false;
+        this->_ok = ok;
+        this->_num_written += ok ? 1U : 0U;
+        this->_idle.notify_all();
+    }
+}
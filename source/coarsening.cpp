@@ -0,0 +1,257 @@
+#include <cstdint>                       // for uint8_t, uint32_t, uint64_t
+#include <limits>                        // for numeric_limits
+#include <netlistx/checkpoint.hpp>       // for Checkpoint, writeCheckpoint, readCheckpoint
+#include <netlistx/coarsening.hpp>       // for CoarseningHierarchy, coarsen, contract
+#include <netlistx/fingerprint.hpp>      // for fingerprint
+#include <netlistx/netlist_algo.hpp>     // for min_maximal_matching
+#include <netlistx/netlist_builder.hpp>  // for NetlistBuilder
+#include <py2cpp/dict.hpp>               // for dict
+#include <py2cpp/set.hpp>                // for set
+#include <string>                        // for string, to_string
+#include <utility>                       // for move, pair
+#include <vector>                        // for vector
+
+namespace {
+    using node_t = SimpleNetlist::node_t;
+
+    auto total_weight(const SimpleNetlist &hyprgraph) -> std::uint64_t {
+        auto total = std::uint64_t{0};
+        for (const auto &v : hyprgraph) {
+            total += hyprgraph.get_module_weight(v);
+        }
+        return total;
+    }
+
+    // The cluster of every module after contracting the nets of a maximal matching
+    auto match_clusters(const SimpleNetlist &hyprgraph, const CoarseningOptions &options,
+                        std::uint64_t max_cluster_weight, std::vector<index_t> &cluster)
+        -> size_t {
+        // Nets that must not be contracted get a prohibitive cost, so the matching avoids them
+        // whenever it can; they are skipped below if it matches them anyway.
+        constexpr auto prohibitive = std::numeric_limits<unsigned int>::max() / 4U;
+        auto weight = py::dict<node_t, unsigned int>{};
+        auto allowed = std::vector<std::uint8_t>(hyprgraph.number_of_nets(), 0U);
+        const auto base = hyprgraph.number_of_modules();
+        for (const auto &net : hyprgraph.nets) {
+            auto cluster_weight = std::uint64_t{0};
+            auto has_fixed = false;
+            for (const auto &v : hyprgraph.gr[net]) {
+                cluster_weight += hyprgraph.get_module_weight(v);
+                has_fixed = has_fixed || hyprgraph.module_fixed.contains(v);
+            }
+            const auto ok = !has_fixed && hyprgraph.gr.degree(net) <= options.max_net_degree
+                            && cluster_weight <= max_cluster_weight;
+            allowed[size_t(net) - base] = ok ? 1U : 0U;
+            weight[net] = ok ? static_cast<unsigned int>(cluster_weight) : prohibitive;
+        }
+        auto matchset = py::set<node_t>{};
+        auto dep = py::set<node_t>{};
+        for (const auto &v : hyprgraph.module_fixed) {
+            dep.insert(v);
+        }
+        min_maximal_matching(hyprgraph, weight, matchset, dep);
+
+        constexpr auto none = std::numeric_limits<index_t>::max();
+        cluster.assign(hyprgraph.number_of_modules(), none);
+        auto num_clusters = index_t{0};
+        for (const auto &net : hyprgraph.nets) {  // in net order, for a deterministic numbering
+            if (!matchset.contains(net) || allowed[size_t(net) - base] == 0U) {
+                continue;
+            }
+            for (const auto &v : hyprgraph.gr[net]) {
+                cluster[v] = num_clusters;
+            }
+            ++num_clusters;
+        }
+        for (auto &c : cluster) {
+            if (c == none) {
+                c = num_clusters++;
+            }
+        }
+        return num_clusters;
+    }
+
+    auto level_key(size_t level, const char *field) -> std::string {
+        return "level" + std::to_string(level) + '.' + field;
+    }
+}  // namespace
+
+auto CoarseningHierarchy::project(size_t level, const std::vector<std::uint8_t> &part) const
+    -> std::vector<std::uint8_t> {
+    const auto &cluster = this->levels[level].cluster;
+    auto result = std::vector<std::uint8_t>(cluster.size());
+    for (size_t v = 0; v != cluster.size(); ++v) {
+        result[v] = part[cluster[v]];
+    }
+    return result;
+}
+
+auto CoarseningHierarchy::project_to_input(size_t level, const std::vector<std::uint8_t> &part)
+    const -> std::vector<std::uint8_t> {
+    auto result = this->project(level, part);
+    for (auto i = level; i != 0; --i) {
+        result = this->project(i - 1, result);
+    }
+    return result;
+}
+
+auto contract(const SimpleNetlist &hyprgraph, const std::vector<index_t> &cluster,
+              size_t num_clusters) -> SimpleNetlist {
+    auto weight = std::vector<unsigned int>(num_clusters, 0U);
+    for (const auto &v : hyprgraph) {
+        weight[cluster[v]] += hyprgraph.get_module_weight(v);
+    }
+
+    // Pins are collected net by net; a net spanning a single cluster is dropped.
+    auto pins = std::vector<std::pair<index_t, index_t>>{};
+    auto last_net = std::vector<index_t>(num_clusters, std::numeric_limits<index_t>::max());
+    auto num_nets = index_t{0};
+    for (const auto &net : hyprgraph.nets) {
+        const auto first = pins.size();
+        for (const auto &v : hyprgraph.gr[net]) {
+            const auto c = cluster[v];
+            if (last_net[c] != num_nets) {
+                last_net[c] = num_nets;
+                pins.emplace_back(c, num_nets);
+            }
+        }
+        if (pins.size() - first > 1) {
+            ++num_nets;
+        } else {
+            if (pins.size() != first) {
+                last_net[pins.back().first] = std::numeric_limits<index_t>::max();
+            }
+            pins.resize(first);
+        }
+    }
+
+    auto builder = NetlistBuilder{uint32_t(num_clusters), num_nets};
+    builder.reserve(pins.size());
+    for (const auto &pin : pins) {
+        builder.add_pin(pin.first, pin.second);
+    }
+    auto result = builder.build();
+    result.module_weight = std::move(weight);
+    for (const auto &v : hyprgraph.module_fixed) {
+        result.module_fixed.insert(cluster[v]);
+    }
+    result.has_fixed_modules = !result.module_fixed.empty();
+    return result;
+}
+
+auto coarsen(const SimpleNetlist &hyprgraph, const CoarseningOptions &options)
+    -> CoarseningHierarchy {
+    auto hierarchy = CoarseningHierarchy{};
+    hierarchy.netlist = fingerprint(hyprgraph);
+    const auto coarsest_size = options.coarsest_size == 0U ? 1U : options.coarsest_size;
+    const auto max_cluster_weight
+        = options.max_cluster_weight != 0U
+              ? std::uint64_t{options.max_cluster_weight}
+              : (total_weight(hyprgraph) + coarsest_size - 1U) / coarsest_size;
+
+    const auto *current = &hyprgraph;
+    auto cluster = std::vector<index_t>{};
+    while (hierarchy.levels.size() < options.max_levels
+           && current->number_of_modules() > coarsest_size) {
+        const auto num_modules = current->number_of_modules();
+        const auto num_clusters = match_clusters(*current, options, max_cluster_weight, cluster);
+        if (double(num_modules - num_clusters) < options.min_reduction * double(num_modules)
+            || num_clusters == num_modules) {
+            break;
+        }
+        auto coarse = contract(*current, cluster, num_clusters);
+        hierarchy.levels.push_back(CoarseLevel{std::move(coarse), std::move(cluster)});
+        current = &hierarchy.levels.back().netlist;
+    }
+    return hierarchy;
+}
+
+auto writeHierarchy(boost::string_view fileName, const CoarseningHierarchy &hierarchy) -> bool {
+    auto checkpoint = Checkpoint{};
+    checkpoint.netlist = hierarchy.netlist;
+    checkpoint.step = hierarchy.num_levels();
+    for (size_t i = 0; i != hierarchy.num_levels(); ++i) {
+        const auto &level = hierarchy.levels[i];
+        const auto &netlist = level.netlist;
+        auto offsets = std::vector<std::uint64_t>{0U};
+        auto targets = std::vector<std::uint32_t>{};
+        for (const auto &net : netlist.nets) {
+            for (const auto &v : netlist.gr[net]) {
+                targets.push_back(std::uint32_t(v));
+            }
+            offsets.push_back(targets.size());
+        }
+        auto weight = std::vector<std::uint32_t>(netlist.number_of_modules());
+        for (const auto &v : netlist) {
+            weight[v] = netlist.get_module_weight(v);
+        }
+        auto fixed = std::vector<std::uint32_t>{};
+        for (const auto &v : netlist.module_fixed) {
+            fixed.push_back(std::uint32_t(v));
+        }
+        checkpoint.put(level_key(i, "cluster"), level.cluster);
+        checkpoint.put(level_key(i, "net_offsets"), offsets);
+        checkpoint.put(level_key(i, "net_pins"), targets);
+        checkpoint.put(level_key(i, "module_weight"), weight);
+        checkpoint.put(level_key(i, "module_fixed"), fixed);
+    }
+    return writeCheckpoint(fileName, checkpoint);
+}
+
+auto readHierarchy(boost::string_view fileName, const SimpleNetlist &hyprgraph,
+                   CoarseningHierarchy &hierarchy) -> bool {
+    auto checkpoint = Checkpoint{};
+    if (!readCheckpoint(fileName, checkpoint) || checkpoint.netlist != fingerprint(hyprgraph)) {
+        return false;
+    }
+    auto result = CoarseningHierarchy{};
+    result.netlist = checkpoint.netlist;
+    auto finer_size = size_t(hyprgraph.number_of_modules());
+    for (size_t i = 0; i != checkpoint.step; ++i) {
+        auto cluster = std::vector<index_t>{};
+        auto offsets = std::vector<std::uint64_t>{};
+        auto targets = std::vector<std::uint32_t>{};
+        auto weight = std::vector<std::uint32_t>{};
+        auto fixed = std::vector<std::uint32_t>{};
+        if (!checkpoint.get(level_key(i, "cluster"), cluster)
+            || !checkpoint.get(level_key(i, "net_offsets"), offsets)
+            || !checkpoint.get(level_key(i, "net_pins"), targets)
+            || !checkpoint.get(level_key(i, "module_weight"), weight)
+            || !checkpoint.get(level_key(i, "module_fixed"), fixed) || cluster.size() != finer_size
+            || offsets.empty() || offsets.front() != 0U || offsets.back() != targets.size()) {
+            return false;
+        }
+        const auto num_modules = weight.size();
+        for (const auto c : cluster) {
+            if (c >= num_modules) {
+                return false;
+            }
+        }
+        auto builder = NetlistBuilder{uint32_t(num_modules), uint32_t(offsets.size() - 1)};
+        builder.reserve(targets.size());
+        for (size_t net = 0; net + 1 != offsets.size(); ++net) {
+            if (offsets[net] > offsets[net + 1]) {
+                return false;
+            }
+            for (auto j = offsets[net]; j != offsets[net + 1]; ++j) {
+                builder.add_pin(targets[j], index_t(net));
+            }
+        }
+        if (!builder.validate().ok()) {
+            return false;
+        }
+        auto netlist = builder.build();
+        netlist.module_weight.assign(weight.begin(), weight.end());
+        for (const auto v : fixed) {
+            if (v >= num_modules) {
+                return false;
+            }
+            netlist.module_fixed.insert(v);
+        }
+        netlist.has_fixed_modules = !netlist.module_fixed.empty();
+        result.levels.push_back(CoarseLevel{std::move(netlist), std::move(cluster)});
+        finer_size = num_modules;
+    }
+    hierarchy = std::move(result);
+    return true;
+}
@@ -0,0 +1,256 @@
+#include <algorithm>                        // for find, swap
+#include <cstdint>                          // for uint8_t, uint64_t
+#include <netlistx/dynamic_hypergraph.hpp>  // for DynamicHypergraph, nlevel_coarsen, refine_local
+#include <unordered_set>                    // for unordered_set
+#include <vector>                           // for vector
+
+DynamicHypergraph::DynamicHypergraph(const SimpleNetlist &hyprgraph)
+    : _pin_begin(hyprgraph.number_of_nets() + 1, 0U),
+      _net_size(hyprgraph.number_of_nets(), 0U),
+      _nets_begin(hyprgraph.number_of_modules() + 1, 0U),
+      _nets_size(hyprgraph.number_of_modules(), 0U),
+      _weight(hyprgraph.number_of_modules()),
+      _active(hyprgraph.number_of_modules(), 1U),
+      _mark(hyprgraph.number_of_nets(), 0U),
+      _num_active{hyprgraph.number_of_modules()} {
+    const auto base = hyprgraph.number_of_modules();
+    for (const auto &net : hyprgraph.nets) {
+        const auto i = size_t(net) - base;
+        this->_net_size[i] = index_t(hyprgraph.gr.degree(net));
+        this->_pin_begin[i + 1] = this->_pin_begin[i] + this->_net_size[i];
+    }
+    this->_pins.resize(this->_pin_begin.back());
+    for (const auto &net : hyprgraph.nets) {
+        const auto i = size_t(net) - base;
+        auto pos = this->_pin_begin[i];
+        for (const auto &v : hyprgraph.gr[net]) {
+            this->_pins[pos++] = index_t(v);
+            ++this->_nets_size[v];
+        }
+    }
+    for (const auto &v : hyprgraph) {
+        this->_weight[v] = hyprgraph.get_module_weight(v);
+        this->_nets_begin[v + 1] = this->_nets_begin[v] + this->_nets_size[v];
+    }
+    this->_incident.resize(this->_nets_begin.back());
+    this->_nets_begin.pop_back();
+    auto pos = this->_nets_begin;
+    for (size_t i = 0; i != this->number_of_nets(); ++i) {
+        for (const auto v : this->pins(index_t(i))) {
+            this->_incident[pos[v]++] = index_t(i);
+        }
+    }
+}
+
+void DynamicHypergraph::_move_to_end(index_t u) {
+    const auto begin = this->_nets_begin[u];
+    const auto size = size_t(this->_nets_size[u]);
+    if (begin + size == this->_incident.size()) {
+        return;
+    }
+    const auto end = this->_incident.size();
+    this->_incident.resize(end + size);  // may reallocate, so copy by index
+    for (size_t i = 0; i != size; ++i) {
+        this->_incident[end + i] = this->_incident[begin + i];
+    }
+    this->_nets_begin[u] = end;
+}
+
+void DynamicHypergraph::contract(index_t u, index_t v) {
+    this->_history.push_back(Memento{u, v, this->_nets_size[u], this->_nets_begin[u]});
+    for (const auto net : this->nets(u)) {
+        this->_mark[net] = 1U;
+    }
+    this->_move_to_end(u);
+    // Only the nets of `v` are visited; the list of `v` is not modified, so the loop is safe
+    // while the arena grows.
+    const auto v_begin = this->_nets_begin[v];
+    for (size_t j = 0; j != this->_nets_size[v]; ++j) {
+        const auto net = this->_incident[v_begin + j];
+        if (!this->is_enabled(net)) {
+            continue;
+        }
+        auto *first = this->_pins.data() + this->_pin_begin[net];
+        auto *last = first + this->_net_size[net];
+        auto *pos = std::find(first, last, v);
+        if (this->_mark[net] != 0U) {
+            std::swap(*pos, *(last - 1));
+            --this->_net_size[net];
+        } else {
+            *pos = u;
+            this->_incident.push_back(net);
+            ++this->_nets_size[u];
+        }
+    }
+    const auto &memento = this->_history.back();
+    const auto u_begin = this->_nets_begin[u];
+    for (size_t j = 0; j != memento.u_size; ++j) {
+        this->_mark[this->_incident[u_begin + j]] = 0U;
+    }
+    this->_weight[u] += this->_weight[v];
+    this->_active[v] = 0U;
+    --this->_num_active;
+}
+
+auto DynamicHypergraph::uncontract() -> Memento {
+    const auto memento = this->_history.back();
+    this->_history.pop_back();
+    const auto u = memento.u;
+    const auto v = memento.v;
+    for (const auto net : this->nets(v)) {
+        const auto begin = this->_pin_begin[net];
+        const auto size = this->_net_size[net];
+        auto *first = this->_pins.data() + begin;
+        auto *last = first + size;
+        if (begin + size != this->_pin_begin[net + 1] && *last == v) {
+            ++this->_net_size[net];  // `v` was removed as a duplicate of `u`
+        } else if (std::find(first, last, v) == last) {
+            *std::find(first, last, u) = v;  // `v` was replaced by `u`
+        }  // else the net was disabled and skipped by the contraction
+    }
+    this->_incident.resize(this->_nets_begin[u] != memento.u_begin
+                               ? this->_nets_begin[u]
+                               : memento.u_begin + memento.u_size);
+    this->_nets_begin[u] = memento.u_begin;
+    this->_nets_size[u] = memento.u_size;
+    this->_weight[u] -= this->_weight[v];
+    this->_active[v] = 1U;
+    ++this->_num_active;
+    return memento;
+}
+
+auto DynamicHypergraph::uncontract_batch(size_t count, std::vector<std::uint8_t> &part)
+    -> std::vector<index_t> {
+    auto reactivated = std::vector<index_t>{};
+    reactivated.reserve(count);
+    for (; count != 0 && !this->_history.empty(); --count) {
+        const auto memento = this->uncontract();
+        part[memento.v] = part[memento.u];
+        reactivated.push_back(memento.v);
+    }
+    return reactivated;
+}
+
+auto nlevel_coarsen(DynamicHypergraph &hyprgraph, const NLevelOptions &options) -> size_t {
+    const auto num_modules = hyprgraph.number_of_modules();
+    const auto coarsest_size = options.coarsest_size == 0U ? 1U : options.coarsest_size;
+    auto max_cluster_weight = std::uint64_t{options.max_cluster_weight};
+    if (max_cluster_weight == 0U) {
+        for (size_t v = 0; v != num_modules; ++v) {
+            max_cluster_weight += hyprgraph.weight(index_t(v));
+        }
+        max_cluster_weight = (max_cluster_weight + coarsest_size - 1U) / coarsest_size;
+    }
+
+    auto rating = std::vector<double>(num_modules, 0.0);
+    auto neighbors = std::vector<index_t>{};
+    auto num_contractions = size_t{0};
+    auto contracted = true;
+    while (contracted && hyprgraph.num_active() > coarsest_size) {
+        contracted = false;
+        for (size_t i = 0; i != num_modules && hyprgraph.num_active() > coarsest_size; ++i) {
+            const auto u = index_t(i);
+            if (!hyprgraph.is_active(u)) {
+                continue;
+            }
+            for (const auto net : hyprgraph.nets(u)) {
+                const auto pins = hyprgraph.pins(net);
+                if (pins.size() < 2 || pins.size() > options.max_net_degree) {
+                    continue;
+                }
+                const auto score = 1.0 / double(pins.size() - 1);
+                for (const auto v : pins) {
+                    if (v != u && rating[v] == 0.0) {
+                        neighbors.push_back(v);
+                    }
+                    rating[v] += v != u ? score : 0.0;
+                }
+            }
+            auto best = u;
+            auto best_rating = 0.0;
+            const auto weight_u = hyprgraph.weight(u);
+            for (const auto v : neighbors) {
+                const auto weight_v = hyprgraph.weight(v);
+                const auto r = rating[v] / (double(weight_u) * double(weight_v));
+                if (std::uint64_t{weight_u} + weight_v <= max_cluster_weight
+                    && (r > best_rating || (r == best_rating && v < best))) {
+                    best = v;
+                    best_rating = r;
+                }
+                rating[v] = 0.0;
+            }
+            neighbors.clear();
+            if (best != u) {
+                hyprgraph.contract(u, best);
+                ++num_contractions;
+                contracted = true;
+            }
+        }
+    }
+    return num_contractions;
+}
+
+auto refine_local(const DynamicHypergraph &hyprgraph, std::vector<std::uint8_t> &part,
+                  std::vector<std::uint64_t> &block_weight, const std::vector<index_t> &seeds,
+                  std::uint64_t max_block_weight) -> std::uint64_t {
+    const auto num_parts = block_weight.size();
+    auto visited = std::unordered_set<index_t>{};
+    auto queue = std::vector<index_t>{};
+    for (const auto v : seeds) {
+        if (hyprgraph.is_active(v) && visited.insert(v).second) {
+            queue.push_back(v);
+        }
+    }
+    auto penalty = std::vector<long long>(num_parts);
+    auto present = std::vector<std::uint8_t>(num_parts);
+    auto total_gain = std::uint64_t{0};
+    for (size_t head = 0; head != queue.size(); ++head) {
+        const auto v = queue[head];
+        const auto from = part[v];
+        auto saving = 0LL;  // nets where `v` is the only pin of its block
+        std::fill(penalty.begin(), penalty.end(), 0LL);
+        for (const auto net : hyprgraph.nets(v)) {
+            if (!hyprgraph.is_enabled(net)) {
+                continue;
+            }
+            std::fill(present.begin(), present.end(), std::uint8_t{0});
+            auto num_from = 0U;
+            for (const auto w : hyprgraph.pins(net)) {
+                present[part[w]] = 1U;
+                num_from += part[w] == from ? 1U : 0U;
+            }
+            saving += num_from == 1U ? 1 : 0;
+            for (size_t b = 0; b != num_parts; ++b) {
+                penalty[b] += present[b] == 0U ? 1 : 0;
+            }
+        }
+        const auto weight = hyprgraph.weight(v);
+        auto best = num_parts;
+        auto best_gain = 0LL;
+        for (size_t b = 0; b != num_parts; ++b) {
+            const auto gain = saving - penalty[b];
+            if (b != from && gain > best_gain && block_weight[b] + weight <= max_block_weight) {
+                best = b;
+                best_gain = gain;
+            }
+        }
+        if (best == num_parts) {
+            continue;
+        }
+        part[v] = std::uint8_t(best);
+        block_weight[from] -= weight;
+        block_weight[best] += weight;
+        total_gain += std::uint64_t(best_gain);
+        for (const auto net : hyprgraph.nets(v)) {
+            if (!hyprgraph.is_enabled(net)) {
+                continue;
+            }
+            for (const auto w : hyprgraph.pins(net)) {
+                if (visited.insert(w).second) {
+                    queue.push_back(w);
+                }
+            }
+        }
+    }
+    return total_gain;
+}
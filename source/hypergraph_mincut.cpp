@@ -0,0 +1,244 @@
+#include <cstdint>                         // for uint8_t, uint64_t
+#include <limits>                          // for numeric_limits
+#include <netlistx/csr.hpp>                // for Csr, net_pins_csr
+#include <netlistx/hypergraph_mincut.hpp>  // for MinCut, global_min_cut
+#include <netlistx/priority_queue.hpp>     // for BucketQueue
+#include <vector>                          // for vector
+
+namespace {
+    constexpr auto npos = std::numeric_limits<size_t>::max();
+
+    /// The contracted hypergraph: only nets with pins in at least two clusters are kept
+    struct Contracted {
+        Csr pins;                           // clusters of every net
+        Csr nets;                           // nets of every cluster
+        std::vector<std::uint64_t> weight;  // weight of every net
+    };
+
+    auto find_root(std::vector<index_t> &parent, index_t v) -> index_t {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    }
+
+    /// Numbers the roots of `parent` from 0 and maps every item to the number of its root
+    auto number_roots(std::vector<index_t> &parent) -> size_t {
+        auto id = std::vector<index_t>(parent.size(), index_t(npos));
+        auto num_roots = size_t{0};
+        for (size_t v = 0; v != parent.size(); ++v) {
+            if (parent[v] == v) {
+                id[v] = index_t(num_roots++);
+            }
+        }
+        for (size_t v = 0; v != parent.size(); ++v) {
+            id[v] = id[find_root(parent, index_t(v))];  // roots keep their number
+        }
+        parent.swap(id);
+        return num_roots;
+    }
+
+    /// Relabels the pins by `cluster`, then drops duplicate pins and nets left with one pin
+    auto contract_pins(const Csr &pins, const std::vector<std::uint64_t> &weight,
+                       const std::vector<index_t> &cluster, size_t num_clusters) -> Contracted {
+        auto result = Contracted{};
+        result.pins.targets.reserve(pins.number_of_entries());
+        auto last_net = std::vector<size_t>(num_clusters, npos);
+        for (size_t i = 0; i != pins.size(); ++i) {
+            const auto start = result.pins.targets.size();
+            for (const auto v : pins[i]) {
+                const auto c = cluster[v];
+                if (last_net[c] != i) {
+                    last_net[c] = i;
+                    result.pins.targets.push_back(c);
+                }
+            }
+            if (result.pins.targets.size() - start < 2U) {
+                result.pins.targets.resize(start);
+                continue;
+            }
+            result.pins.offsets.push_back(result.pins.targets.size());
+            result.weight.push_back(weight[i]);
+        }
+        auto &nets = result.nets;
+        nets.offsets.assign(num_clusters + 1, 0U);
+        for (const auto c : result.pins.targets) {
+            ++nets.offsets[c + 1];
+        }
+        for (size_t c = 0; c != num_clusters; ++c) {
+            nets.offsets[c + 1] += nets.offsets[c];
+        }
+        nets.targets.resize(nets.offsets[num_clusters]);
+        auto pos = nets.offsets;
+        for (size_t net = 0; net != result.pins.size(); ++net) {
+            for (const auto c : result.pins[net]) {
+                nets.targets[pos[c]++] = index_t(net);
+            }
+        }
+        return result;
+    }
+
+    /// The total weight of the nets of cluster `c`, i.e. of the cut that isolates it
+    auto cluster_cut(const Contracted &hgr, size_t c) -> std::uint64_t {
+        auto total = std::uint64_t{0};
+        for (const auto net : hgr.nets[c]) {
+            total += hgr.weight[net];
+        }
+        return total;
+    }
+
+    /**
+     * Merges every pair of clusters sharing nets of weight at least `bound`, counted over the
+     * nets of at most `max_net_degree` pins. Returns the number of clusters after the merge and
+     * the new cluster of every cluster in `parent`.
+     */
+    auto merge_heavy_pairs(const Contracted &hgr, std::uint64_t bound, size_t max_net_degree,
+                           std::vector<index_t> &parent) -> size_t {
+        const auto num_clusters = hgr.nets.size();
+        parent.resize(num_clusters);
+        for (size_t c = 0; c != num_clusters; ++c) {
+            parent[c] = index_t(c);
+        }
+        auto shared = std::vector<std::uint64_t>(num_clusters, 0U);
+        auto touched = std::vector<index_t>{};
+        for (size_t u = 0; u != num_clusters; ++u) {
+            for (const auto net : hgr.nets[u]) {
+                const auto pins = hgr.pins[net];
+                if (pins.size() > max_net_degree) {
+                    continue;
+                }
+                for (const auto w : pins) {
+                    if (w <= u) {
+                        continue;  // every pair is counted from its smaller cluster
+                    }
+                    if (shared[w] == 0U) {
+                        touched.push_back(w);
+                    }
+                    shared[w] += hgr.weight[net];
+                }
+            }
+            for (const auto w : touched) {
+                if (shared[w] >= bound) {
+                    parent[find_root(parent, w)] = find_root(parent, index_t(u));
+                }
+                shared[w] = 0U;
+            }
+            touched.clear();
+        }
+        return number_roots(parent);
+    }
+
+    /**
+     * Computes a maximum-adjacency ordering v_1, ..., v_n and merges v_{i-1} and v_i when the key
+     * of v_i reaches `bound`, and always v_{n-1} and v_n. The key of a cluster is the total
+     * weight of its nets with a pin among the ordered clusters; every net raises the keys of its
+     * pins once, when it is first touched. Restricted to the nets among v_1, ..., v_i, the
+     * ordering is still a maximum-adjacency ordering, whose last two clusters are separated by
+     * no cut lighter than the key of v_i; the cuts of the whole hypergraph are not lighter.
+     * Returns the number of clusters after the merge and the new cluster of every cluster in
+     * `parent`.
+     */
+    auto merge_ordered_pairs(const Contracted &hgr, std::uint64_t bound,
+                             std::vector<index_t> &parent) -> size_t {
+        const auto num_clusters = hgr.nets.size();
+        auto max_key = 0LL;
+        for (const auto w : hgr.weight) {
+            max_key += static_cast<long long>(w);
+        }
+        auto queue = BucketQueue{num_clusters, max_key};
+        for (size_t c = 0; c != num_clusters; ++c) {
+            parent[c] = index_t(c);
+            queue.push(index_t(c), 0);
+        }
+        auto touched = std::vector<std::uint8_t>(hgr.pins.size(), 0U);
+        auto prev = index_t(npos);
+        while (!queue.empty()) {
+            const auto key = std::uint64_t(queue.key(queue.top()));
+            const auto v = queue.pop();
+            if (prev != index_t(npos) && (key >= bound || queue.empty())) {
+                parent[find_root(parent, v)] = find_root(parent, prev);
+            }
+            prev = v;
+            for (const auto net : hgr.nets[v]) {
+                if (touched[net] != 0U) {
+                    continue;
+                }
+                touched[net] = 1U;
+                const auto w = static_cast<long long>(hgr.weight[net]);
+                for (const auto u : hgr.pins[net]) {
+                    if (queue.contains(u)) {
+                        queue.update(u, queue.key(u) + w);
+                    }
+                }
+            }
+        }
+        return number_roots(parent);
+    }
+}  // namespace
+
+auto global_min_cut(const SimpleNetlist &hyprgraph, size_t max_net_degree) -> MinCut {
+    const auto num_modules = hyprgraph.number_of_modules();
+    auto result = MinCut{0U, std::vector<std::uint8_t>(num_modules, 0U)};
+    if (num_modules < 2U) {
+        return result;
+    }
+
+    auto label = std::vector<index_t>(num_modules);  // the cluster of every module
+    for (size_t v = 0; v != num_modules; ++v) {
+        label[v] = index_t(v);
+    }
+    const auto pins = net_pins_csr(hyprgraph);
+    auto weight = std::vector<std::uint64_t>(pins.size());
+    for (size_t i = 0; i != pins.size(); ++i) {
+        weight[i] = hyprgraph.get_net_weight(hyprgraph.nets[i]);
+    }
+
+    // Connected components: the cut between two of them is empty
+    auto parent = label;
+    for (size_t i = 0; i != pins.size(); ++i) {
+        for (const auto v : pins[i]) {
+            parent[find_root(parent, v)] = find_root(parent, pins[i][0]);
+        }
+    }
+    if (number_roots(parent) > 1U) {
+        for (size_t v = 0; v != num_modules; ++v) {
+            result.side[v] = parent[v] == parent[0] ? 1U : 0U;
+        }
+        return result;
+    }
+
+    auto hgr = contract_pins(pins, weight, label, num_modules);
+    auto num_clusters = num_modules;
+    result.weight = std::numeric_limits<std::uint64_t>::max();
+    auto best_cluster = index_t(npos);
+    while (true) {
+        // Every cluster is a cut; the cut of the last cluster of an ordering is among them
+        for (size_t c = 0; c != num_clusters && num_clusters > 1U; ++c) {
+            const auto cut = cluster_cut(hgr, c);
+            if (cut < result.weight) {
+                result.weight = cut;
+                best_cluster = index_t(c);
+            }
+        }
+        if (best_cluster != index_t(npos)) {
+            for (size_t v = 0; v != num_modules; ++v) {
+                result.side[v] = label[v] == best_cluster ? 1U : 0U;
+            }
+            best_cluster = index_t(npos);
+        }
+        if (num_clusters <= 2U) {
+            break;
+        }
+        auto next = merge_heavy_pairs(hgr, result.weight, max_net_degree, parent);
+        if (next == num_clusters) {
+            next = merge_ordered_pairs(hgr, result.weight, parent);
+        }
+        for (auto &c : label) {
+            c = parent[c];
+        }
+        hgr = contract_pins(hgr.pins, hgr.weight, parent, next);
+        num_clusters = next;
+    }
+    return result;
+}
@@ -0,0 +1,88 @@
+#include <fstream>                    // for ifstream
+#include <netlistx/mapped_file.hpp>  // for MappedFile
+#include <string>                     // for string
+#include <utility>                    // for exchange, move
+
+#if defined(_WIN32)
+#    define NETLISTX_USE_MMAP 0
+#else
+#    define NETLISTX_USE_MMAP 1
+#    include <fcntl.h>     // for open, O_RDONLY
+#    include <sys/mman.h>  // for mmap, munmap
+#    include <sys/stat.h>  // for fstat
+#    include <unistd.h>    // for close
+#endif
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : _data{std::exchange(other._data, nullptr)},
+      _size{std::exchange(other._size, 0U)},
+      _mapped{std::exchange(other._mapped, false)},
+      _buffer{std::move(other._buffer)} {}
+
+auto MappedFile::operator=(MappedFile &&other) noexcept -> MappedFile & {
+    if (this != &other) {
+        this->close();
+        this->_data = std::exchange(other._data, nullptr);
+        this->_size = std::exchange(other._size, 0U);
+        this->_mapped = std::exchange(other._mapped, false);
+        this->_buffer = std::move(other._buffer);
+    }
+    return *this;
+}
+
+auto MappedFile::open(boost::string_view fileName) -> bool {
+    this->close();
+    const auto name = fileName.to_string();
+#if NETLISTX_USE_MMAP
+    const auto fd = ::open(name.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    const auto size = static_cast<size_t>(info.st_size);
+    if (size != 0U) {
+        auto *addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            ::close(fd);
+            this->_data = static_cast<const unsigned char *>(addr);
+            this->_size = size;
+            this->_mapped = true;
+            return true;
+        }
+    }
+    ::close(fd);
+    // an empty file, or a file system without mmap support: fall back to reading
+#endif
+    auto in = std::ifstream{name, std::ios::binary};
+    if (in.fail()) {
+        return false;
+    }
+    in.seekg(0, std::ios::end);
+    this->_buffer.resize(static_cast<size_t>(in.tellg()));
+    in.seekg(0, std::ios::beg);
+    if (!this->_buffer.empty()
+        && !in.read(reinterpret_cast<char *>(this->_buffer.data()),
+                    static_cast<std::streamsize>(this->_buffer.size()))) {
+        this->_buffer.clear();
+        return false;
+    }
+    this->_data = this->_buffer.data();
+    this->_size = this->_buffer.size();
+    return true;
+}
+
+void MappedFile::close() {
+#if NETLISTX_USE_MMAP
+    if (this->_mapped) {
+        ::munmap(const_cast<unsigned char *>(this->_data), this->_size);
+    }
+#endif
+    this->_data = nullptr;
+    this->_size = 0U;
+    this->_mapped = false;
+    this->_buffer.clear();
+}
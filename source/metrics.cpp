@@ -0,0 +1,311 @@
+#include <cstdio>                // for snprintf
+#include <netlistx/metrics.hpp>  // for MetricsRegistry, Histogram, MetricsServer
+#include <stdexcept>             // for invalid_argument
+#include <string>                // for string, to_string
+#include <type_traits>           // for is_same
+
+#if defined(_WIN32)
+#    define NETLISTX_USE_SOCKETS 0
+#else
+#    define NETLISTX_USE_SOCKETS 1
+#    include <arpa/inet.h>   // for htonl, htons, ntohs
+#    include <netinet/in.h>  // for sockaddr_in, INADDR_LOOPBACK
+#    include <poll.h>        // for poll, pollfd, POLLIN
+#    include <sys/socket.h>  // for socket, bind, listen, accept, recv, send
+#    include <sys/time.h>    // for timeval
+#    include <unistd.h>      // for close
+#endif
+
+namespace {
+    auto format_double(double value) -> std::string {
+        char buffer[32];
+        std::snprintf(buffer, sizeof buffer, "%.10g", value);
+        return buffer;
+    }
+
+    auto escape(const std::string &value) -> std::string {
+        auto result = std::string{};
+        for (const auto c : value) {
+            if (c == '\\' || c == '"') {
+                result += '\\';
+                result += c;
+            } else if (c == '\n') {
+                result += "\\n";
+            } else {
+                result += c;
+            }
+        }
+        return result;
+    }
+
+    // `{key="value",...}`, or an empty string without labels
+    auto label_string(const MetricLabels &labels) -> std::string {
+        if (labels.empty()) {
+            return {};
+        }
+        auto result = std::string{"{"};
+        for (const auto &label : labels) {
+            if (result.size() > 1) {
+                result += ',';
+            }
+            result += label.first + "=\"" + escape(label.second) + '"';
+        }
+        return result + '}';
+    }
+
+    // Adds the label `le` to a label string
+    auto with_le(const std::string &labels, const std::string &le) -> std::string {
+        const auto pair = "le=\"" + le + '"';
+        return labels.empty() ? '{' + pair + '}'
+                              : labels.substr(0, labels.size() - 1) + ',' + pair + '}';
+    }
+
+    template <typename T>
+    auto find_or_add(std::vector<std::pair<std::string, std::unique_ptr<T>>> &metrics,
+                     const std::string &labels, double unit = 1.0) -> T & {
+        for (auto &entry : metrics) {
+            if (entry.first == labels) {
+                return *entry.second;
+            }
+        }
+        if constexpr (std::is_same<T, Histogram>::value) {
+            metrics.emplace_back(labels, std::make_unique<T>(unit));
+        } else {
+            static_cast<void>(unit);
+            metrics.emplace_back(labels, std::make_unique<T>());
+        }
+        return *metrics.back().second;
+    }
+}  // namespace
+
+auto Counter::value() const -> std::uint64_t {
+    auto total = std::uint64_t{0};
+    for (const auto &shard : this->_shards) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+auto HistogramSnapshot::quantile(double q) const -> std::uint64_t {
+    if (this->count == 0U) {
+        return 0U;
+    }
+    const auto clamped = q < 0.0 ? 0.0 : q > 1.0 ? 1.0 : q;
+    auto rank = static_cast<std::uint64_t>(clamped * static_cast<double>(this->count - 1U));
+    for (size_t b = 0; b != this->counts.size(); ++b) {
+        if (rank < this->counts[b]) {
+            return Histogram::upper_bound_of(b);
+        }
+        rank -= this->counts[b];
+    }
+    return Histogram::upper_bound_of(this->counts.size() - 1U);
+}
+
+Histogram::Histogram(double unit) : _shards{new Shard[metrics_num_shards]()}, _unit{unit} {}
+
+auto Histogram::upper_bound_of(size_t b) -> std::uint64_t {
+    if (b < (size_t{1} << sub_bucket_bits)) {
+        return b;
+    }
+    const auto shift = (b >> sub_bucket_bits) - 1U;
+    const auto sub = b & ((size_t{1} << sub_bucket_bits) - 1U);
+    const auto lower = std::uint64_t((size_t{1} << sub_bucket_bits) + sub) << shift;
+    return lower + ((std::uint64_t{1} << shift) - 1U);
+}
+
+auto Histogram::snapshot() const -> HistogramSnapshot {
+    auto result = HistogramSnapshot{};
+    result.counts.assign(num_buckets, 0U);
+    for (size_t s = 0; s != metrics_num_shards; ++s) {
+        const auto &shard = this->_shards[s];
+        for (size_t b = 0; b != num_buckets; ++b) {
+            result.counts[b] += shard.counts[b].load(std::memory_order_relaxed);
+        }
+        result.sum += shard.sum.load(std::memory_order_relaxed);
+    }
+    for (const auto count : result.counts) {
+        result.count += count;
+    }
+    return result;
+}
+
+auto MetricsRegistry::_family(const std::string &name, const std::string &help, char type)
+    -> Family & {
+    auto &family = this->_families[name];
+    if (family.type == 0) {
+        family.type = type;
+        family.help = help;
+    } else if (family.type != type) {
+        throw std::invalid_argument("metric " + name + " is registered with another type");
+    }
+    return family;
+}
+
+auto MetricsRegistry::counter(const std::string &name, const std::string &help,
+                              const MetricLabels &labels) -> Counter & {
+    const auto lock = std::lock_guard<std::mutex>{this->_mutex};
+    return find_or_add(this->_family(name, help, 'c').counters, label_string(labels));
+}
+
+auto MetricsRegistry::gauge(const std::string &name, const std::string &help,
+                            const MetricLabels &labels) -> Gauge & {
+    const auto lock = std::lock_guard<std::mutex>{this->_mutex};
+    return find_or_add(this->_family(name, help, 'g').gauges, label_string(labels));
+}
+
+auto MetricsRegistry::histogram(const std::string &name, const std::string &help,
+                                const MetricLabels &labels, double unit) -> Histogram & {
+    const auto lock = std::lock_guard<std::mutex>{this->_mutex};
+    return find_or_add(this->_family(name, help, 'h').histograms, label_string(labels), unit);
+}
+
+auto MetricsRegistry::render() const -> std::string {
+    const auto lock = std::lock_guard<std::mutex>{this->_mutex};
+    auto out = std::string{};
+    for (const auto &entry : this->_families) {
+        const auto &name = entry.first;
+        const auto &family = entry.second;
+        const auto *type = family.type == 'c'   ? "counter"
+                           : family.type == 'g' ? "gauge"
+                                                : "histogram";
+        out += "# HELP " + name + ' ' + family.help + '\n';
+        out += "# TYPE " + name + ' ' + type + '\n';
+        for (const auto &metric : family.counters) {
+            out += name + metric.first + ' ' + std::to_string(metric.second->value()) + '\n';
+        }
+        for (const auto &metric : family.gauges) {
+            out += name + metric.first + ' ' + std::to_string(metric.second->value()) + '\n';
+        }
+        for (const auto &metric : family.histograms) {
+            const auto &labels = metric.first;
+            const auto unit = metric.second->unit();
+            const auto snapshot = metric.second->snapshot();
+            auto first = size_t{0};
+            auto last = size_t{0};  // one past the last non-empty bucket
+            for (size_t b = 0; b != snapshot.counts.size(); ++b) {
+                if (snapshot.counts[b] != 0U) {
+                    first = last == 0U ? b : first;
+                    last = b + 1U;
+                }
+            }
+            // cumulative counts at the octave ends (upper bounds 2^k - 1) covering the data
+            auto cumulative = std::uint64_t{0};
+            for (size_t b = 0; b < snapshot.counts.size() && last != 0U; ++b) {
+                cumulative += snapshot.counts[b];
+                const auto bound = Histogram::upper_bound_of(b);
+                if (b < first || (bound & (bound + 1U)) != 0U) {
+                    continue;
+                }
+                out += name + "_bucket"
+                       + with_le(labels, format_double(static_cast<double>(bound) * unit)) + ' '
+                       + std::to_string(cumulative) + '\n';
+                if (b + 1U >= last) {
+                    break;
+                }
+            }
+            out += name + "_bucket" + with_le(labels, "+Inf") + ' '
+                   + std::to_string(snapshot.count) + '\n';
+            out += name + "_sum" + labels + ' '
+                   + format_double(static_cast<double>(snapshot.sum) * unit) + '\n';
+            out += name + "_count" + labels + ' ' + std::to_string(snapshot.count) + '\n';
+        }
+    }
+    return out;
+}
+
+auto MetricsServer::start(std::uint16_t port) -> bool {
+#if NETLISTX_USE_SOCKETS
+    if (this->_running.load()) {
+        return false;
+    }
+    const auto fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+    const auto one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof one);
+    auto addr = sockaddr_in{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    auto length = socklen_t{sizeof addr};
+    if (::bind(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof addr) != 0
+        || ::listen(fd, 16) != 0
+        || ::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &length) != 0) {
+        ::close(fd);
+        return false;
+    }
+    this->_socket = fd;
+    this->_port = ntohs(addr.sin_port);
+    this->_running.store(true);
+    this->_thread = std::thread([this] { this->_serve(); });
+    return true;
+#else
+    static_cast<void>(port);
+    return false;
+#endif
+}
+
+void MetricsServer::stop() {
+    if (!this->_running.exchange(false)) {
+        return;
+    }
+    this->_thread.join();
+#if NETLISTX_USE_SOCKETS
+    ::close(this->_socket);
+#endif
+    this->_socket = -1;
+}
+
+void MetricsServer::_serve() {
+#if NETLISTX_USE_SOCKETS
+#    if defined(MSG_NOSIGNAL)
+    constexpr auto send_flags = MSG_NOSIGNAL;  // a closed client must not raise SIGPIPE
+#    else
+    constexpr auto send_flags = 0;
+#    endif
+    while (this->_running.load()) {
+        auto listening = pollfd{this->_socket, POLLIN, 0};
+        if (::poll(&listening, 1, 100) <= 0) {
+            continue;  // wake up regularly to notice `stop`
+        }
+        const auto client = ::accept(this->_socket, nullptr, nullptr);
+        if (client < 0) {
+            continue;
+        }
+        auto timeout = timeval{};
+        timeout.tv_sec = 1;
+        ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof timeout);
+        auto request = std::string{};
+        char buffer[1024];
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192U) {
+            const auto n = ::recv(client, buffer, sizeof buffer, 0);
+            if (n <= 0) {
+                break;
+            }
+            request.append(buffer, static_cast<size_t>(n));
+        }
+        auto status = std::string{"200 OK"};
+        auto body = std::string{};
+        if (request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 6, "GET / ") == 0) {
+            body = this->_registry.render();
+        } else {
+            status = "404 Not Found";
+            body = "not found\n";
+        }
+        const auto response = "HTTP/1.1 " + status
+                              + "\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8"
+                              + "\r\nContent-Length: " + std::to_string(body.size())
+                              + "\r\nConnection: close\r\n\r\n" + body;
+        for (size_t sent = 0; sent < response.size();) {
+            const auto n
+                = ::send(client, response.data() + sent, response.size() - sent, send_flags);
+            if (n <= 0) {
+                break;
+            }
+            sent += static_cast<size_t>(n);
+        }
+        ::close(client);
+    }
+#endif
+}
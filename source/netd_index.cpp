@@ -0,0 +1,556 @@
+#include <algorithm>                      // for min, max, equal
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <chrono>                         // for steady_clock
+#include <cmath>                          // for sqrt
+#include <cstdint>                        // for int64_t, uint32_t, uint64_t
+#include <cstdlib>                        // for exit
+#include <filesystem>                     // for last_write_time, rename, remove
+#include <fstream>                        // for ifstream, ofstream
+#include <functional>                     // for hash
+#include <iostream>                       // for cerr
+#include <limits>                         // for numeric_limits
+#include <netlistx/binary_io.hpp>         // for read_le, write_le, read_le_vector
+#include <netlistx/hash.hpp>              // for hash_combine, hash_mix, hash_sequence
+#include <netlistx/mapped_file.hpp>       // for MappedFile
+#include <netlistx/netd_index.hpp>        // for NetDIndex
+#include <netlistx/netlist_builder.hpp>   // for NetlistBuilder
+#include <netlistx/parallel.hpp>          // for parallel_blocks, num_blocks_for
+#include <random>                         // for mt19937_64, uniform_int_distribution
+#include <string>                         // for string, to_string
+#include <system_error>                   // for error_code
+#include <thread>                         // for this_thread
+#include <utility>                        // for pair
+#include <vector>                         // for vector
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char index_magic[8] = {'N', 'X', 'N', 'D', 'I', 'X', '2', '\n'};
+    constexpr size_t hash_block_size = 4096;
+    constexpr size_t num_hash_blocks = 16;
+
+    /**
+     * @brief Hashes the first block of a file, which holds the header, and `num_hash_blocks`
+     *        more blocks spread evenly up to its end.
+     */
+    auto sampled_hash(const char *data, std::uint64_t size) -> std::uint64_t {
+        auto hash = hash_mix(size);
+        const auto span = size > hash_block_size ? size - hash_block_size : 0U;
+        for (size_t k = 0; k <= num_hash_blocks; ++k) {
+            const auto offset = span * k / num_hash_blocks;
+            const auto length = std::min<std::uint64_t>(hash_block_size, size - offset);
+            hash = hash_sequence(data + offset, data + offset + length, hash);
+        }
+        return hash;
+    }
+
+    auto last_write_ticks(boost::string_view fileName, std::int64_t &ticks) -> bool {
+        auto ec = std::error_code{};
+        const auto time = fs::last_write_time(fileName.to_string(), ec);
+        ticks = static_cast<std::int64_t>(time.time_since_epoch().count());
+        return !ec;
+    }
+
+    auto is_space(char c) -> bool {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    auto parse_uint(const char *&p, const char *end, std::uint32_t &value) -> bool {
+        while (p != end && is_space(*p)) {
+            ++p;
+        }
+        if (p == end || *p < '0' || *p > '9') {
+            return false;
+        }
+        auto result = std::uint64_t{0};
+        for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+            result = result * 10U + std::uint64_t(*p - '0');
+        }
+        value = static_cast<std::uint32_t>(result);
+        return true;
+    }
+
+    /// Parses the header counts; on return `p` points to the end of the header line.
+    auto parse_header(const char *&p, const char *end, std::uint32_t &num_pins,
+                      std::uint32_t &num_nets, std::uint32_t &num_modules,
+                      std::uint32_t &pad_offset) -> bool {
+        auto t = std::uint32_t{0};
+        if (!parse_uint(p, end, t) || !parse_uint(p, end, num_pins)
+            || !parse_uint(p, end, num_nets) || !parse_uint(p, end, num_modules)
+            || !parse_uint(p, end, pad_offset)) {
+            return false;
+        }
+        while (p != end && *p != '\n') {
+            ++p;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Parses one pin line, e.g. "a12 s 1" or "p3 l".
+     *
+     * On return `p` points past the end of the line. `start` is the offset of the first
+     * character of the line (leading blank lines are skipped).
+     *
+     * @return 1 if a pin was parsed, 0 at the end of the range, -1 on a syntax error.
+     */
+    auto parse_pin(const char *&p, const char *end, std::uint32_t pad_offset, const char *&start,
+                   index_t &module, bool &starts_net) -> int {
+        while (p != end && is_space(*p)) {
+            ++p;
+        }
+        if (p == end) {
+            return 0;
+        }
+        start = p;
+        const auto kind = *p++;
+        auto id = std::uint32_t{0};
+        if ((kind != 'a' && kind != 'p') || !parse_uint(p, end, id)) {
+            return -1;
+        }
+        module = kind == 'a' ? id : id + pad_offset;
+        while (p != end && (*p == ' ' || *p == '\t')) {
+            ++p;
+        }
+        starts_net = p != end && *p == 's';
+        while (p != end && *p != '\n') {
+            ++p;
+        }
+        return 1;
+    }
+
+    auto read_file(boost::string_view fileName, std::string &content) -> bool {
+        auto in = std::ifstream{fileName.data(), std::ios::binary};
+        if (in.fail()) {
+            return false;
+        }
+        in.seekg(0, std::ios::end);
+        content.resize(static_cast<size_t>(in.tellg()));
+        in.seekg(0, std::ios::beg);
+        return content.empty()
+               || static_cast<bool>(
+                   in.read(&content[0], static_cast<std::streamsize>(content.size())));
+    }
+
+    /// Pins and net starts of one chunk of the pin section
+    struct Chunk {
+        std::vector<std::uint64_t> net_offsets;
+        std::vector<std::pair<index_t, index_t>> net_ranges;  // (min, max) module of every net
+        std::pair<index_t, index_t> lead_range{~index_t{0}, 0U};  // pins before the first net
+        size_t num_lead_pins{};
+        size_t num_pins{};
+        bool ok = true;
+    };
+
+    void extend(std::pair<index_t, index_t> &range, index_t module) {
+        range.first = std::min(range.first, module);
+        range.second = std::max(range.second, module);
+    }
+}  // namespace
+
+auto NetDIndex::nets_touching(index_t first, index_t last) const
+    -> std::vector<std::pair<index_t, index_t>> {
+    auto result = std::vector<std::pair<index_t, index_t>>{};
+    for (size_t g = 0; g != this->module_ranges.size(); ++g) {
+        const auto &range = this->module_ranges[g];
+        if (range.first > last || range.second < first) {
+            continue;
+        }
+        const auto begin = index_t(g * group_size);
+        const auto end = index_t(std::min<size_t>((g + 1) * group_size, this->num_nets));
+        if (!result.empty() && result.back().second == begin) {
+            result.back().second = end;
+        } else {
+            result.emplace_back(begin, end);
+        }
+    }
+    return result;
+}
+
+auto buildNetDIndex(boost::string_view netDFileName, NetDIndex &index) -> bool {
+    index = NetDIndex{};
+    // The time comes first, so an edit made while the file is read makes the index stale
+    auto content = std::string{};
+    if (!last_write_ticks(netDFileName, index.file_mtime) || !read_file(netDFileName, content)) {
+        return false;
+    }
+    const auto *data = content.data();
+    const auto *end = data + content.size();
+    const auto *p = data;
+    index.file_size = content.size();
+    index.content_hash = sampled_hash(data, content.size());
+    if (!parse_header(p, end, index.num_pins, index.num_nets, index.num_modules,
+                      index.pad_offset)) {
+        return false;
+    }
+    const auto section = static_cast<size_t>(p - data);
+    const auto len = content.size() - section;
+
+    // Scan the chunks in parallel; every chunk starts at a line boundary
+    const auto num_chunks = num_blocks_for(len, size_t{1} << 20U);
+    auto chunks = std::vector<Chunk>(num_chunks);
+    auto align = [&](size_t pos) {
+        while (pos < content.size() && pos > section && data[pos - 1] != '\n') {
+            ++pos;
+        }
+        return pos;
+    };
+    parallel_blocks(0U, len, num_chunks, [&](size_t b, size_t lo, size_t hi) {
+        auto &chunk = chunks[b];
+        const auto *q = data + align(section + lo);
+        const auto *stop = data + align(section + hi);
+        const char *start = nullptr;
+        auto module = index_t{0};
+        auto starts_net = false;
+        while (true) {
+            const auto status = parse_pin(q, stop, index.pad_offset, start, module, starts_net);
+            if (status <= 0) {
+                chunk.ok = status == 0;
+                break;
+            }
+            ++chunk.num_pins;
+            if (starts_net) {
+                chunk.net_offsets.push_back(std::uint64_t(start - data));
+                chunk.net_ranges.emplace_back(module, module);
+            } else if (chunk.net_ranges.empty()) {
+                ++chunk.num_lead_pins;
+                extend(chunk.lead_range, module);
+            } else {
+                extend(chunk.net_ranges.back(), module);
+            }
+        }
+    });
+
+    // Merge the chunks
+    auto net_ranges = std::vector<std::pair<index_t, index_t>>{};
+    auto num_pins = size_t{0};
+    for (const auto &chunk : chunks) {
+        if (!chunk.ok) {
+            return false;
+        }
+        if (chunk.num_lead_pins != 0) {
+            if (net_ranges.empty()) {
+                return false;  // pins before the first net
+            }
+            extend(net_ranges.back(), chunk.lead_range.first);
+            extend(net_ranges.back(), chunk.lead_range.second);
+        }
+        index.net_offsets.insert(index.net_offsets.end(), chunk.net_offsets.begin(),
+                                 chunk.net_offsets.end());
+        net_ranges.insert(net_ranges.end(), chunk.net_ranges.begin(), chunk.net_ranges.end());
+        num_pins += chunk.num_pins;
+    }
+    if (num_pins != index.num_pins || index.net_offsets.size() > index.num_nets) {
+        return false;
+    }
+    index.num_nets = std::uint32_t(index.net_offsets.size());  // as readNetD, accept fewer nets
+    index.net_offsets.push_back(content.size());
+
+    const auto num_groups = (net_ranges.size() + NetDIndex::group_size - 1) / NetDIndex::group_size;
+    index.module_ranges.assign(num_groups, {~index_t{0}, 0U});
+    for (size_t net = 0; net != net_ranges.size(); ++net) {
+        auto &range = index.module_ranges[net / NetDIndex::group_size];
+        extend(range, net_ranges[net].first);
+        extend(range, net_ranges[net].second);
+    }
+    return true;
+}
+
+auto writeNetDIndex(boost::string_view idxFileName, const NetDIndex &index) -> bool {
+    auto ec = std::error_code{};
+    const auto path = idxFileName.to_string();
+    const auto tag = hash_combine(std::hash<std::thread::id>{}(std::this_thread::get_id()),
+                                  static_cast<std::uint64_t>(
+                                      std::chrono::steady_clock::now().time_since_epoch().count()));
+    const auto tmp_path = path + ".tmp" + std::to_string(tag);
+    {
+        auto out = std::ofstream{tmp_path, std::ios::binary | std::ios::trunc};
+        if (out.fail()) {
+            return false;
+        }
+        out.write(index_magic, 8);
+        write_le(out, index.file_size);
+        write_le(out, index.file_mtime);
+        write_le(out, index.content_hash);
+        write_le(out, index.num_pins);
+        write_le(out, index.num_nets);
+        write_le(out, index.num_modules);
+        write_le(out, index.pad_offset);
+        write_le_vector(out, index.net_offsets);
+        write_le(out, std::uint64_t(index.module_ranges.size()));
+        for (const auto &range : index.module_ranges) {
+            write_le(out, range.first);
+            write_le(out, range.second);
+        }
+        if (!out.flush()) {
+            out.close();
+            fs::remove(tmp_path, ec);
+            return false;
+        }
+    }
+    fs::rename(tmp_path, path, ec);
+    if (ec) {
+        fs::remove(tmp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+auto readNetDIndex(boost::string_view idxFileName, NetDIndex &index) -> bool {
+    auto in = std::ifstream{idxFileName.data(), std::ios::binary};
+    if (in.fail()) {
+        return false;
+    }
+    char magic[8];
+    if (!in.read(magic, 8) || !std::equal(magic, magic + 8, index_magic)) {
+        return false;
+    }
+    index = NetDIndex{};
+    if (!read_le(in, index.file_size) || !read_le(in, index.file_mtime)
+        || !read_le(in, index.content_hash) || !read_le(in, index.num_pins)
+        || !read_le(in, index.num_nets) || !read_le(in, index.num_modules)
+        || !read_le(in, index.pad_offset)
+        || !read_le_vector(in, index.net_offsets, std::uint64_t(index.num_nets) + 1U)
+        || index.net_offsets.size() != std::uint64_t(index.num_nets) + 1U) {
+        return false;
+    }
+    auto num_groups = std::uint64_t{0};
+    if (!read_le(in, num_groups)
+        || num_groups != (index.num_nets + NetDIndex::group_size - 1) / NetDIndex::group_size) {
+        return false;
+    }
+    index.module_ranges.resize(num_groups);
+    for (auto &range : index.module_ranges) {
+        if (!read_le(in, range.first) || !read_le(in, range.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto loadNetDIndex(boost::string_view netDFileName, NetDIndex &index) -> bool {
+    const auto idxFileName = netDFileName.to_string() + ".idx";
+    auto mtime = std::int64_t{0};
+    auto file = MappedFile{};
+    if (readNetDIndex(idxFileName, index) && last_write_ticks(netDFileName, mtime)
+        && index.file_mtime == mtime && file.open(netDFileName)
+        && index.file_size == file.size()
+        && index.content_hash
+               == sampled_hash(reinterpret_cast<const char *>(file.data()), file.size())) {
+        return true;
+    }
+    if (!buildNetDIndex(netDFileName, index)) {
+        return false;
+    }
+    writeNetDIndex(idxFileName, index);  // a read-only directory only costs a rebuild
+    return true;
+}
+
+auto readNetDNets(boost::string_view netDFileName, const NetDIndex &index, index_t first,
+                  index_t last) -> SimpleNetlist {
+    auto in = std::ifstream{netDFileName.data(), std::ios::binary};
+    if (in.fail()) {
+        std::cerr << "Error: Can't open file " << netDFileName << ".\n";
+        exit(1);
+    }
+    in.seekg(0, std::ios::end);
+    if (std::uint64_t(in.tellg()) != index.file_size || first > last || last > index.num_nets) {
+        std::cerr << "Error: index does not match " << netDFileName << ".\n";
+        exit(1);
+    }
+    const auto base = index.net_offsets[first];
+    auto content = std::string(index.net_offsets[last] - base, '\0');
+    in.seekg(static_cast<std::streamoff>(base), std::ios::beg);
+    if (!content.empty()
+        && !in.read(&content[0], static_cast<std::streamsize>(content.size()))) {
+        std::cerr << "Error: Can't read " << netDFileName << ".\n";
+        exit(1);
+    }
+
+    // Parse groups of nets in parallel, splitting at the net offsets
+    const auto num_nets = size_t(last - first);
+    const auto num_blocks = num_blocks_for(num_nets, 1024U);
+    auto pins = std::vector<std::vector<std::pair<index_t, index_t>>>(num_blocks);
+    auto ok = std::vector<std::uint8_t>(num_blocks, 1U);
+    parallel_blocks(0U, num_nets, num_blocks, [&](size_t b, size_t lo, size_t hi) {
+        const auto *p = content.data() + (index.net_offsets[first + lo] - base);
+        const auto *stop = content.data() + (index.net_offsets[first + hi] - base);
+        const char *start = nullptr;
+        auto module = index_t{0};
+        auto starts_net = false;
+        auto net = index_t(lo) - 1U;
+        int status = 0;
+        while ((status = parse_pin(p, stop, index.pad_offset, start, module, starts_net)) > 0) {
+            net += starts_net ? 1U : 0U;
+            pins[b].emplace_back(module, net);
+        }
+        ok[b] = status == 0 && net + 1U == hi ? 1U : 0U;
+    });
+
+    auto builder = NetlistBuilder{index.num_modules, std::uint32_t(num_nets)};
+    for (size_t b = 0; b != num_blocks; ++b) {
+        if (ok[b] == 0U) {
+            std::cerr << "Error: index does not match " << netDFileName << ".\n";
+            exit(1);
+        }
+        for (const auto &pin : pins[b]) {
+            builder.add_pin(pin.first, pin.second);
+        }
+    }
+    if (!builder.validate().ok()) {
+        std::cerr << "Error: invalid netlist (" << builder.report().to_string() << ").\n";
+        exit(1);
+    }
+    auto hyprgraph = builder.build();
+    hyprgraph.num_pads = index.num_modules - index.pad_offset - 1;
+    return hyprgraph;
+}
+
+namespace {
+    /// Totals of one sampled window
+    struct Window {
+        double num_nets{};
+        double num_pins{};
+        double num_bytes{};
+    };
+
+    /**
+     * @brief Ratio estimate sum(y) / sum(x) over the windows and its standard error.
+     *
+     * The windows are clusters of nets, so the standard error uses the between-window variance
+     * of the linearized ratio.
+     */
+    template <typename Y, typename X>
+    auto ratio_estimate(const std::vector<Window> &windows, Y y, X x) -> std::pair<double, double> {
+        auto sum_y = 0.0;
+        auto sum_x = 0.0;
+        for (const auto &w : windows) {
+            sum_y += y(w);
+            sum_x += x(w);
+        }
+        const auto n = double(windows.size());
+        if (sum_x == 0.0) {
+            return {0.0, 0.0};
+        }
+        const auto ratio = sum_y / sum_x;
+        if (windows.size() < 2) {
+            return {ratio, 0.0};
+        }
+        auto ss = 0.0;
+        for (const auto &w : windows) {
+            const auto residual = y(w) - ratio * x(w);
+            ss += residual * residual;
+        }
+        return {ratio, std::sqrt(ss / (n * (n - 1.0))) / (sum_x / n)};
+    }
+}  // namespace
+
+auto probe(boost::string_view netDFileName, size_t num_windows, size_t window_size,
+           std::uint64_t seed) -> NetDProbe {
+    auto file = MappedFile{};
+    if (!file.open(netDFileName)) {
+        std::cerr << "Error: Can't open file " << netDFileName << ".\n";
+        exit(1);
+    }
+    const auto *data = reinterpret_cast<const char *>(file.data());
+    auto result = NetDProbe{};
+    result.file_size = file.size();
+    const auto *p = data;
+    if (!parse_header(p, data + std::min<std::uint64_t>(result.file_size, 4096U),
+                      result.num_pins, result.num_nets, result.num_modules, result.pad_offset)) {
+        std::cerr << "Error: invalid header in " << netDFileName << ".\n";
+        exit(1);
+    }
+    const auto section = std::uint64_t(p - data);
+    const auto len = result.file_size - section;
+
+    // Window offsets: the whole pin section if it is small enough, else random windows
+    auto offsets = std::vector<std::uint64_t>{};
+    if (len <= std::uint64_t(num_windows) * window_size) {
+        result.exact = true;
+        offsets.push_back(section);
+        window_size = static_cast<size_t>(len);
+    } else {
+        auto gen = std::mt19937_64{seed};
+        const auto last_offset = result.file_size - window_size;
+        auto dist = std::uniform_int_distribution<std::uint64_t>{section, last_offset};
+        for (size_t i = 0; i != num_windows; ++i) {
+            offsets.push_back(dist(gen));
+        }
+    }
+
+    constexpr size_t max_bucket = 64;
+    auto histogram = std::vector<double>(max_bucket + 1, 0.0);
+    auto windows = std::vector<Window>{};
+    for (const auto offset : offsets) {
+        const auto at_end = offset + window_size >= result.file_size;
+        const auto *q = data + offset;
+        const auto *stop = data + std::min<std::uint64_t>(offset + window_size, result.file_size);
+        if (offset != section) {  // skip the partial first line
+            while (q != stop && *q != '\n') {
+                ++q;
+            }
+        }
+        if (!at_end) {  // drop the partial last line
+            while (stop != q && *(stop - 1) != '\n') {
+                --stop;
+            }
+        }
+        auto window = Window{};
+        const char *start = nullptr;
+        const char *net_start = nullptr;
+        auto module = index_t{0};
+        auto starts_net = false;
+        auto pins = size_t{0};
+        auto close_net = [&](const char *net_end) {
+            if (net_start != nullptr) {
+                window.num_nets += 1.0;
+                window.num_pins += double(pins);
+                window.num_bytes += double(net_end - net_start);
+                histogram[std::min(pins, max_bucket)] += 1.0;
+            }
+        };
+        while (parse_pin(q, stop, result.pad_offset, start, module, starts_net) > 0) {
+            if (starts_net) {
+                close_net(start);
+                net_start = start;
+                pins = 0;
+            }
+            ++pins;
+        }
+        if (at_end) {
+            close_net(q);
+        }
+        result.num_sampled_nets += size_t(window.num_nets);
+        result.num_sampled_pins += size_t(window.num_pins);
+        windows.push_back(window);
+    }
+    result.num_windows = windows.size();
+
+    // Estimates with ~95% confidence bounds
+    constexpr auto z = 1.96;
+    const auto degree = ratio_estimate(
+        windows, [](const Window &w) { return w.num_pins; },
+        [](const Window &w) { return w.num_nets; });
+    result.mean_net_degree = degree.first;
+    result.mean_net_degree_low = std::max(1.0, degree.first - z * degree.second);
+    result.mean_net_degree_high = degree.first + z * degree.second;
+    const auto bytes = ratio_estimate(
+        windows, [](const Window &w) { return w.num_bytes; },
+        [](const Window &w) { return w.num_pins; });
+    if (bytes.first > 0.0) {
+        const auto num_bytes = double(len);
+        result.estimated_pins = num_bytes / bytes.first;
+        result.estimated_pins_low = num_bytes / (bytes.first + z * bytes.second);
+        result.estimated_pins_high = bytes.first > z * bytes.second
+                                         ? num_bytes / (bytes.first - z * bytes.second)
+                                         : std::numeric_limits<double>::infinity();
+    }
+    if (result.num_sampled_nets != 0) {
+        for (auto &h : histogram) {
+            h /= double(result.num_sampled_nets);
+        }
+        result.degree_distribution = std::move(histogram);
+    }
+    return result;
+}
@@ -0,0 +1,133 @@
+#include <algorithm>                     // for lower_bound
+#include <atomic>                        // for atomic
+#include <cstddef>                       // for size_t
+#include <cstdint>                       // for uint8_t, uint64_t
+#include <netlistx/netlist_builder.hpp>  // for NetlistBuilder, ValidationReport
+#include <netlistx/parallel.hpp>         // for parallel_blocks, parallel_for, num_blocks_for
+#include <netlistx/radix_sort.hpp>       // for radix_sort
+#include <sstream>                       // for ostringstream
+#include <string>                        // for string
+#include <utility>                       // for move
+#include <vector>                        // for vector
+
+auto ValidationReport::to_string() const -> std::string {
+    auto out = std::ostringstream{};
+    out << "pins: " << this->num_pins << ", duplicate pins: " << this->num_duplicate_pins
+        << ", out-of-range pins: " << this->num_out_of_range_pins
+        << ", empty nets: " << this->empty_nets.size()
+        << ", isolated modules: " << this->isolated_modules.size();
+    return out.str();
+}
+
+auto NetlistBuilder::validate() -> const ValidationReport & {
+    const auto num_pins = this->_pins.size();
+    const auto num_nets = size_t(this->_num_nets);
+    const auto num_modules = size_t(this->_num_modules);
+    auto report = ValidationReport{};
+    report.num_pins = num_pins;
+
+    // Composite (net, module) keys of the valid pins, compacted in input order
+    const auto num_blocks = num_blocks_for(num_pins, 65536U);
+    auto num_valid = std::vector<size_t>(num_blocks + 1, 0U);
+    auto is_valid = [&](const std::pair<index_t, index_t> &pin) {
+        return pin.first < num_modules && pin.second < num_nets;
+    };
+    parallel_blocks(0U, num_pins, num_blocks, [&](size_t b, size_t lo, size_t hi) {
+        for (auto i = lo; i != hi; ++i) {
+            num_valid[b + 1] += is_valid(this->_pins[i]) ? 1U : 0U;
+        }
+    });
+    for (size_t b = 0; b != num_blocks; ++b) {
+        num_valid[b + 1] += num_valid[b];
+    }
+    auto keys = std::vector<std::uint64_t>(num_valid[num_blocks]);
+    parallel_blocks(0U, num_pins, num_blocks, [&](size_t b, size_t lo, size_t hi) {
+        auto pos = num_valid[b];
+        for (auto i = lo; i != hi; ++i) {
+            const auto &pin = this->_pins[i];
+            if (is_valid(pin)) {
+                keys[pos++] = std::uint64_t(pin.second) * num_modules + pin.first;
+            }
+        }
+    });
+    report.num_out_of_range_pins = num_pins - keys.size();
+
+    // Sort, then keep the first key of every run of equal keys
+    radix_sort(keys);
+    const auto num_keys = keys.size();
+    const auto num_key_blocks = num_blocks_for(num_keys, 65536U);
+    auto num_distinct = std::vector<size_t>(num_key_blocks + 1, 0U);
+    auto is_first = [&](size_t i) { return i == 0 || keys[i] != keys[i - 1]; };
+    parallel_blocks(0U, num_keys, num_key_blocks, [&](size_t b, size_t lo, size_t hi) {
+        for (auto i = lo; i != hi; ++i) {
+            num_distinct[b + 1] += is_first(i) ? 1U : 0U;
+        }
+    });
+    for (size_t b = 0; b != num_key_blocks; ++b) {
+        num_distinct[b + 1] += num_distinct[b];
+    }
+    auto distinct = std::vector<std::uint64_t>(num_distinct[num_key_blocks]);
+    parallel_blocks(0U, num_keys, num_key_blocks, [&](size_t b, size_t lo, size_t hi) {
+        auto pos = num_distinct[b];
+        for (auto i = lo; i != hi; ++i) {
+            if (is_first(i)) {
+                distinct[pos++] = keys[i];
+            }
+        }
+    });
+    std::vector<std::uint64_t>().swap(keys);
+    report.num_duplicate_pins = num_keys - distinct.size();
+
+    // Rows of the nets; mark the modules that have pins
+    auto &csr = this->_net_pins;
+    csr.offsets.assign(num_nets + 1, 0U);
+    csr.targets.resize(distinct.size());
+    auto has_pin = std::vector<std::atomic<std::uint8_t>>(num_modules);
+    parallel_for(0U, num_modules, [&](size_t lo, size_t hi) {
+        for (auto v = lo; v != hi; ++v) {
+            has_pin[v].store(0U, std::memory_order_relaxed);
+        }
+    });
+    parallel_for(0U, num_nets, [&](size_t lo, size_t hi) {
+        for (auto net = lo; net != hi; ++net) {
+            const auto first = std::uint64_t(net + 1) * num_modules;
+            csr.offsets[net + 1] = static_cast<size_t>(
+                std::lower_bound(distinct.begin(), distinct.end(), first) - distinct.begin());
+        }
+    });
+    parallel_for(0U, distinct.size(), [&](size_t lo, size_t hi) {
+        for (auto i = lo; i != hi; ++i) {
+            const auto v = index_t(distinct[i] % num_modules);
+            csr.targets[i] = v;
+            has_pin[v].store(1U, std::memory_order_relaxed);
+        }
+    });
+    for (size_t net = 0; net != num_nets; ++net) {
+        if (csr.offsets[net] == csr.offsets[net + 1]) {
+            report.empty_nets.push_back(index_t(net));
+        }
+    }
+    for (size_t v = 0; v != num_modules; ++v) {
+        if (has_pin[v].load(std::memory_order_relaxed) == 0U) {
+            report.isolated_modules.push_back(index_t(v));
+        }
+    }
+
+    this->_report = std::move(report);
+    this->_validated = true;
+    return this->_report;
+}
+
+auto NetlistBuilder::build() -> SimpleNetlist {
+    if (!this->_validated) {
+        this->validate();
+    }
+    const auto num_modules = this->_num_modules;
+    auto g = graph_t(num_modules + this->_num_nets);
+    for (size_t net = 0; net != this->_net_pins.size(); ++net) {
+        for (const auto v : this->_net_pins[net]) {
+            g.add_edge(v, num_modules + index_t(net));
+        }
+    }
+    return SimpleNetlist{std::move(g), num_modules, this->_num_nets};
+}
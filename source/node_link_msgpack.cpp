@@ -0,0 +1,433 @@
+#include <cstdint>                         // for uint8_t, uint32_t, uint64_t
+#include <cstdlib>                         // for exit
+#include <fstream>                         // for ofstream
+#include <iostream>                        // for cerr
+#include <netlistx/mapped_file.hpp>        // for MappedFile
+#include <netlistx/netlist.hpp>            // for SimpleNetlist
+#include <netlistx/netlist_builder.hpp>    // for NetlistBuilder
+#include <netlistx/node_link_msgpack.hpp>  // for encodeMsgPack, decodeMsgPack
+#include <optional>                        // for optional, nullopt
+#include <utility>                         // for move
+#include <vector>                          // for vector
+
+using namespace std;
+
+namespace {
+    // Appends MessagePack items (https://github.com/msgpack/msgpack/blob/master/spec.md)
+    class MsgPackWriter {
+        vector<uint8_t> &_out;
+
+        void _put_be(uint64_t value, unsigned num_bytes) {
+            for (auto i = num_bytes; i-- != 0;) {
+                this->_out.push_back(static_cast<uint8_t>(value >> (8U * i)));
+            }
+        }
+
+        void _put_header(size_t n, uint8_t fix, uint8_t fix_limit, uint8_t code16) {
+            if (n < fix_limit) {
+                this->_out.push_back(static_cast<uint8_t>(fix | n));
+            } else if (n <= 0xffffU) {
+                this->_out.push_back(code16);
+                this->_put_be(n, 2);
+            } else {
+                this->_out.push_back(static_cast<uint8_t>(code16 + 1));  // 32-bit length
+                this->_put_be(n, 4);
+            }
+        }
+
+      public:
+        explicit MsgPackWriter(vector<uint8_t> &out) : _out{out} {}
+
+        void put_uint(uint64_t value) {
+            if (value < 0x80U) {
+                this->_out.push_back(static_cast<uint8_t>(value));
+            } else if (value <= 0xffU) {
+                this->_out.push_back(0xcc);
+                this->_put_be(value, 1);
+            } else if (value <= 0xffffU) {
+                this->_out.push_back(0xcd);
+                this->_put_be(value, 2);
+            } else if (value <= 0xffffffffU) {
+                this->_out.push_back(0xce);
+                this->_put_be(value, 4);
+            } else {
+                this->_out.push_back(0xcf);
+                this->_put_be(value, 8);
+            }
+        }
+
+        void put_bool(bool value) { this->_out.push_back(value ? 0xc3 : 0xc2); }
+
+        void put_str(boost::string_view str) {
+            if (str.size() < 32U) {
+                this->_out.push_back(static_cast<uint8_t>(0xa0U | str.size()));
+            } else if (str.size() <= 0xffU) {
+                this->_out.push_back(0xd9);
+                this->_put_be(str.size(), 1);
+            } else {
+                this->_put_header(str.size(), 0xa0, 0, 0xda);
+            }
+            this->_out.insert(this->_out.end(), str.begin(), str.end());
+        }
+
+        void put_array(size_t n) { this->_put_header(n, 0x90, 16, 0xdc); }
+
+        void put_map(size_t n) { this->_put_header(n, 0x80, 16, 0xde); }
+    };
+
+    // Reads MessagePack items; any malformed or truncated item makes the reads fail
+    class MsgPackReader {
+        const unsigned char *_pos;
+        const unsigned char *_end;
+
+        auto _take(size_t n) -> const unsigned char * {
+            if (static_cast<size_t>(this->_end - this->_pos) < n) {
+                return nullptr;
+            }
+            const auto *first = this->_pos;
+            this->_pos += n;
+            return first;
+        }
+
+        auto _get_be(unsigned num_bytes, uint64_t &value) -> bool {
+            const auto *bytes = this->_take(num_bytes);
+            if (bytes == nullptr) {
+                return false;
+            }
+            value = 0U;
+            for (auto i = 0U; i != num_bytes; ++i) {
+                value = value << 8U | bytes[i];
+            }
+            return true;
+        }
+
+        // Length of a container or string with the given fix range and 8/16/32-bit codes
+        auto _get_length(uint8_t fix, uint8_t fix_mask, uint8_t code8, uint8_t code16,
+                         size_t &n) -> bool {
+            if (this->_pos == this->_end) {
+                return false;
+            }
+            const auto code = *this->_pos;
+            auto value = uint64_t{0};
+            if ((code & ~fix_mask) == fix) {
+                ++this->_pos;
+                value = code & fix_mask;
+            } else if (code8 != 0 && code == code8) {
+                ++this->_pos;
+                if (!this->_get_be(1, value)) {
+                    return false;
+                }
+            } else if (code == code16 || code == code16 + 1) {
+                ++this->_pos;
+                if (!this->_get_be(code == code16 ? 2U : 4U, value)) {
+                    return false;
+                }
+            } else {
+                return false;
+            }
+            n = static_cast<size_t>(value);
+            return true;
+        }
+
+      public:
+        MsgPackReader(const unsigned char *data, size_t size) : _pos{data}, _end{data + size} {}
+
+        auto remaining() const -> size_t { return static_cast<size_t>(this->_end - this->_pos); }
+
+        auto next_is_map() const -> bool {
+            if (this->_pos == this->_end) {
+                return false;
+            }
+            const auto code = *this->_pos;
+            return (code & 0xf0U) == 0x80U || code == 0xde || code == 0xdf;
+        }
+
+        auto read_uint(uint64_t &value) -> bool {
+            if (this->_pos == this->_end) {
+                return false;
+            }
+            const auto code = *this->_pos++;
+            if (code < 0x80U) {
+                value = code;
+                return true;
+            }
+            if (code >= 0xcc && code <= 0xcf) {
+                return this->_get_be(1U << (code - 0xccU), value);
+            }
+            if (code >= 0xd0 && code <= 0xd3) {  // signed encodings of non-negative values
+                const auto num_bytes = 1U << (code - 0xd0U);
+                return this->_get_be(num_bytes, value)
+                       && (value >> (8U * num_bytes - 1U) & 1U) == 0U;
+            }
+            return false;
+        }
+
+        auto read_str(boost::string_view &str) -> bool {
+            auto n = size_t{0};
+            if (!this->_get_length(0xa0, 0x1f, 0xd9, 0xda, n)) {
+                return false;
+            }
+            const auto *chars = this->_take(n);
+            str = boost::string_view(reinterpret_cast<const char *>(chars), n);
+            return chars != nullptr;
+        }
+
+        auto read_array(size_t &n) -> bool { return this->_get_length(0x90, 0x0f, 0, 0xdc, n); }
+
+        auto read_map(size_t &n) -> bool { return this->_get_length(0x80, 0x0f, 0, 0xde, n); }
+
+        /// Skips one item, including nested containers (iteratively, so nesting is unbounded).
+        auto skip() -> bool {
+            // payload sizes of float32/64, uint8..64 and int8..64 (0xca .. 0xd3)
+            static constexpr size_t scalar_sizes[] = {4, 8, 1, 2, 4, 8, 1, 2, 4, 8};
+            auto pending = uint64_t{1};
+            while (pending-- != 0) {
+                if (this->_pos == this->_end) {
+                    return false;
+                }
+                const auto code = *this->_pos;
+                auto n = size_t{0};
+                auto str = boost::string_view{};
+                auto length = uint64_t{0};
+                if (code < 0x80U || code >= 0xe0U || code == 0xc0 || code == 0xc2
+                    || code == 0xc3) {
+                    ++this->_pos;  // fixint, nil, bool
+                } else if ((code & 0xf0U) == 0x90U || code == 0xdc || code == 0xdd) {
+                    if (!this->read_array(n)) {
+                        return false;
+                    }
+                    pending += n;
+                } else if ((code & 0xf0U) == 0x80U || code == 0xde || code == 0xdf) {
+                    if (!this->read_map(n)) {
+                        return false;
+                    }
+                    pending += 2U * uint64_t{n};
+                } else if ((code & 0xe0U) == 0xa0U || (code >= 0xd9 && code <= 0xdb)) {
+                    if (!this->read_str(str)) {
+                        return false;
+                    }
+                } else if (code >= 0xc4 && code <= 0xc9) {  // bin, ext
+                    ++this->_pos;
+                    const auto is_ext = code >= 0xc7;
+                    if (!this->_get_be(1U << (code - (is_ext ? 0xc7U : 0xc4U)), length)
+                        || this->_take(length + (is_ext ? 1U : 0U)) == nullptr) {
+                        return false;
+                    }
+                } else if (code >= 0xca && code <= 0xd3) {  // float, uint, int
+                    ++this->_pos;
+                    if (this->_take(scalar_sizes[code - 0xca]) == nullptr) {
+                        return false;
+                    }
+                } else if (code >= 0xd4 && code <= 0xd8) {  // fixext
+                    ++this->_pos;
+                    if (this->_take(1U + (1U << (code - 0xd4U))) == nullptr) {
+                        return false;
+                    }
+                } else {
+                    return false;  // 0xc1 is never used
+                }
+            }
+            return true;
+        }
+    };
+
+    struct NodeLinkData {
+        uint64_t num_modules = ~uint64_t{0};
+        uint64_t num_nets = ~uint64_t{0};
+        uint64_t num_pads = 0U;
+        vector<uint64_t> sources;
+        vector<uint64_t> targets;
+    };
+
+    auto read_graph(MsgPackReader &in, NodeLinkData &data) -> bool {
+        auto num_keys = size_t{0};
+        if (!in.read_map(num_keys)) {
+            return false;
+        }
+        for (size_t i = 0; i != num_keys; ++i) {
+            auto key = boost::string_view{};
+            if (!in.read_str(key)) {
+                return false;
+            }
+            auto *value = key == "num_modules" ? &data.num_modules
+                          : key == "num_nets"  ? &data.num_nets
+                          : key == "num_pads"  ? &data.num_pads
+                                               : nullptr;
+            if (value == nullptr ? !in.skip() : !in.read_uint(*value)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    auto read_ids(MsgPackReader &in, vector<uint64_t> &ids) -> bool {
+        auto n = size_t{0};
+        if (!in.read_array(n) || n > in.remaining()) {
+            return false;
+        }
+        ids.resize(n);
+        for (auto &id : ids) {
+            if (!in.read_uint(id)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Packed links (a map of `source` and `target` arrays) or one map per link
+    auto read_links(MsgPackReader &in, NodeLinkData &data) -> bool {
+        auto n = size_t{0};
+        const auto packed = in.next_is_map();
+        if (packed ? !in.read_map(n) : (!in.read_array(n) || n > in.remaining())) {
+            return false;
+        }
+        if (!packed) {
+            data.sources.assign(n, ~uint64_t{0});
+            data.targets.assign(n, ~uint64_t{0});
+        }
+        for (size_t i = 0; i != n; ++i) {
+            auto num_keys = size_t{1};
+            if (!packed && !in.read_map(num_keys)) {
+                return false;
+            }
+            for (size_t j = 0; j != num_keys; ++j) {
+                auto key = boost::string_view{};
+                if (!in.read_str(key)) {
+                    return false;
+                }
+                auto ok = true;
+                if (key == "source") {
+                    ok = packed ? read_ids(in, data.sources) : in.read_uint(data.sources[i]);
+                } else if (key == "target") {
+                    ok = packed ? read_ids(in, data.targets) : in.read_uint(data.targets[i]);
+                } else {
+                    ok = in.skip();
+                }
+                if (!ok) {
+                    return false;
+                }
+            }
+        }
+        return data.sources.size() == data.targets.size();
+    }
+}  // namespace
+
+auto encodeMsgPack(const SimpleNetlist &hyprgraph) -> vector<uint8_t> {
+    auto num_links = size_t{0};
+    for (const auto &v : hyprgraph) {
+        num_links += hyprgraph.gr.degree(v);
+    }
+    auto bytes = vector<uint8_t>{};
+    bytes.reserve(128U + 3U * hyprgraph.number_of_nodes() + 6U * num_links);
+    auto out = MsgPackWriter{bytes};
+    out.put_map(5);
+    out.put_str("directed");
+    out.put_bool(false);
+    out.put_str("multigraph");
+    out.put_bool(false);
+
+    out.put_str("graph");
+    out.put_map(3);
+    out.put_str("num_modules");
+    out.put_uint(hyprgraph.number_of_modules());
+    out.put_str("num_nets");
+    out.put_uint(hyprgraph.number_of_nets());
+    out.put_str("num_pads");
+    out.put_uint(hyprgraph.num_pads);
+
+    out.put_str("nodes");
+    out.put_array(hyprgraph.number_of_nodes());
+    for (const auto &node : hyprgraph.gr) {
+        out.put_uint(node);
+    }
+
+    out.put_str("links");
+    out.put_map(2);
+    out.put_str("source");
+    out.put_array(num_links);
+    for (const auto &v : hyprgraph) {
+        for (auto i = hyprgraph.gr.degree(v); i != 0; --i) {
+            out.put_uint(v);
+        }
+    }
+    out.put_str("target");
+    out.put_array(num_links);
+    for (const auto &v : hyprgraph) {
+        for (const auto &net : hyprgraph.gr[v]) {
+            out.put_uint(net);
+        }
+    }
+    return bytes;
+}
+
+auto decodeMsgPack(const unsigned char *data, size_t size) -> optional<SimpleNetlist> {
+    auto in = MsgPackReader{data, size};
+    auto num_keys = size_t{0};
+    if (!in.read_map(num_keys)) {
+        return nullopt;
+    }
+    auto node_link = NodeLinkData{};
+    for (size_t i = 0; i != num_keys; ++i) {
+        auto key = boost::string_view{};
+        if (!in.read_str(key)) {
+            return nullopt;
+        }
+        // `nodes` is skipped: the node ids are implied by the sizes in `graph`
+        const auto ok = key == "graph"   ? read_graph(in, node_link)
+                        : key == "links" ? read_links(in, node_link)
+                                         : in.skip();
+        if (!ok) {
+            return nullopt;
+        }
+    }
+
+    const auto num_modules = node_link.num_modules;
+    const auto num_nets = node_link.num_nets;
+    if (num_modules > 0xffffffffU || num_nets > 0xffffffffU - num_modules
+        || node_link.num_pads > num_modules) {
+        return nullopt;
+    }
+    auto builder = NetlistBuilder{uint32_t(num_modules), uint32_t(num_nets)};
+    builder.reserve(node_link.sources.size());
+    for (size_t i = 0; i != node_link.sources.size(); ++i) {
+        auto module = node_link.sources[i];
+        auto net = node_link.targets[i];
+        if (module >= num_modules) {
+            swap(module, net);
+        }
+        if (module >= num_modules || net < num_modules || net - num_modules >= num_nets) {
+            return nullopt;
+        }
+        builder.add_pin(index_t(module), index_t(net - num_modules));
+    }
+    if (!builder.validate().ok()) {
+        return nullopt;
+    }
+    auto hyprgraph = builder.build();
+    hyprgraph.num_pads = node_link.num_pads;
+    return hyprgraph;
+}
+
+void writeMsgPack(boost::string_view msgpackFileName, const SimpleNetlist &hyprgraph) {
+    auto out = ofstream{msgpackFileName.data(), ios::binary | ios::trunc};
+    if (out.fail()) {
+        cerr << "Error: Can't open file " << msgpackFileName << ".\n";
+        exit(1);
+    }
+    const auto bytes = encodeMsgPack(hyprgraph);
+    out.write(reinterpret_cast<const char *>(bytes.data()), static_cast<streamsize>(bytes.size()));
+}
+
+auto readMsgPack(boost::string_view msgpackFileName) -> SimpleNetlist {
+    auto file = MappedFile{};
+    if (!file.open(msgpackFileName)) {
+        cerr << "Error: Can't open file " << msgpackFileName << ".\n";
+        exit(1);
+    }
+    auto hyprgraph = decodeMsgPack(file.data(), file.size());
+    if (!hyprgraph) {
+        cerr << "Error: invalid MessagePack node-link file " << msgpackFileName << ".\n";
+        exit(1);
+    }
+    return std::move(*hyprgraph);
+}
@@ -1,16 +1,20 @@
-#include <cctype>                      // for isspace, isdigit
-#include <cstdint>                     // for uint32_t
-#include <cstdlib>                     // for exit, size_t
-#include <fstream>                     // for operator<<, basic_ostream, cha...
-#include <iostream>                    // for cerr
-#include <netlistx/netlist.hpp>        // for SimpleNetlist, index_t, Netlist
-#include <py2cpp/range.hpp>            // for _iterator
-#include <py2cpp/set.hpp>              // for set
-#include <xnetwork/classes/graph.hpp>  // for Graph
+#include <algorithm>                     // for copy
+#include <cctype>                        // for isspace, isdigit
+#include <cstdint>                       // for uint32_t
+#include <cstdlib>                       // for exit, size_t
+#include <fstream>                       // for operator<<, basic_ostream, cha...
+#include <iostream>                      // for cerr
+#include <netlistx/netlist.hpp>          // for SimpleNetlist, index_t, Netlist
+#include <netlistx/netlist_builder.hpp>  // for NetlistBuilder
+#include <optional>                      // for optional, nullopt
+#include <py2cpp/range.hpp>              // for _iterator
+#include <py2cpp/set.hpp>                // for set
+#include <xnetwork/classes/graph.hpp>    // for Graph
 // #include <py2cpp/py2cpp.hpp>
 // #include <__config>      // for std
 // #include <__hash_table>  // for __hash_const_iterator, operator!=
 #include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <string>                         // for string, to_string
 #include <type_traits>                    // for move
 #include <vector>                         // for vector
 
@@ -67,20 +71,20 @@ void writeJSON(boost::string_view jsonFileName, const SimpleNetlist &hyprgraph)
 }
 
 /**
- * Reads an IBM .netD/.net format file and returns a SimpleNetlist representation.
+ * Reads an IBM .netD/.net format file, reporting malformed input instead of exiting.
  *
- * This function reads an IBM .netD/.net format file and constructs a SimpleNetlist
- * object from the data in the file. The SimpleNetlist contains information about
- * the modules, nets, and pins in the design.
+ * Warnings (fewer nets than the header says, duplicate pins) are written to `cerr` as by
+ * `readNetD`; errors leave the reason in `error`.
  *
  * @param netDFileName The path to the input .netD/.net file.
- * @return A SimpleNetlist object representing the design in the input file.
+ * @param error Receives the reason when no netlist is returned.
+ * @return The netlist, or nothing if the file can't be opened or is malformed.
  */
-auto readNetD(boost::string_view netDFileName) -> SimpleNetlist {
+auto tryReadNetD(boost::string_view netDFileName, string &error) -> optional<SimpleNetlist> {
     auto netD = ifstream{netDFileName.data()};
     if (netD.fail()) {
-        cerr << "Error: Can't open file " << netDFileName << ".\n";
-        exit(1);
+        error = "can't open file " + netDFileName.to_string();
+        return nullopt;
     }
 
     using node_t = uint32_t;
@@ -93,12 +97,13 @@ auto readNetD(boost::string_view netDFileName) -> SimpleNetlist {
 
     netD >> t;  // eat 1st 0
     netD >> numPins >> numNets >> numModules >> padOffset;
+    if (netD.fail()) {
+        error = "invalid header";
+        return nullopt;
+    }
 
-    // using Edge = pair<int, int>;
-
-    const auto num_vertices = numModules + numNets;
-    // const auto R = py::range<node_t>(0, num_vertices);
-    auto g = graph_t(num_vertices);
+    auto builder = NetlistBuilder{numModules, numNets};
+    builder.reserve(numPins);
 
     constexpr index_t bufferSize = 100;
     char lineBuffer[bufferSize];  // Does it work for other compiler?
@@ -109,41 +114,39 @@ auto readNetD(boost::string_view netDFileName) -> SimpleNetlist {
     char c = 0;
     uint32_t i = 0;
     for (; i < numPins; ++i) {
-        if (netD.eof()) {
+        // a failed stream leaves `c` unchanged, so every loop also checks the stream
+        do {
+            netD.get(c);
+        } while (netD && (isspace(c) != 0));
+        if (!netD) {
             cerr << "Warning: Unexpected end of file.\n";
             break;
         }
-        do {
-            netD.get(c);
-        } while ((isspace(c) != 0));
-        if (c == '\n') {
-            continue;
+        if (c != 'a' && c != 'p') {
+            error = "syntax error in pin " + to_string(i) + R"(: expect keyword "a" or "p")";
+            return nullopt;
+        }
+        netD >> w;
+        if (netD.fail()) {
+            error = "syntax error in pin " + to_string(i) + ": expect a module id";
+            return nullopt;
         }
-        if (c == 'a') {
-            netD >> w;
-        } else if (c == 'p') {
-            netD >> w;
+        if (c == 'p') {
             w += padOffset;
         }
         do {
             netD.get(c);
-        } while ((isspace(c) != 0));
-        if (c == 's') {
+        } while (netD && (isspace(c) != 0));
+        if (netD && c == 's') {
             ++e;
         }
 
-        // edge_array[i] = Edge(w, e);
-        g.add_edge(w, e);
+        builder.add_pin(w, e - numModules);
 
         do {
             netD.get(c);
-        } while ((isspace(c) != 0) && c != '\n');
-        // switch (c) {
-        // case 'O': aPin.setDirection(Pin::OUTPUT); break;
-        // case 'I': aPin.setDirection(Pin::INPUT); break;
-        // case 'B': aPin.setDirection(Pin::BIDIR); break;
-        // }
-        if (c != '\n') {
+        } while (netD && (isspace(c) != 0) && c != '\n');
+        if (netD && c != '\n') {
             netD.getline(lineBuffer, bufferSize);
         }
     }
@@ -152,36 +155,68 @@ auto readNetD(boost::string_view netDFileName) -> SimpleNetlist {
     if (e < numNets) {
         cerr << "Warning: number of nets is not " << numNets << ".\n";
         numNets = e;
+        builder.set_number_of_nets(numNets);
     } else if (e > numNets) {
-        cerr << "Error: number of nets is not " << numNets << ".\n";
-        exit(1);
+        error = "number of nets is not " + to_string(numNets);
+        return nullopt;
     }
     if (i < numPins) {
-        cerr << "Error: number of pins is not " << numPins << ".\n";
-        exit(1);
+        error = "number of pins is not " + to_string(numPins);
+        return nullopt;
     }
 
-    // using IndexMap =
-    //     typename boost::property_map<graph_t, boost::vertex_index_t>::type;
-    // auto index = boost::get(boost::vertex_index, g);
-    // auto gr = py::GraphAdaptor<graph_t>{std::move(g)};
-    auto hyprgraph = SimpleNetlist{std::move(g), numModules, numNets};
+    const auto &report = builder.validate();
+    if (!report.ok()) {
+        error = "invalid netlist (" + report.to_string() + ")";
+        return nullopt;
+    }
+    if (report.num_duplicate_pins != 0) {
+        cerr << "Warning: " << report.num_duplicate_pins << " duplicate pins removed.\n";
+    }
+    auto hyprgraph = builder.build();
     hyprgraph.num_pads = numModules - padOffset - 1;
     return hyprgraph;
 }
 
 /**
- * Reads an IBM .are format file and populates a SimpleNetlist object with the
- * module weights and other data.
+ * Reads an IBM .netD/.net format file and returns a SimpleNetlist representation.
+ *
+ * This function reads an IBM .netD/.net format file and constructs a SimpleNetlist
+ * object from the data in the file. The SimpleNetlist contains information about
+ * the modules, nets, and pins in the design. Malformed input ends the program (see
+ * `tryReadNetD` for a reader that reports it instead).
+ *
+ * @param netDFileName The path to the input .netD/.net file.
+ * @return A SimpleNetlist object representing the design in the input file.
+ */
+auto readNetD(boost::string_view netDFileName) -> SimpleNetlist {
+    auto error = string{};
+    auto hyprgraph = tryReadNetD(netDFileName, error);
+    if (!hyprgraph) {
+        cerr << "Error: " << error << ".\n";
+        exit(1);
+    }
+    return std::move(*hyprgraph);
+}
+
+/**
+ * Reads an IBM .are format file into the module weights of a SimpleNetlist, reporting
+ * malformed input instead of exiting.
+ *
+ * The weights change only if the whole file is valid. Storage that already holds one weight
+ * per module is overwritten in place, so views of it (e.g. the NumPy arrays of the Python
+ * bindings) stay valid.
  *
  * @param hyprgraph The SimpleNetlist object to populate with the .are file data.
  * @param areFileName The path to the .are format file to read.
+ * @param error Receives the reason when false is returned.
+ * @return true if the file could be read.
  */
-void readAre(SimpleNetlist &hyprgraph, boost::string_view areFileName) {
+auto tryReadAre(SimpleNetlist &hyprgraph, boost::string_view areFileName, string &error) -> bool {
     auto are = ifstream{areFileName.data()};
     if (are.fail()) {
-        cerr << " Could not open " << areFileName << endl;
-        exit(1);
+        error = "can't open file " + areFileName.to_string();
+        return false;
     }
 
     using node_t = uint32_t;
@@ -191,46 +226,72 @@ void readAre(SimpleNetlist &hyprgraph, boost::string_view areFileName) {
     char c = 0;
     node_t w = 0;
     unsigned int weight = 0;
-    // auto totalWeight = 0;
-    // xxx index_t smallestWeight = UINT_MAX;
     auto numModules = hyprgraph.number_of_modules();
     auto padOffset = numModules - hyprgraph.num_pads - 1;
     auto module_weight = vector<unsigned int>(numModules);
 
     size_t lineno = 1;
     for (size_t i = 0; i < numModules; i++) {
-        if (are.eof()) {
-            break;
-        }
         do {
             are.get(c);
-        } while ((isspace(c) != 0));
-        if (c == '\n') {
-            lineno++;
-            continue;
+        } while (are && (isspace(c) != 0));
+        if (!are) {
+            break;
         }
-        if (c == 'a') {
-            are >> w;
-        } else if (c == 'p') {
-            are >> w;
+        if (c != 'a' && c != 'p') {
+            error = "syntax error in line " + to_string(lineno) + R"(: expect keyword "a" or "p")";
+            return false;
+        }
+        are >> w;
+        if (are.fail()) {
+            error = "syntax error in line " + to_string(lineno) + ": expect a module id";
+            return false;
+        }
+        if (c == 'p') {
             w += node_t(padOffset);
-        } else {
-            cerr << "Syntax error in line " << lineno << ":"
-                 << R"(expect keyword "a" or "p")" << endl;
-            exit(0);
+        }
+        if (w >= numModules) {
+            error = "module id out of range in line " + to_string(lineno);
+            return false;
         }
 
         do {
             are.get(c);
-        } while ((isspace(c) != 0));
-        if (isdigit(c) != 0) {
+        } while (are && (isspace(c) != 0) && c != '\n');
+        if (are && (isdigit(c) != 0)) {
             are.putback(c);
             are >> weight;
+            if (are.fail()) {
+                error = "syntax error in line " + to_string(lineno) + ": expect a weight";
+                return false;
+            }
             module_weight[w] = weight;
         }
-        are.getline(lineBuffer, bufferSize);
+        if (are && c != '\n') {
+            are.getline(lineBuffer, bufferSize);
+        }
         lineno++;
     }
 
-    hyprgraph.module_weight = std::move(module_weight);
+    if (hyprgraph.module_weight.size() == numModules) {
+        copy(module_weight.begin(), module_weight.end(), hyprgraph.module_weight.begin());
+    } else {
+        hyprgraph.module_weight = std::move(module_weight);
+    }
+    return true;
+}
+
+/**
+ * Reads an IBM .are format file and populates a SimpleNetlist object with the
+ * module weights and other data. Malformed input ends the program (see `tryReadAre`).
+ *
+ * @param hyprgraph The SimpleNetlist object to populate with the .are file data.
+ * @param areFileName The path to the .are format file to read.
+ */
+void readAre(SimpleNetlist &hyprgraph, boost::string_view areFileName) {
+    auto error = string{};
+    if (!tryReadAre(hyprgraph, areFileName, error)) {
+        cerr << "Error: " << error << ".\n";
+        exit(1);
+    }
 }
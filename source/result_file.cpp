@@ -0,0 +1,192 @@
+#include <algorithm>                 // for copy, copy_n, equal, min
+#include <chrono>                    // for steady_clock
+#include <cstdint>                   // for uint8_t, uint32_t, uint64_t
+#include <cstring>                   // for memcpy
+#include <filesystem>                // for rename, remove
+#include <fstream>                   // for ofstream
+#include <functional>                // for hash
+#include <netlistx/binary_io.hpp>    // for load_le, store_le
+#include <netlistx/hash.hpp>         // for hash_combine
+#include <netlistx/result_file.hpp>  // for ResultFile, ResultMetadata, writeResult
+#include <string>                    // for string, to_string
+#include <system_error>              // for error_code
+#include <thread>                    // for this_thread
+#include <utility>                   // for move
+#include <vector>                    // for vector
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char result_magic[8] = {'N', 'X', 'R', 'E', 'S', '1', '\n', '\0'};
+    constexpr size_t header_size = 512;
+    constexpr size_t values_offset = 64;
+    constexpr size_t value_size = 32;  // 24-byte name + 8-byte IEEE double
+
+    // Field offsets in the header
+    constexpr size_t kind_offset = 8;
+    constexpr size_t bits_offset = 12;
+    constexpr size_t fingerprint_offset = 16;
+    constexpr size_t entries_offset = 32;
+    constexpr size_t parts_offset = 40;
+    constexpr size_t num_values_offset = 44;
+    constexpr size_t checksum_offset = 48;
+
+    auto payload_size(std::uint64_t num_entries, std::uint32_t entry_bits) -> std::uint64_t {
+        return (num_entries * entry_bits + 7U) / 8U;
+    }
+
+    auto checksum(const unsigned char *data, size_t size) -> std::uint64_t {
+        auto hash = hash_combine(0U, size);
+        auto i = size_t{0};
+        for (; i + 8U <= size; i += 8U) {
+            hash = hash_combine(hash, load_le<std::uint64_t>(data + i));
+        }
+        for (; i != size; ++i) {
+            hash = hash_combine(hash, data[i]);
+        }
+        return hash;
+    }
+
+    auto write_file(boost::string_view fileName, const ResultMetadata &metadata,
+                    std::uint32_t entry_bits, std::uint64_t num_entries,
+                    const std::vector<unsigned char> &payload) -> bool {
+        if (metadata.values.size() > ResultMetadata::max_values) {
+            return false;
+        }
+        auto header = std::vector<unsigned char>(header_size, 0U);
+        std::copy(result_magic, result_magic + 8, header.begin());
+        store_le(&header[kind_offset], static_cast<std::uint32_t>(metadata.kind));
+        store_le(&header[bits_offset], entry_bits);
+        store_le(&header[fingerprint_offset], metadata.netlist.hi);
+        store_le(&header[fingerprint_offset + 8U], metadata.netlist.lo);
+        store_le(&header[entries_offset], num_entries);
+        store_le(&header[parts_offset], metadata.num_parts);
+        store_le(&header[num_values_offset], std::uint32_t(metadata.values.size()));
+        store_le(&header[checksum_offset], checksum(payload.data(), payload.size()));
+        for (size_t i = 0; i != metadata.values.size(); ++i) {
+            auto *slot = &header[values_offset + i * value_size];
+            const auto &name = metadata.values[i].first;
+            std::copy_n(name.begin(), std::min(name.size(), ResultMetadata::max_name_size), slot);
+            auto bits = std::uint64_t{0};
+            std::memcpy(&bits, &metadata.values[i].second, sizeof(double));
+            store_le(slot + 24U, bits);
+        }
+
+        // Written aside and renamed over the target, so readers mapping the old file keep it
+        const auto path = fileName.to_string();
+        const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        const auto tag = hash_combine(std::hash<std::thread::id>{}(std::this_thread::get_id()),
+                                      static_cast<std::uint64_t>(now));
+        const auto tmp_path = path + ".tmp" + std::to_string(tag);
+        auto ec = std::error_code{};
+        {
+            auto out = std::ofstream{tmp_path, std::ios::binary | std::ios::trunc};
+            if (out.fail()) {
+                return false;
+            }
+            out.write(reinterpret_cast<const char *>(header.data()),
+                      static_cast<std::streamsize>(header.size()));
+            out.write(reinterpret_cast<const char *>(payload.data()),
+                      static_cast<std::streamsize>(payload.size()));
+            if (!out.flush()) {
+                out.close();
+                fs::remove(tmp_path, ec);
+                return false;
+            }
+        }
+        fs::rename(tmp_path, path, ec);
+        if (ec) {
+            fs::remove(tmp_path, ec);
+            return false;
+        }
+        return true;
+    }
+}  // namespace
+
+auto writeResult(boost::string_view fileName, const ResultMetadata &metadata,
+                 const std::vector<std::uint8_t> &entries) -> bool {
+    if (metadata.kind == ResultKind::partition) {
+        return write_file(fileName, metadata, 8U, entries.size(),
+                          std::vector<unsigned char>(entries.begin(), entries.end()));
+    }
+    if (metadata.kind != ResultKind::cover) {
+        return false;
+    }
+    auto payload = std::vector<unsigned char>(payload_size(entries.size(), 1U), 0U);
+    for (size_t v = 0; v != entries.size(); ++v) {
+        payload[v / 8U] = static_cast<unsigned char>(payload[v / 8U]
+                                                     | (entries[v] != 0U ? 1U : 0U) << (v % 8U));
+    }
+    return write_file(fileName, metadata, 1U, entries.size(), payload);
+}
+
+auto writeResult(boost::string_view fileName, const ResultMetadata &metadata,
+                 const std::vector<std::uint32_t> &entries) -> bool {
+    if (metadata.kind != ResultKind::cluster) {
+        return false;
+    }
+    auto payload = std::vector<unsigned char>(payload_size(entries.size(), 32U));
+    for (size_t v = 0; v != entries.size(); ++v) {
+        store_le(&payload[4U * v], entries[v]);
+    }
+    return write_file(fileName, metadata, 32U, entries.size(), payload);
+}
+
+auto ResultFile::open(boost::string_view fileName) -> bool {
+    this->_payload = nullptr;
+    if (!this->_file.open(fileName) || this->_file.size() < header_size) {
+        return false;
+    }
+    const auto *header = this->_file.data();
+    if (!std::equal(result_magic, result_magic + 8, reinterpret_cast<const char *>(header))) {
+        return false;
+    }
+    auto metadata = ResultMetadata{};
+    const auto kind = load_le<std::uint32_t>(header + kind_offset);
+    this->_entry_bits = load_le<std::uint32_t>(header + bits_offset);
+    const auto expected_bits = kind == 1U ? 8U : kind == 2U ? 1U : kind == 3U ? 32U : 0U;
+    if (expected_bits == 0U || this->_entry_bits != expected_bits) {
+        return false;
+    }
+    metadata.kind = static_cast<ResultKind>(kind);
+    metadata.netlist.hi = load_le<std::uint64_t>(header + fingerprint_offset);
+    metadata.netlist.lo = load_le<std::uint64_t>(header + fingerprint_offset + 8U);
+    this->_num_entries = load_le<std::uint64_t>(header + entries_offset);
+    metadata.num_parts = load_le<std::uint32_t>(header + parts_offset);
+    const auto num_values = load_le<std::uint32_t>(header + num_values_offset);
+    this->_checksum = load_le<std::uint64_t>(header + checksum_offset);
+    const auto expected_size
+        = header_size + payload_size(this->_num_entries, this->_entry_bits);
+    if (num_values > ResultMetadata::max_values || this->_num_entries > (std::uint64_t{1} << 40U)
+        || this->_file.size() != expected_size) {
+        return false;
+    }
+    for (size_t i = 0; i != num_values; ++i) {
+        const auto *slot = header + values_offset + i * value_size;
+        auto name = std::string(reinterpret_cast<const char *>(slot), 24U);
+        name.resize(name.find('\0') == std::string::npos ? 24U : name.find('\0'));
+        const auto bits = load_le<std::uint64_t>(slot + 24U);
+        auto value = 0.0;
+        std::memcpy(&value, &bits, sizeof(double));
+        metadata.values.emplace_back(std::move(name), value);
+    }
+    this->_metadata = std::move(metadata);
+    this->_payload = header + header_size;
+    return true;
+}
+
+auto ResultFile::verify() const -> bool {
+    return this->_payload != nullptr
+           && checksum(this->_payload, this->_file.size() - header_size) == this->_checksum;
+}
+
+auto ResultFile::to_bytes() const -> std::vector<std::uint8_t> {
+    if (this->_entry_bits == 8U) {
+        return std::vector<std::uint8_t>(this->_payload, this->_payload + this->_num_entries);
+    }
+    auto bytes = std::vector<std::uint8_t>(this->size());
+    for (size_t v = 0; v != bytes.size(); ++v) {
+        bytes[v] = std::uint8_t((*this)[v]);
+    }
+    return bytes;
+}
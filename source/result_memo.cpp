@@ -0,0 +1,110 @@
+#include <algorithm>                 // for equal
+#include <chrono>                    // for steady_clock
+#include <cstdint>                   // for uint64_t, uint32_t
+#include <filesystem>                // for create_directories, rename, remove
+#include <fstream>                   // for ifstream, ofstream
+#include <functional>                // for hash
+#include <netlistx/binary_io.hpp>    // for read_le, write_le
+#include <netlistx/hash.hpp>         // for hash_combine, hash_sequence
+#include <netlistx/result_memo.hpp>  // for ResultMemo
+#include <string>                    // for string, to_string
+#include <system_error>              // for error_code
+#include <thread>                    // for this_thread
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char memo_magic[8] = {'N', 'X', 'M', 'E', 'M', 'O', '1', '\n'};
+
+    void write_string(std::ofstream &out, boost::string_view str) {
+        write_le(out, std::uint64_t(str.size()));
+        out.write(str.data(), static_cast<std::streamsize>(str.size()));
+    }
+
+    auto read_string(std::ifstream &in, std::string &str) -> bool {
+        auto size = std::uint64_t{0};
+        if (!read_le(in, size)) {
+            return false;
+        }
+        str.resize(size);
+        return size == 0U
+               || static_cast<bool>(in.read(&str[0], static_cast<std::streamsize>(size)));
+    }
+
+    auto hash_string(boost::string_view str) -> std::uint64_t {
+        return hash_sequence(str.begin(), str.end(), str.size());
+    }
+}  // namespace
+
+ResultMemo::ResultMemo(boost::string_view directory) : _directory{directory.to_string()} {}
+
+auto ResultMemo::path_of(const Fingerprint128 &key, boost::string_view algorithm,
+                         boost::string_view parameters) const -> std::string {
+    const auto h1 = hash_combine(hash_string(algorithm), hash_string(parameters));
+    const auto name
+        = Fingerprint128{hash_combine(key.hi, h1), hash_combine(key.lo, ~h1)}.to_string();
+    return (fs::path{this->_directory} / (name + ".memo")).string();
+}
+
+auto ResultMemo::load(const Fingerprint128 &key, boost::string_view algorithm,
+                      boost::string_view parameters, std::string &payload) const -> bool {
+    auto in = std::ifstream{this->path_of(key, algorithm, parameters), std::ios::binary};
+    if (in.fail()) {
+        return false;
+    }
+    char magic[8];
+    if (!in.read(magic, 8) || !std::equal(magic, magic + 8, memo_magic)) {
+        return false;
+    }
+    auto stored = Fingerprint128{};
+    auto stored_algorithm = std::string{};
+    auto stored_parameters = std::string{};
+    if (!read_le(in, stored.hi) || !read_le(in, stored.lo)
+        || !read_string(in, stored_algorithm) || !read_string(in, stored_parameters)) {
+        return false;
+    }
+    if (stored != key || stored_algorithm != algorithm || stored_parameters != parameters) {
+        return false;  // hash collision of the file name
+    }
+    return read_string(in, payload);
+}
+
+auto ResultMemo::store(const Fingerprint128 &key, boost::string_view algorithm,
+                       boost::string_view parameters, boost::string_view payload) const -> bool {
+    auto ec = std::error_code{};
+    fs::create_directories(this->_directory, ec);
+    const auto path = this->path_of(key, algorithm, parameters);
+    const auto tag = hash_combine(std::hash<std::thread::id>{}(std::this_thread::get_id()),
+                                  static_cast<std::uint64_t>(
+                                      std::chrono::steady_clock::now().time_since_epoch().count()));
+    const auto tmp_path = path + ".tmp" + std::to_string(tag);
+    {
+        auto out = std::ofstream{tmp_path, std::ios::binary | std::ios::trunc};
+        if (out.fail()) {
+            return false;
+        }
+        out.write(memo_magic, 8);
+        write_le(out, key.hi);
+        write_le(out, key.lo);
+        write_string(out, algorithm);
+        write_string(out, parameters);
+        write_string(out, payload);
+        if (!out.flush()) {
+            out.close();
+            fs::remove(tmp_path, ec);
+            return false;
+        }
+    }
+    fs::rename(tmp_path, path, ec);
+    if (ec) {
+        fs::remove(tmp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+auto ResultMemo::erase(const Fingerprint128 &key, boost::string_view algorithm,
+                       boost::string_view parameters) const -> bool {
+    auto ec = std::error_code{};
+    return fs::remove(this->path_of(key, algorithm, parameters), ec);
+}
@@ -0,0 +1,244 @@
+#include <algorithm>                // for nth_element, min, max
+#include <array>                    // for array
+#include <cmath>                    // for abs
+#include <cstddef>                  // for size_t, ptrdiff_t
+#include <cstdint>                  // for uint8_t, uint32_t
+#include <limits>                   // for numeric_limits
+#include <netlistx/parallel.hpp>    // for parallel_for
+#include <netlistx/wirelength.hpp>  // for net_hpwl, net_rsmt, total_hpwl, total_rsmt
+#include <vector>                   // for vector
+
+namespace {
+#include "rsmt_tables.inc"  // for rsmt_table_degree, rsmt_perm_base, rsmt_first, rsmt_powv
+
+    constexpr size_t max_mst_degree = 64;
+
+    // Sorts the positions of the pins by `coord` (insertion sort, there are few pins)
+    void sort_small(std::array<size_t, rsmt_table_degree> &order, CsrRow pins,
+                    const std::vector<double> &coord) {
+        for (size_t i = 0; i != pins.size(); ++i) {
+            auto j = i;
+            for (; j != 0 && coord[pins[order[j - 1]]] > coord[pins[i]]; --j) {
+                order[j] = order[j - 1];
+            }
+            order[j] = i;
+        }
+    }
+
+    // Exact RSMT length of 4 to rsmt_table_degree pins from the lookup tables
+    auto table_rsmt(CsrRow pins, const std::vector<double> &x, const std::vector<double> &y)
+        -> double {
+        const auto d = pins.size();
+        auto by_x = std::array<size_t, rsmt_table_degree>{};  // positions in `pins`
+        auto by_y = std::array<size_t, rsmt_table_degree>{};
+        sort_small(by_x, pins, x);
+        sort_small(by_y, pins, y);
+        auto row = std::array<size_t, rsmt_table_degree>{};  // y rank of the i-th pin by x
+        for (size_t i = 0; i != d; ++i) {
+            while (by_y[row[i]] != by_x[i]) {
+                ++row[i];
+            }
+        }
+        auto rank = size_t{0};  // lexicographic rank of `row` among the permutations
+        for (size_t i = 0; i != d; ++i) {
+            auto smaller = size_t{0};
+            for (auto j = i + 1; j != d; ++j) {
+                smaller += row[j] < row[i] ? 1U : 0U;
+            }
+            rank = rank * (d - i) + smaller;
+        }
+        auto gap = std::array<double, 2 * (rsmt_table_degree - 1)>{};
+        for (size_t i = 0; i + 1 != d; ++i) {
+            gap[i] = x[pins[by_x[i + 1]]] - x[pins[by_x[i]]];
+            gap[d - 1 + i] = y[pins[by_y[i + 1]]] - y[pins[by_y[i]]];
+        }
+        const auto perm = rsmt_perm_base[d] + rank;
+        auto best = std::numeric_limits<double>::max();
+        for (auto k = rsmt_first[perm]; k != rsmt_first[perm + 1]; ++k) {
+            auto length = 0.0;
+            for (size_t i = 0; i != 2 * (d - 1); ++i) {
+                length += rsmt_powv[k][i] * gap[i];
+            }
+            best = std::min(best, length);
+        }
+        return best;
+    }
+
+    struct Point {
+        double x;
+        double y;
+    };
+
+    auto manhattan(const Point &a, const Point &b) -> double {
+        return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+    }
+
+    // A rectilinear minimum spanning tree (Prim, O(d^2)); then at every point, the two unshared
+    // edges with the largest common L-shaped part are routed through a Steiner point. At most
+    // `max_mst_degree` points.
+    auto steiner_mst_length(const Point *first, const Point *last) -> double {
+        const auto d = static_cast<size_t>(last - first);
+        auto parent = std::array<size_t, max_mst_degree>{};
+        auto dist = std::array<double, max_mst_degree>{};
+        auto left = std::array<size_t, max_mst_degree>{};  // the points not in the tree yet
+        for (size_t v = 1; v != d; ++v) {
+            dist[v] = std::numeric_limits<double>::max();
+            left[v - 1] = v;
+        }
+        auto length = 0.0;
+        auto u = size_t{0};
+        // Selects without data-dependent branches, which random coordinates would mispredict
+        for (auto num_left = d - 1; num_left != 0; --num_left) {
+            auto next = size_t{0};
+            auto next_dist = std::numeric_limits<double>::max();
+            for (size_t i = 0; i != num_left; ++i) {
+                const auto v = left[i];
+                const auto w = manhattan(first[u], first[v]);
+                const auto closer = size_t{0} - size_t{w < dist[v]};  // all ones if closer
+                parent[v] ^= (parent[v] ^ u) & closer;
+                dist[v] = std::min(w, dist[v]);
+                const auto nearest = dist[v] < next_dist;
+                next_dist = nearest ? dist[v] : next_dist;
+                next = nearest ? i : next;
+            }
+            u = left[next];
+            length += next_dist;
+            left[next] = left[num_left - 1];
+        }
+
+        // Edge v is (v, parent[v]) for v != 0; list the edges of every point
+        auto offsets = std::array<size_t, max_mst_degree + 1>{};
+        for (size_t v = 1; v != d; ++v) {
+            ++offsets[v + 1];
+            ++offsets[parent[v] + 1];
+        }
+        for (size_t v = 0; v != d; ++v) {
+            offsets[v + 1] += offsets[v];
+        }
+        auto edges = std::array<size_t, 2 * max_mst_degree>{};
+        auto pos = offsets;
+        for (size_t v = 1; v != d; ++v) {
+            edges[pos[v]++] = v;
+            edges[pos[parent[v]]++] = v;
+        }
+        auto used = std::array<bool, max_mst_degree>{};
+        auto overlap = [](double a, double b) {
+            const auto same_side = (a > 0.0 && b > 0.0) || (a < 0.0 && b < 0.0);
+            return same_side ? std::min(std::abs(a), std::abs(b)) : 0.0;
+        };
+        for (size_t p = 0; p != d; ++p) {
+            auto best = 0.0;
+            auto best_pair = std::array<size_t, 2>{};
+            for (auto i = offsets[p]; i != offsets[p + 1]; ++i) {
+                const auto e1 = edges[i];
+                if (used[e1]) {
+                    continue;
+                }
+                const auto &a = first[e1 == p ? parent[e1] : e1];
+                for (auto j = i + 1; j != offsets[p + 1]; ++j) {
+                    const auto e2 = edges[j];
+                    const auto &b = first[e2 == p ? parent[e2] : e2];
+                    const auto saving = overlap(a.x - first[p].x, b.x - first[p].x)
+                                        + overlap(a.y - first[p].y, b.y - first[p].y);
+                    if (!used[e2] && saving > best) {
+                        best = saving;
+                        best_pair = {e1, e2};
+                    }
+                }
+            }
+            if (best > 0.0) {
+                used[best_pair[0]] = used[best_pair[1]] = true;
+                length -= best;
+            }
+        }
+        return length;
+    }
+
+    // Splits the points at the median of their wider extent into two halves sharing the median
+    // point, until at most `max_mst_degree` points are left; the trees of the halves meet at the
+    // shared points, so the sum is the length of one tree. Reorders the points.
+    auto split_length(Point *first, Point *last) -> double {
+        if (last - first <= static_cast<std::ptrdiff_t>(max_mst_degree)) {
+            return steiner_mst_length(first, last);
+        }
+        auto x_lo = first->x;
+        auto x_hi = x_lo;
+        auto y_lo = first->y;
+        auto y_hi = y_lo;
+        for (auto *p = first; p != last; ++p) {
+            x_lo = std::min(x_lo, p->x);
+            x_hi = std::max(x_hi, p->x);
+            y_lo = std::min(y_lo, p->y);
+            y_hi = std::max(y_hi, p->y);
+        }
+        auto *mid = first + (last - first) / 2;
+        const auto by_x = x_hi - x_lo >= y_hi - y_lo;
+        std::nth_element(first, mid, last, [&](const Point &a, const Point &b) {
+            return by_x ? a.x < b.x : a.y < b.y;
+        });
+        // After the left half, `*mid` is still one of its points
+        const auto left = split_length(first, mid + 1);
+        return left + split_length(mid, last);
+    }
+
+    template <typename Fn>
+    auto total_length(const Csr &net_pins, const Fn &net_length) -> double {
+        auto length = std::vector<double>(net_pins.size());
+        parallel_for(
+            0U, net_pins.size(),
+            [&](size_t lo, size_t hi) {
+                for (auto i = lo; i != hi; ++i) {
+                    length[i] = net_length(net_pins[i]);
+                }
+            },
+            1024U);
+        auto total = 0.0;
+        for (const auto l : length) {
+            total += l;  // in net order, so the sum does not depend on the threads
+        }
+        return total;
+    }
+}  // namespace
+
+auto net_hpwl(CsrRow pins, const std::vector<double> &x, const std::vector<double> &y) -> double {
+    if (pins.empty()) {
+        return 0.0;
+    }
+    auto x_lo = x[pins[0]];
+    auto x_hi = x_lo;
+    auto y_lo = y[pins[0]];
+    auto y_hi = y_lo;
+    for (const auto v : pins) {
+        x_lo = std::min(x_lo, x[v]);
+        x_hi = std::max(x_hi, x[v]);
+        y_lo = std::min(y_lo, y[v]);
+        y_hi = std::max(y_hi, y[v]);
+    }
+    return (x_hi - x_lo) + (y_hi - y_lo);
+}
+
+auto net_rsmt(CsrRow pins, const std::vector<double> &x, const std::vector<double> &y) -> double {
+    const auto d = pins.size();
+    if (d <= 3U) {
+        return net_hpwl(pins, x, y);
+    }
+    if (d <= rsmt_table_degree) {
+        return table_rsmt(pins, x, y);
+    }
+    auto points = std::vector<Point>{};
+    points.reserve(d);
+    for (const auto v : pins) {
+        points.push_back(Point{x[v], y[v]});
+    }
+    return split_length(points.data(), points.data() + d);
+}
+
+auto total_hpwl(const Csr &net_pins, const std::vector<double> &x, const std::vector<double> &y)
+    -> double {
+    return total_length(net_pins, [&](CsrRow pins) { return net_hpwl(pins, x, y); });
+}
+
+auto total_rsmt(const Csr &net_pins, const std::vector<double> &x, const std::vector<double> &y)
+    -> double {
+    return total_length(net_pins, [&](CsrRow pins) { return net_rsmt(pins, x, y); });
+}
@@ -0,0 +1,90 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <algorithm>                      // for search
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstdint>                        // for uint8_t, uint32_t
+#include <filesystem>                     // for temp_directory_path, remove_all
+#include <fstream>                        // for ifstream
+#include <iterator>                       // for istreambuf_iterator
+#include <netlistx/arrow_ipc.hpp>         // for ArrowFileWriter, writeArrowNets, writeArrowModules
+#include <netlistx/binary_io.hpp>         // for load_le
+#include <netlistx/netlist.hpp>           // for SimpleNetlist
+#include <string>                         // for string
+#include <vector>                         // for vector
+
+using namespace std;
+
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+static auto read_bytes(const string &fileName) -> vector<unsigned char> {
+    auto in = ifstream{fileName, ios::binary};
+    return vector<unsigned char>(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+}
+
+// Checks the file layout: magic, schema message, record batch, footer, footer size, magic.
+static void check_layout(const vector<unsigned char> &bytes) {
+    const auto size = bytes.size();
+    REQUIRE(size > 24U);
+    CHECK(string(bytes.begin(), bytes.begin() + 8) == string("ARROW1\0\0", 8));
+    CHECK(string(bytes.end() - 6, bytes.end()) == "ARROW1");
+    CHECK(load_le<uint32_t>(&bytes[8]) == 0xFFFFFFFFU);  // continuation of the schema message
+    const auto schema_size = load_le<int32_t>(&bytes[12]);
+    CHECK(schema_size % 8 == 0);
+    const auto batch = 16U + size_t(schema_size);
+    CHECK(load_le<uint32_t>(&bytes[batch]) == 0xFFFFFFFFU);
+    const auto footer_size = load_le<int32_t>(&bytes[size - 10]);
+    CHECK(footer_size > 0);
+    CHECK(size_t(footer_size) + batch < size);
+}
+
+TEST_CASE("Test Arrow IPC export") {
+    const auto dir = filesystem::temp_directory_path() / "netlistx_test_arrow_ipc";
+    filesystem::remove_all(dir);
+    filesystem::create_directories(dir);
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+
+    const auto nets_file = (dir / "p1_nets.arrow").string();
+    REQUIRE(writeArrowNets(nets_file, hyprgraph));
+    const auto nets = read_bytes(nets_file);
+    check_layout(nets);
+
+    const auto modules_file = (dir / "p1_modules.arrow").string();
+    REQUIRE(writeArrowModules(modules_file, hyprgraph));
+    const auto modules = read_bytes(modules_file);
+    check_layout(modules);
+
+    // The module list column holds one entry per pin, like the net list column
+    CHECK(modules.size() > nets.size());
+
+    filesystem::remove_all(dir);
+}
+
+TEST_CASE("Test Arrow IPC writer") {
+    const auto dir = filesystem::temp_directory_path() / "netlistx_test_arrow_writer";
+    filesystem::remove_all(dir);
+    filesystem::create_directories(dir);
+    const auto file = (dir / "columns.arrow").string();
+
+    auto lists = Csr{};
+    lists.targets = {7, 8, 9};
+    lists.offsets = {0, 2, 2, 3};
+    auto writer = ArrowFileWriter{};
+    writer.add_column("id", vector<uint32_t>{1, 2, 3});
+    writer.add_bool_column("flag", vector<uint8_t>{1, 0, 1});
+    writer.add_list_column("items", lists);
+    writer.add_metadata("source", "test");
+    REQUIRE(writer.write(file));
+    const auto bytes = read_bytes(file);
+    check_layout(bytes);
+
+    // The body holds the values verbatim
+    const auto body = vector<unsigned char>{7, 0, 0, 0, 8, 0, 0, 0, 9, 0, 0, 0};
+    CHECK(search(bytes.begin(), bytes.end(), body.begin(), body.end()) != bytes.end());
+
+    // Columns of different lengths are rejected
+    writer.add_column("short", vector<uint32_t>{1});
+    CHECK(!writer.write(file));
+
+    filesystem::remove_all(dir);
+}
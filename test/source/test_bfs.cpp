@@ -0,0 +1,78 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstdint>                        // for uint32_t
+#include <deque>                          // for deque
+#include <netlistx/bfs.hpp>               // for NetlistBfs, pseudo_peripheral_node
+#include <netlistx/netlist.hpp>           // for SimpleNetlist
+#include <vector>                         // for vector
+
+using namespace std;
+
+extern auto make_netlist(uint32_t num_modules, const vector<vector<uint32_t>> &net_list)
+    -> SimpleNetlist;  // import make_netlist
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+/**
+ * @brief Plain queue-based BFS for reference
+ */
+static auto simple_bfs(const SimpleNetlist &hyprgraph, index_t source) -> vector<index_t> {
+    auto dist = vector<index_t>(hyprgraph.number_of_nodes(), NetlistBfs<SimpleNetlist>::npos);
+    auto queue = deque<index_t>{source};
+    dist[source] = 0;
+    while (!queue.empty()) {
+        const auto v = queue.front();
+        queue.pop_front();
+        for (const auto &w : hyprgraph.gr[v]) {
+            if (dist[w] == NetlistBfs<SimpleNetlist>::npos) {
+                dist[w] = dist[v] + 1;
+                queue.push_back(w);
+            }
+        }
+    }
+    return dist;
+}
+
+TEST_CASE("Test NetlistBfs path") {
+    const auto hyprgraph = make_netlist(5, {{0, 1}, {1, 2}, {2, 3}, {3, 4}});
+    auto bfs = NetlistBfs<SimpleNetlist>{hyprgraph};
+    CHECK(bfs.run(2) == 4);
+    CHECK(bfs.distance(0) == 4);
+    CHECK(bfs.distance(4) == 4);
+    CHECK(bfs.distance(6) == 1);  // net {1, 2}
+    CHECK(bfs.number_of_levels() == 5);
+    CHECK(bfs.level(2) == vector<index_t>{1, 3});
+
+    const auto root = pseudo_peripheral_node(bfs, hyprgraph, 2);
+    CHECK((root == 0 || root == 4));
+    CHECK(bfs.run(root) == 8);
+}
+
+TEST_CASE("Test NetlistBfs ibm01") {
+    const auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    auto bfs = NetlistBfs<SimpleNetlist>{hyprgraph};
+    for (const auto source : {0U, 100U, 5000U, 12752U}) {
+        const auto expected = simple_bfs(hyprgraph, source);
+        bfs.run(source);
+        auto same = true;
+        for (index_t v = 0; v != hyprgraph.number_of_nodes(); ++v) {
+            same = same && bfs.distance(v) == expected[v];
+        }
+        CHECK(same);
+    }
+    CHECK(bfs.number_of_bottom_up_steps() > 0);
+
+    bfs.alpha = 0.0;  // top-down only
+    bfs.run(100U);
+    CHECK(bfs.number_of_bottom_up_steps() == 0);
+    const auto expected = simple_bfs(hyprgraph, 100U);
+    auto same = true;
+    for (index_t v = 0; v != hyprgraph.number_of_nodes(); ++v) {
+        same = same && bfs.distance(v) == expected[v];
+    }
+    CHECK(same);
+
+    const auto root = pseudo_peripheral_node(bfs, hyprgraph, 0U);
+    CHECK(root < hyprgraph.number_of_modules());
+}
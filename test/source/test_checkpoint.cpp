@@ -0,0 +1,154 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstdint>                        // for uint8_t, uint32_t, uint64_t
+#include <filesystem>                     // for temp_directory_path, remove_all, directory_iterator
+#include <fstream>                        // for fstream
+#include <netlistx/checkpoint.hpp>        // for Checkpoint, CheckpointWriter, readCheckpoint
+#include <netlistx/fingerprint.hpp>       // for fingerprint
+#include <netlistx/netlist.hpp>           // for SimpleNetlist
+#include <netlistx/partition.hpp>         // for connectivity_cost
+#include <random>                         // for mt19937_64
+#include <thread>                         // for thread
+#include <vector>                         // for vector
+
+using namespace std;
+
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+// A small randomized search: flip random modules, keep the flip unless it increases the cut
+static void search(const SimpleNetlist &hyprgraph, vector<uint8_t> &part, mt19937_64 &rng,
+                   uint64_t first, uint64_t last) {
+    auto cost = connectivity_cost(hyprgraph, part, 2);
+    for (auto step = first; step != last; ++step) {
+        const auto v = rng() % hyprgraph.number_of_modules();
+        part[v] = uint8_t(1U - part[v]);
+        const auto new_cost = connectivity_cost(hyprgraph, part, 2);
+        if (new_cost > cost && rng() % 4U != 0U) {
+            part[v] = uint8_t(1U - part[v]);
+        } else {
+            cost = new_cost;
+        }
+    }
+}
+
+TEST_CASE("Test checkpoint file") {
+    const auto dir = filesystem::temp_directory_path() / "netlistx_test_checkpoint";
+    filesystem::remove_all(dir);
+    filesystem::create_directories(dir);
+    const auto file = (dir / "run.ckpt").string();
+
+    auto checkpoint = Checkpoint{};
+    checkpoint.netlist = Fingerprint128{1, 2};
+    checkpoint.step = 42;
+    checkpoint.put("part", vector<uint8_t>{0, 1, 1, 0});
+    checkpoint.put("level0.map", vector<uint32_t>{0, 0, 1, 2, 2});
+    checkpoint.put("gains", vector<int64_t>{-3, 5});
+    checkpoint.put("part", vector<uint8_t>{1, 1});  // replaces
+    REQUIRE(writeCheckpoint(file, checkpoint));
+
+    auto loaded = Checkpoint{};
+    REQUIRE(readCheckpoint(file, loaded));
+    CHECK(loaded.netlist == checkpoint.netlist);
+    CHECK(loaded.step == 42U);
+    CHECK(loaded.sections.size() == 3U);
+    auto part = vector<uint8_t>{};
+    auto map = vector<uint32_t>{};
+    auto gains = vector<int64_t>{};
+    CHECK(loaded.get("part", part));
+    CHECK(loaded.get("level0.map", map));
+    CHECK(loaded.get("gains", gains));
+    CHECK(part == vector<uint8_t>{1, 1});
+    CHECK(map == vector<uint32_t>{0, 0, 1, 2, 2});
+    CHECK(gains == vector<int64_t>{-3, 5});
+    CHECK(!loaded.get("level0.map", part));  // wrong element size
+    CHECK(!loaded.get("missing", part));
+
+    // A corrupted byte fails the checksum
+    {
+        auto stream = fstream{file, ios::binary | ios::in | ios::out};
+        stream.seekp(60);
+        stream.put('\x7f');
+    }
+    CHECK(!readCheckpoint(file, loaded));
+    CHECK(!readCheckpoint((dir / "missing.ckpt").string(), loaded));
+
+    // Concurrent writers replace the checkpoint with one complete file and leave no temporary
+    auto written = vector<uint8_t>(2, 1U);
+    auto writer = [&](uint64_t step) {
+        auto mine = checkpoint;
+        mine.step = step;
+        for (auto i = 0; i != 20; ++i) {
+            if (!writeCheckpoint(file, mine)) {
+                written[step - 1U] = 0U;
+            }
+        }
+    };
+    auto first = thread{writer, 1U};
+    auto second = thread{writer, 2U};
+    first.join();
+    second.join();
+    CHECK(written == vector<uint8_t>{1, 1});
+    REQUIRE(readCheckpoint(file, loaded));
+    CHECK((loaded.step == 1U || loaded.step == 2U));
+    auto num_files = 0;
+    for (const auto &entry : filesystem::directory_iterator{dir}) {
+        num_files += entry.is_regular_file() ? 1 : 0;
+    }
+    CHECK(num_files == 1);
+    filesystem::remove_all(dir);
+}
+
+TEST_CASE("Test checkpoint restart is deterministic") {
+    const auto dir = filesystem::temp_directory_path() / "netlistx_test_restart";
+    filesystem::remove_all(dir);
+    filesystem::create_directories(dir);
+    const auto file = (dir / "p1.ckpt").string();
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    const auto num_modules = hyprgraph.number_of_modules();
+
+    // Uninterrupted run
+    auto full_part = vector<uint8_t>(num_modules);
+    for (size_t v = 0; v != num_modules; ++v) {
+        full_part[v] = uint8_t(v % 2);
+    }
+    const auto initial = full_part;
+    auto full_rng = mt19937_64{7};
+    search(hyprgraph, full_part, full_rng, 0, 200);
+
+    // Run with a checkpoint every 50 steps, "killed" after step 120
+    {
+        auto writer = CheckpointWriter{file};
+        auto part = initial;
+        auto rng = mt19937_64{7};
+        for (uint64_t step = 0; step != 120; step += 10) {
+            search(hyprgraph, part, rng, step, step + 10);
+            if ((step + 10) % 50 == 0) {
+                auto checkpoint = Checkpoint{};
+                checkpoint.netlist = fingerprint(hyprgraph);
+                checkpoint.step = step + 10;
+                checkpoint.put("part", part);
+                checkpoint.put_engine("rng", rng);
+                writer.submit(std::move(checkpoint));
+            }
+        }
+        writer.flush();
+        CHECK(writer.ok());
+        CHECK(writer.num_written() >= 1U);
+    }
+
+    // Resume from the last checkpoint
+    auto checkpoint = Checkpoint{};
+    REQUIRE(readCheckpoint(file, checkpoint));
+    CHECK(checkpoint.netlist == fingerprint(hyprgraph));
+    CHECK(checkpoint.step == 100U);
+    auto part = vector<uint8_t>{};
+    auto rng = mt19937_64{};
+    REQUIRE(checkpoint.get("part", part));
+    REQUIRE(checkpoint.get_engine("rng", rng));
+    search(hyprgraph, part, rng, checkpoint.step, 200);
+    CHECK(part == full_part);
+    CHECK(rng() == full_rng());
+    filesystem::remove_all(dir);
+}
@@ -0,0 +1,77 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstdint>                        // for uint32_t, uint8_t, uint64_t
+#include <filesystem>                     // for temp_directory_path, remove_all
+#include <netlistx/coarsening.hpp>        // for coarsen, contract, CoarseningHierarchy
+#include <netlistx/netlist.hpp>           // for SimpleNetlist
+#include <netlistx/parallel.hpp>          // for parallel_blocks
+#include <netlistx/partition.hpp>         // for block_weights, connectivity_cost
+#include <vector>                         // for vector
+
+using namespace std;
+
+extern auto make_netlist(uint32_t num_modules, const vector<vector<uint32_t>> &net_list)
+    -> SimpleNetlist;  // import make_netlist
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+TEST_CASE("Test contract") {
+    auto hyprgraph = make_netlist(5, {{0, 1}, {1, 2, 3}, {3, 4}, {0, 4}});
+    hyprgraph.module_fixed.insert(4);
+    const auto coarse = contract(hyprgraph, {0, 0, 1, 1, 2}, 3);
+    CHECK(coarse.number_of_modules() == 3);
+    CHECK(coarse.number_of_nets() == 3);  // {0, 1} is inside a cluster
+    CHECK(coarse.module_weight == vector<unsigned int>{2, 2, 1});
+    CHECK(coarse.module_fixed.contains(2));
+    CHECK(coarse.gr.degree(3) == 2);  // {1, 2, 3} -> {0, 1}
+}
+
+TEST_CASE("Test coarsen") {
+    const auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    const auto hierarchy = coarsen(hyprgraph);
+    REQUIRE(hierarchy.num_levels() >= 2);
+    auto finer = hyprgraph.number_of_modules();
+    for (const auto &level : hierarchy.levels) {
+        CHECK(level.cluster.size() == finer);
+        CHECK(level.netlist.number_of_modules() < finer);
+        finer = level.netlist.number_of_modules();
+    }
+
+    // Every run of the sweep shares the hierarchy; projection keeps weights and cost
+    const auto top = hierarchy.num_levels() - 1;
+    const auto &coarsest = hierarchy.coarsest();
+    auto costs = vector<uint64_t>(4);
+    parallel_blocks(0, 4, 4, [&](size_t, size_t lo, size_t hi) {
+        for (auto i = lo; i != hi; ++i) {
+            const auto num_parts = i + 2;
+            auto part = vector<uint8_t>(coarsest.number_of_modules());
+            for (size_t v = 0; v != part.size(); ++v) {
+                part[v] = uint8_t(v * num_parts / part.size());
+            }
+            const auto fine = hierarchy.project_to_input(top, part);
+            costs[i] = connectivity_cost(hyprgraph, fine, num_parts);
+            CHECK(costs[i] == connectivity_cost(coarsest, part, num_parts));
+            CHECK(block_weights(hyprgraph, fine, num_parts)
+                  == block_weights(coarsest, part, num_parts));
+        }
+    });
+
+    const auto dir = filesystem::temp_directory_path() / "netlistx_test_coarsening";
+    filesystem::remove_all(dir);
+    filesystem::create_directories(dir);
+    const auto file = (dir / "ibm01.hier").string();
+    REQUIRE(writeHierarchy(file, hierarchy));
+    auto loaded = CoarseningHierarchy{};
+    REQUIRE(readHierarchy(file, hyprgraph, loaded));
+    REQUIRE(loaded.num_levels() == hierarchy.num_levels());
+    for (size_t i = 0; i != loaded.num_levels(); ++i) {
+        CHECK(loaded.levels[i].cluster == hierarchy.levels[i].cluster);
+        CHECK(loaded.levels[i].netlist.number_of_nets()
+              == hierarchy.levels[i].netlist.number_of_nets());
+        CHECK(loaded.levels[i].netlist.module_weight == hierarchy.levels[i].netlist.module_weight);
+    }
+    const auto other = readNetD("../../testcases/p1.net");
+    CHECK(!readHierarchy(file, other, loaded));
+    filesystem::remove_all(dir);
+}
@@ -0,0 +1,100 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <algorithm>                        // for sort
+#include <boost/utility/string_view.hpp>    // for boost::string_view
+#include <cstdint>                          // for uint32_t, uint8_t, uint64_t
+#include <netlistx/csr.hpp>                 // for net_pins_csr
+#include <netlistx/dynamic_hypergraph.hpp>  // for DynamicHypergraph, nlevel_coarsen, refine_local
+#include <netlistx/netlist.hpp>             // for SimpleNetlist
+#include <netlistx/partition.hpp>           // for block_weights, connectivity_cost
+#include <vector>                           // for vector
+
+using namespace std;
+
+extern auto make_netlist(uint32_t num_modules, const vector<vector<uint32_t>> &net_list)
+    -> SimpleNetlist;  // import make_netlist
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+static auto sorted_pins(const DynamicHypergraph &hyprgraph, index_t net) -> vector<index_t> {
+    auto pins = vector<index_t>(hyprgraph.pins(net).begin(), hyprgraph.pins(net).end());
+    sort(pins.begin(), pins.end());
+    return pins;
+}
+
+static auto same_pins(const DynamicHypergraph &dynamic, const SimpleNetlist &hyprgraph) -> bool {
+    const auto pins = net_pins_csr(hyprgraph);
+    for (size_t net = 0; net != pins.size(); ++net) {
+        if (sorted_pins(dynamic, index_t(net))
+            != vector<index_t>(pins[net].begin(), pins[net].end())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("Test DynamicHypergraph contract") {
+    const auto hyprgraph = make_netlist(5, {{0, 1}, {1, 2, 3}, {3, 4}, {0, 4}});
+    auto dynamic = DynamicHypergraph{hyprgraph};
+    dynamic.contract(0, 1);  // {0, 1} becomes a single pin, {1, 2, 3} -> {0, 2, 3}
+    CHECK(dynamic.num_active() == 4);
+    CHECK(!dynamic.is_active(1));
+    CHECK(dynamic.weight(0) == 2);
+    CHECK(!dynamic.is_enabled(0));
+    CHECK(sorted_pins(dynamic, 1) == vector<index_t>{0, 2, 3});
+    CHECK(dynamic.nets(0).size() == 3);
+    dynamic.contract(3, 4);  // {3, 4} disabled, {0, 4} -> {0, 3}
+    dynamic.contract(0, 3);  // {0, 2, 3} -> {0, 2}, {0, 3} disabled
+    CHECK(dynamic.num_active() == 2);
+    CHECK(sorted_pins(dynamic, 1) == vector<index_t>{0, 2});
+    CHECK(!dynamic.is_enabled(3));
+    CHECK(dynamic.weight(0) == 4);
+
+    auto part = vector<uint8_t>{1, 0, 0, 0, 0};
+    const auto seeds = dynamic.uncontract_batch(3, part);
+    CHECK(seeds == vector<index_t>{3, 4, 1});
+    CHECK(part == vector<uint8_t>{1, 1, 0, 1, 1});
+    CHECK(dynamic.num_active() == 5);
+    CHECK(dynamic.history().empty());
+    CHECK(same_pins(dynamic, hyprgraph));
+    for (index_t v = 0; v != 5; ++v) {
+        CHECK(dynamic.weight(v) == 1);
+        CHECK(dynamic.nets(v).size() == hyprgraph.gr.degree(v));
+    }
+}
+
+TEST_CASE("Test n-level coarsening and refinement") {
+    const auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    const auto num_modules = hyprgraph.number_of_modules();
+
+    // Bipartition the coarsest hypergraph, then uncontract without or with refinement
+    auto run = [&](bool refine) {
+        auto dynamic = DynamicHypergraph{hyprgraph};
+        const auto num_contractions = nlevel_coarsen(dynamic);
+        CHECK(num_contractions == dynamic.history().size());
+        CHECK(dynamic.num_active() == num_modules - num_contractions);
+        auto part = vector<uint8_t>(num_modules, 0U);
+        auto block_weight = vector<uint64_t>(2, 0U);
+        for (size_t v = 0; v != num_modules; ++v) {
+            if (dynamic.is_active(index_t(v))) {
+                const auto b = block_weight[0] <= block_weight[1] ? 0U : 1U;
+                part[v] = uint8_t(b);
+                block_weight[b] += dynamic.weight(index_t(v));
+            }
+        }
+        const auto max_block_weight = uint64_t(double(num_modules) * 0.55);
+        while (!dynamic.history().empty()) {
+            const auto seeds = dynamic.uncontract_batch(64, part);
+            if (refine) {
+                refine_local(dynamic, part, block_weight, seeds, max_block_weight);
+            }
+        }
+        CHECK(dynamic.num_active() == num_modules);
+        CHECK(same_pins(dynamic, hyprgraph));
+        CHECK(block_weights(hyprgraph, part, 2) == block_weight);
+        return connectivity_cost(hyprgraph, part, 2);
+    };
+    const auto projected = run(false);
+    const auto refined = run(true);
+    CHECK(refined < projected);
+}
@@ -0,0 +1,78 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstdint>                        // for uint32_t, uint8_t
+#include <filesystem>                     // for temp_directory_path, remove_all
+#include <netlistx/fingerprint.hpp>       // for fingerprint, Fingerprint128
+#include <netlistx/netlist.hpp>           // for SimpleNetlist
+#include <netlistx/result_memo.hpp>       // for ResultMemo
+#include <string>                         // for string
+#include <vector>                         // for vector
+
+using namespace std;
+
+extern auto create_dwarf() -> SimpleNetlist;  // import create_dwarf
+extern auto make_netlist(uint32_t num_modules, const vector<vector<uint32_t>> &net_list)
+    -> SimpleNetlist;  // import make_netlist
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+TEST_CASE("Test fingerprint net order") {
+    const auto hgr1 = make_netlist(4, {{0, 1}, {1, 2, 3}, {0, 3}});
+    const auto hgr2 = make_netlist(4, {{3, 0}, {0, 1}, {3, 2, 1}});
+    const auto hgr3 = make_netlist(4, {{0, 1}, {1, 2}, {0, 3}});
+    CHECK(fingerprint(hgr1) == fingerprint(hgr2));
+    CHECK(fingerprint(hgr1) != fingerprint(hgr3));
+    CHECK(fingerprint(hgr1).to_string().size() == 32);
+}
+
+TEST_CASE("Test fingerprint module relabeling") {
+    // hgr2 is hgr1 with the modules renumbered by 0->2, 1->0, 2->3, 3->1
+    const auto hgr1 = make_netlist(4, {{0, 1}, {1, 2, 3}, {0, 3}});
+    const auto hgr2 = make_netlist(4, {{2, 0}, {0, 3, 1}, {2, 1}});
+    auto options = FingerprintOptions{};
+    CHECK(fingerprint(hgr1, options) != fingerprint(hgr2, options));
+    options.module_relabeling = true;
+    CHECK(fingerprint(hgr1, options) == fingerprint(hgr2, options));
+    CHECK(fingerprint(hgr1, options) != fingerprint(hgr1));
+}
+
+TEST_CASE("Test fingerprint weights") {
+    const auto hgr1 = create_dwarf();
+    auto hgr2 = create_dwarf();
+    CHECK(fingerprint(hgr1) == fingerprint(hgr2));
+    hgr2.module_weight[0] = 9;
+    CHECK(fingerprint(hgr1) != fingerprint(hgr2));
+}
+
+TEST_CASE("Test fingerprint fixed modules") {
+    const auto hgr1 = make_netlist(4, {{0, 1}, {1, 2, 3}, {0, 3}});
+    auto hgr2 = make_netlist(4, {{0, 1}, {1, 2, 3}, {0, 3}});
+    auto relabeled = FingerprintOptions{};
+    relabeled.module_relabeling = true;
+    hgr2.module_fixed.insert(2);
+    CHECK(fingerprint(hgr1) != fingerprint(hgr2));
+    CHECK(fingerprint(hgr1, relabeled) != fingerprint(hgr2, relabeled));
+    hgr2.module_fixed.erase(2);
+    CHECK(fingerprint(hgr1) == fingerprint(hgr2));
+    CHECK(fingerprint(hgr1, relabeled) == fingerprint(hgr2, relabeled));
+}
+
+TEST_CASE("Test ResultMemo") {
+    const auto dir = (filesystem::temp_directory_path() / "netlistx_memo_test").string();
+    filesystem::remove_all(dir);
+    const auto memo = ResultMemo{dir};
+    const auto key = fingerprint(readNetD("../../testcases/p1.net"));
+
+    auto cover = vector<uint8_t>{};
+    CHECK(!memo.load_vector(key, "min_vertex_cover", "unit", cover));
+    const auto result = vector<uint8_t>{1, 0, 0, 1, 1};
+    CHECK(memo.store_vector(key, "min_vertex_cover", "unit", result));
+    CHECK(memo.load_vector(key, "min_vertex_cover", "unit", cover));
+    CHECK(cover == result);
+    CHECK(!memo.load_vector(key, "min_vertex_cover", "area", cover));
+    CHECK(!memo.load_vector(key, "min_maximal_matching", "unit", cover));
+    CHECK(memo.erase(key, "min_vertex_cover", "unit"));
+    CHECK(!memo.load_vector(key, "min_vertex_cover", "unit", cover));
+    filesystem::remove_all(dir);
+}
@@ -0,0 +1,98 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <algorithm>                       // for find, min
+#include <boost/utility/string_view.hpp>   // for boost::string_view
+#include <chrono>                          // for steady_clock, duration
+#include <cstdint>                         // for uint32_t, uint8_t, uint64_t
+#include <netlistx/hypergraph_mincut.hpp>  // for MinCut, global_min_cut
+#include <netlistx/netlist.hpp>            // for SimpleNetlist
+#include <netlistx/partition.hpp>          // for connectivity_cost
+#include <random>                          // for mt19937
+#include <vector>                          // for vector
+
+using namespace std;
+
+extern auto make_netlist(uint32_t num_modules, const vector<vector<uint32_t>> &net_list)
+    -> SimpleNetlist;  // import make_netlist
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+// Whether `cut.side` splits the modules into two non-empty sides cutting `cut.weight` nets
+static auto is_cut(const SimpleNetlist &hyprgraph, const MinCut &cut) -> bool {
+    auto num_ones = size_t{0};
+    for (const auto s : cut.side) {
+        num_ones += s;
+    }
+    return num_ones != 0U && num_ones != cut.side.size()
+           && connectivity_cost(hyprgraph, cut.side, 2) == cut.weight;
+}
+
+static auto brute_force_min_cut(const SimpleNetlist &hyprgraph) -> uint64_t {
+    const auto num_modules = hyprgraph.number_of_modules();
+    auto best = hyprgraph.number_of_nets();
+    auto side = vector<uint8_t>(num_modules);
+    for (size_t mask = 1; mask != (size_t{1} << (num_modules - 1)); ++mask) {
+        for (size_t v = 0; v != num_modules; ++v) {
+            side[v] = uint8_t((mask >> v) & 1U);
+        }
+        best = min(best, size_t(connectivity_cost(hyprgraph, side, 2)));
+    }
+    return best;
+}
+
+TEST_CASE("Test global_min_cut (small)") {
+    // Two 4-cliques of 3-pin nets joined by one net
+    const auto bridged = make_netlist(8, {{0, 1, 2}, {1, 2, 3}, {0, 2, 3}, {0, 1, 3},
+                                          {4, 5, 6}, {5, 6, 7}, {4, 6, 7}, {4, 5, 7},
+                                          {3, 4}});
+    const auto cut = global_min_cut(bridged);
+    CHECK(cut.weight == 1);
+    CHECK(is_cut(bridged, cut));
+    CHECK(cut.side[0] == cut.side[3]);
+    CHECK(cut.side[0] != cut.side[4]);
+
+    const auto disconnected = make_netlist(5, {{0, 1}, {1, 2}, {3, 4}});
+    const auto empty = global_min_cut(disconnected);
+    CHECK(empty.weight == 0);
+    CHECK(is_cut(disconnected, empty));
+}
+
+TEST_CASE("Test global_min_cut (random)") {
+    auto rng = mt19937{5};
+    auto exact = true;
+    for (size_t trial = 0; trial != 40; ++trial) {
+        const auto num_modules = uint32_t(6 + trial % 7);
+        auto nets = vector<vector<uint32_t>>{};
+        for (uint32_t v = 0; v + 1 != num_modules; ++v) {
+            nets.push_back({v, v + 1});  // keep the hypergraph connected
+        }
+        for (size_t i = 0; i != 3 * num_modules; ++i) {
+            auto pins = vector<uint32_t>{};
+            for (size_t j = 0, size = 2 + rng() % 4; j != size; ++j) {
+                const auto v = uint32_t(rng() % num_modules);
+                if (find(pins.begin(), pins.end(), v) == pins.end()) {
+                    pins.push_back(v);
+                }
+            }
+            if (pins.size() >= 2U) {
+                nets.push_back(pins);
+            }
+        }
+        const auto hyprgraph = make_netlist(num_modules, nets);
+        const auto expected = brute_force_min_cut(hyprgraph);
+        for (const auto max_net_degree : {size_t{2}, size_t{64}}) {
+            const auto cut = global_min_cut(hyprgraph, max_net_degree);
+            exact = exact && cut.weight == expected && is_cut(hyprgraph, cut);
+        }
+    }
+    CHECK(exact);
+}
+
+TEST_CASE("Test global_min_cut (ibm01)") {
+    const auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    const auto start = chrono::steady_clock::now();
+    const auto cut = global_min_cut(hyprgraph);
+    const auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    CHECK(is_cut(hyprgraph, cut));
+    CHECK(elapsed < 10.0);
+}
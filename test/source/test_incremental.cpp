@@ -0,0 +1,324 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <boost/utility/string_view.hpp>      // for boost::string_view
+#include <cstdint>                            // for uint32_t
+#include <netlistx/incremental_cover.hpp>     // for IncrementalVertexCover
+#include <netlistx/incremental_matching.hpp>  // for IncrementalMatching
+#include <netlistx/netlist.hpp>               // for SimpleNetlist
+#include <netlistx/netlist_algo.hpp>          // for min_vertex_cover, min_maximal_matching
+#include <netlistx/netlist_diff.hpp>          // for diff
+#include <py2cpp/dict.hpp>                    // for dict
+#include <py2cpp/set.hpp>                     // for set
+#include <random>                             // for mt19937
+#include <vector>                             // for vector
+
+using namespace std;
+
+extern auto make_netlist(uint32_t num_modules, const vector<vector<uint32_t>> &net_list)
+    -> SimpleNetlist;  // import make_netlist
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+using node_t = SimpleNetlist::node_t;
+
+/**
+ * @brief Whether every net of the netlist has a pin in the cover
+ */
+template <typename Cover> static auto is_cover(const SimpleNetlist &hyprgraph, const Cover &cover)
+    -> bool {
+    for (const auto &net : hyprgraph.nets) {
+        auto covered = false;
+        for (const auto &v : hyprgraph.gr[net]) {
+            covered = covered || cover.contains(index_t(v));
+        }
+        if (!covered && hyprgraph.gr.degree(net) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static auto unit_weight(const SimpleNetlist &hyprgraph) -> py::dict<node_t, int> {
+    auto weight = py::dict<node_t, int>{};
+    for (auto v : hyprgraph) {
+        weight[v] = 1;
+    }
+    return weight;
+}
+
+static auto module_weights(const SimpleNetlist &hyprgraph) -> py::dict<node_t, int> {
+    auto weight = py::dict<node_t, int>{};
+    for (auto v : hyprgraph) {
+        weight[v] = int(hyprgraph.get_module_weight(v));
+    }
+    return weight;
+}
+
+static auto pin_lists(const SimpleNetlist &hyprgraph) -> vector<vector<uint32_t>> {
+    auto nets = vector<vector<uint32_t>>{};
+    for (const auto &net : hyprgraph.nets) {
+        nets.emplace_back();
+        for (const auto &v : hyprgraph.gr[net]) {
+            nets.back().push_back(uint32_t(v));
+        }
+    }
+    return nets;
+}
+
+/**
+ * @brief Whether the net duals are non-negative, add up to `dual_cost()` and load no module
+ *        beyond its weight
+ */
+template <typename Weight>
+static auto is_dual_feasible(const SimpleNetlist &hyprgraph, const Weight &weight,
+                             const IncrementalVertexCover<int> &cover) -> bool {
+    const auto base = hyprgraph.number_of_modules();
+    auto load = vector<int>(base, 0);
+    auto total = 0;
+    for (const auto &net : hyprgraph.nets) {
+        const auto dual = cover.net_dual(net - base);
+        if (dual < 0) {
+            return false;
+        }
+        total += dual;
+        for (const auto &v : hyprgraph.gr[net]) {
+            load[v] += dual;
+        }
+    }
+    for (auto v : hyprgraph) {
+        if (load[v] > weight.at(v)) {
+            return false;
+        }
+    }
+    return total == cover.dual_cost();
+}
+
+TEST_CASE("Test IncrementalVertexCover build") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    const auto weight = unit_weight(hyprgraph);
+    auto coverset = py::set<node_t>{};
+    const auto cost = min_vertex_cover(hyprgraph, weight, coverset);
+
+    const auto cover = IncrementalVertexCover<int>{hyprgraph, weight};
+    CHECK(cover.primal_cost() == cost);
+    CHECK(cover.dual_cost() <= cover.primal_cost());
+    CHECK(is_cover(hyprgraph, cover));
+}
+
+TEST_CASE("Test IncrementalVertexCover update") {
+    const auto old_hgr = make_netlist(6, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}});
+    auto weight = unit_weight(old_hgr);
+    auto cover = IncrementalVertexCover<int>{old_hgr, weight};
+    CHECK(is_cover(old_hgr, cover));
+
+    // remove the net {2, 3}, change {4, 5} to {4, 5, 6}, add the module 6 and the net {0, 6}
+    const auto new_hgr = make_netlist(7, {{0, 1}, {1, 2}, {3, 4}, {4, 5, 6}, {0, 6}});
+    weight = unit_weight(new_hgr);
+    const auto delta = diff(old_hgr, new_hgr);
+    cover.update(new_hgr, weight, delta);
+    CHECK(is_cover(new_hgr, cover));
+    CHECK(cover.dual_cost() <= cover.primal_cost());
+
+    auto coverset = py::set<node_t>{};
+    cover.export_to(coverset);
+    CHECK(int(coverset.size()) == cover.primal_cost());
+
+    auto fresh = py::set<node_t>{};
+    const auto cost = min_vertex_cover(new_hgr, weight, fresh);
+    CHECK(is_dual_feasible(new_hgr, weight, cover));
+    CHECK(cover.primal_cost() <= cost);
+}
+
+TEST_CASE("Test IncrementalVertexCover weight decrease") {
+    auto old_hgr = make_netlist(4, {{0, 1}, {1, 2}, {2, 3}});
+    old_hgr.module_weight = {4, 4, 4, 4};
+    auto cover = IncrementalVertexCover<int>{old_hgr, module_weights(old_hgr)};
+    CHECK(cover.dual_cost() == 8);
+
+    // module 0 carries a dual load of 4 and gets lighter
+    auto new_hgr = make_netlist(4, {{0, 1}, {1, 2}, {2, 3}});
+    new_hgr.module_weight = {1, 4, 4, 4};
+    const auto weight = module_weights(new_hgr);
+    const auto delta = diff(old_hgr, new_hgr);
+    CHECK(delta.changed_modules == vector<index_t>{0});
+    cover.update(new_hgr, weight, delta);
+    CHECK(is_cover(new_hgr, cover));
+    CHECK(is_dual_feasible(new_hgr, weight, cover));
+    CHECK(cover.dual_cost() == 5);
+}
+
+TEST_CASE("Test IncrementalVertexCover against a full rerun") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    auto rng = mt19937{5};
+    auto old_nets = pin_lists(hyprgraph);
+    auto old_hgr = make_netlist(uint32_t(hyprgraph.number_of_modules()), old_nets);
+    old_hgr.module_weight.resize(hyprgraph.number_of_modules());
+    for (auto &w : old_hgr.module_weight) {
+        w = unsigned(1U + rng() % 10U);
+    }
+    auto cover = IncrementalVertexCover<int>{old_hgr, module_weights(old_hgr)};
+
+    // remove and change some nets, add new ones and make some modules lighter
+    auto new_nets = vector<vector<uint32_t>>{};
+    const auto num_modules = uint32_t(hyprgraph.number_of_modules());
+    for (size_t i = 0; i != old_nets.size(); ++i) {
+        if (i % 50 == 3) {
+            continue;
+        }
+        new_nets.push_back(old_nets[i]);
+        if (i % 61 == 5) {
+            new_nets.back()[0] = uint32_t(rng() % num_modules);
+        }
+    }
+    for (size_t i = 0; i != 20; ++i) {
+        new_nets.push_back({uint32_t(rng() % num_modules), uint32_t(rng() % num_modules)});
+    }
+    auto new_hgr = make_netlist(num_modules, new_nets);
+    new_hgr.module_weight = old_hgr.module_weight;
+    for (size_t v = 0; v < num_modules; v += 50) {
+        new_hgr.module_weight[v] = 1U;
+    }
+    const auto weight = module_weights(new_hgr);
+    CHECK(cover.update(new_hgr, weight, diff(old_hgr, new_hgr)));
+    CHECK(is_cover(new_hgr, cover));
+    CHECK(is_dual_feasible(new_hgr, weight, cover));
+
+    auto fresh = py::set<node_t>{};
+    const auto cost = min_vertex_cover(new_hgr, weight, fresh);
+    CHECK(cover.dual_cost() <= cost);  // a lower bound of the optimum
+    CHECK(double(cover.primal_cost()) <= double(cost) * (1.0 + cover.tolerance));
+}
+
+TEST_CASE("Test IncrementalVertexCover work per update") {
+    // The same local ECO on a short and a long chain visits the same entries
+    auto work = vector<size_t>{};
+    for (const uint32_t n : {1000U, 100000U}) {
+        auto nets = vector<vector<uint32_t>>{};
+        for (uint32_t i = 0; i + 1 < n; ++i) {
+            nets.push_back({i, i + 1});
+        }
+        const auto old_hgr = make_netlist(n, nets);
+        auto cover = IncrementalVertexCover<int>{old_hgr, module_weights(old_hgr)};
+        nets[10] = {10, 12};
+        nets.push_back({3, 7});
+        const auto new_hgr = make_netlist(n, nets);
+        CHECK(cover.update(new_hgr, module_weights(new_hgr), diff(old_hgr, new_hgr)));
+        CHECK(is_cover(new_hgr, cover));
+        work.push_back(cover.work());
+    }
+    CHECK(work[0] != 0U);
+    CHECK(work[1] == work[0]);
+}
+
+TEST_CASE("Test IncrementalVertexCover prune") {
+    const auto old_hgr = make_netlist(3, {{0, 1}, {1, 2}});
+    const auto weight = unit_weight(old_hgr);
+    auto cover = IncrementalVertexCover<int>{old_hgr, weight};
+    // both nets are removed and replaced by a single net {0, 2}
+    const auto new_hgr = make_netlist(3, {{0, 2}});
+    cover.update(new_hgr, weight, diff(old_hgr, new_hgr));
+    CHECK(is_cover(new_hgr, cover));
+    CHECK(cover.primal_cost() == 1);
+}
+
+/**
+ * @brief Whether the matched nets are disjoint and every net touches a matched net
+ */
+static auto is_maximal_matching(const SimpleNetlist &hyprgraph,
+                                const IncrementalMatching<int> &matching) -> bool {
+    const auto base = hyprgraph.number_of_modules();
+    auto covered = vector<int>(base, 0);
+    for (const auto &net : hyprgraph.nets) {
+        if (matching.is_matched(net - base)) {
+            for (const auto &v : hyprgraph.gr[net]) {
+                if (covered[v]++ != 0 || matching.owner(index_t(v)) != net - base) {
+                    return false;
+                }
+            }
+        }
+    }
+    for (const auto &net : hyprgraph.nets) {
+        auto blocked = hyprgraph.gr.degree(net) == 0;
+        for (const auto &v : hyprgraph.gr[net]) {
+            blocked = blocked || covered[v] != 0;
+        }
+        if (!blocked) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static auto unit_net_weight(const SimpleNetlist &hyprgraph) -> py::dict<node_t, int> {
+    auto weight = py::dict<node_t, int>{};
+    for (auto net : hyprgraph.nets) {
+        weight[net] = 1;
+    }
+    return weight;
+}
+
+TEST_CASE("Test IncrementalMatching build") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    const auto weight = unit_net_weight(hyprgraph);
+    auto matchset = py::set<node_t>{};
+    auto dep = py::set<node_t>{};
+    const auto cost = min_maximal_matching(hyprgraph, weight, matchset, dep);
+
+    const auto matching = IncrementalMatching<int>{hyprgraph, weight};
+    CHECK(matching.primal_cost() == cost);
+    CHECK(is_maximal_matching(hyprgraph, matching));
+    auto matchset2 = py::set<node_t>{};
+    auto dep2 = py::set<node_t>{};
+    matching.export_to(hyprgraph, matchset2, dep2);
+    CHECK(matchset2 == matchset);
+    CHECK(dep2 == dep);
+}
+
+TEST_CASE("Test IncrementalMatching update") {
+    const auto old_hgr = make_netlist(6, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}});
+    auto matching = IncrementalMatching<int>{old_hgr, unit_net_weight(old_hgr)};
+    CHECK(is_maximal_matching(old_hgr, matching));
+
+    // remove {0, 1}, change {2, 3} to {2, 6}, add the module 6 and the net {5, 6}
+    const auto new_hgr
+        = make_netlist(7, {{1, 2}, {1, 2}, {2, 6}, {3, 4}, {4, 5}, {5, 6}, {0, 3}});
+    matching.update(new_hgr, unit_net_weight(new_hgr), diff(old_hgr, new_hgr));
+    CHECK(is_maximal_matching(new_hgr, matching));
+}
+
+TEST_CASE("Test IncrementalMatching work per update") {
+    // The same local ECO on a short and a long chain visits the same entries
+    auto work = vector<size_t>{};
+    for (const uint32_t n : {1000U, 100000U}) {
+        auto nets = vector<vector<uint32_t>>{};
+        for (uint32_t i = 0; i + 1 < n; ++i) {
+            nets.push_back({i, i + 1});
+        }
+        const auto old_hgr = make_netlist(n, nets);
+        auto matching = IncrementalMatching<int>{old_hgr, unit_net_weight(old_hgr)};
+        nets[10] = {10, 12};
+        nets.push_back({3, 7});
+        const auto new_hgr = make_netlist(n, nets);
+        matching.update(new_hgr, unit_net_weight(new_hgr), diff(old_hgr, new_hgr));
+        CHECK(is_maximal_matching(new_hgr, matching));
+        work.push_back(matching.work());
+    }
+    CHECK(work[0] != 0U);
+    CHECK(work[1] == work[0]);
+}
+
+TEST_CASE("Test IncrementalMatching moved nets") {
+    const auto old_hgr = make_netlist(6, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}});
+    auto matching = IncrementalMatching<int>{old_hgr, unit_net_weight(old_hgr)};
+    // {0, 1} is removed, so every other net moves down by one
+    const auto new_hgr = make_netlist(6, {{1, 2}, {2, 3}, {3, 4}, {4, 5}, {0, 5}});
+    const auto delta = diff(old_hgr, new_hgr);
+    CHECK(delta.moved_nets.size() == 4);
+    matching.update(new_hgr, unit_net_weight(new_hgr), delta);
+    CHECK(is_maximal_matching(new_hgr, matching));
+
+    auto matchset = py::set<node_t>{};
+    auto dep = py::set<node_t>{};
+    matching.export_to(new_hgr, matchset, dep);
+    CHECK(int(matchset.size()) == matching.primal_cost());
+}
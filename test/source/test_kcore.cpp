@@ -0,0 +1,45 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstdint>                        // for uint32_t
+#include <netlistx/kcore.hpp>             // for core_decomposition, parallel_core_decomposition
+#include <netlistx/netlist.hpp>           // for SimpleNetlist
+#include <vector>                         // for vector
+
+using namespace std;
+
+extern auto make_netlist(uint32_t num_modules, const vector<vector<uint32_t>> &net_list)
+    -> SimpleNetlist;  // import make_netlist
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+TEST_CASE("Test core_decomposition") {
+    // a triangle {0, 1, 2}, a tail 2 - 3 - 4, a 3-pin net {1, 2, 5} and a single-pin net {6}
+    const auto hyprgraph
+        = make_netlist(7, {{0, 1}, {1, 2}, {0, 2}, {2, 3}, {3, 4}, {1, 2, 5}, {6}});
+    const auto result = core_decomposition(hyprgraph);
+    CHECK(result.core == vector<index_t>{2, 2, 2, 1, 1, 1, 0});
+    CHECK(result.max_core == 2);
+    CHECK(result.order.size() == 7);
+    CHECK(result.order[0] == 6);
+
+    const auto presult = parallel_core_decomposition(hyprgraph);
+    CHECK(presult.core == result.core);
+    CHECK(presult.max_core == 2);
+}
+
+TEST_CASE("Test core_decomposition ibm01") {
+    const auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    const auto result = core_decomposition(hyprgraph);
+    const auto presult = parallel_core_decomposition(hyprgraph);
+    CHECK(presult.core == result.core);
+    CHECK(presult.max_core == result.max_core);
+    CHECK(result.max_core <= hyprgraph.get_max_degree());
+
+    // cores never decrease along the peeling order
+    auto ok = true;
+    for (size_t i = 1; i < result.order.size(); ++i) {
+        ok = ok && result.core[result.order[i - 1]] <= result.core[result.order[i]];
+    }
+    CHECK(ok);
+}
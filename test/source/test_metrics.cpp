@@ -0,0 +1,100 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <cstdint>                // for uint64_t
+#include <netlistx/metrics.hpp>   // for MetricsRegistry, Histogram, MetricsServer
+#include <netlistx/parallel.hpp>  // for parallel_blocks
+#include <string>                 // for string
+
+#if !defined(_WIN32)
+#    include <arpa/inet.h>   // for htonl, htons
+#    include <netinet/in.h>  // for sockaddr_in, INADDR_LOOPBACK
+#    include <sys/socket.h>  // for socket, connect, recv, send
+#    include <unistd.h>      // for close
+#endif
+
+using namespace std;
+
+TEST_CASE("Test Histogram buckets") {
+    for (auto value : {uint64_t{0}, uint64_t{15}, uint64_t{16}, uint64_t{1000}, uint64_t{123456789},
+                       ~uint64_t{0}}) {
+        const auto b = Histogram::bucket_of(value);
+        CHECK(b < Histogram::num_buckets);
+        CHECK(value <= Histogram::upper_bound_of(b));
+        CHECK(b == 0U || Histogram::upper_bound_of(b - 1U) < value);
+        // relative precision of 1/16
+        CHECK(double(Histogram::upper_bound_of(b) - value) <= double(value) / 16.0);
+    }
+
+    auto histogram = Histogram{};
+    for (uint64_t v = 1; v <= 10000; ++v) {
+        histogram.record(v);
+    }
+    const auto snapshot = histogram.snapshot();
+    CHECK(snapshot.count == 10000U);
+    CHECK(snapshot.sum == 10000U * 10001U / 2U);
+    CHECK(snapshot.quantile(0.0) == 1U);
+    const auto median = double(snapshot.quantile(0.5));
+    CHECK(median >= 5000.0);
+    CHECK(median <= 5000.0 * 17.0 / 16.0);
+    CHECK(snapshot.quantile(1.0) >= 10000U);
+}
+
+TEST_CASE("Test MetricsRegistry") {
+    auto registry = MetricsRegistry{};
+    auto &requests = registry.counter("netlistx_requests_total", "Requests", {{"type", "read"}});
+    auto &latency = registry.histogram("netlistx_request_seconds", "Latency", {}, 1e-9);
+    auto &queue = registry.gauge("netlistx_queue_depth", "Queued requests");
+    CHECK(&registry.counter("netlistx_requests_total", "Requests", {{"type", "read"}})
+          == &requests);
+    CHECK_THROWS(registry.gauge("netlistx_requests_total", "Requests"));
+
+    parallel_blocks(0, 80000, 8, [&](size_t, size_t lo, size_t hi) {
+        for (auto i = lo; i != hi; ++i) {
+            requests.inc();
+            latency.record(1000U + i % 3000U);
+        }
+    });
+    queue.set(3);
+    CHECK(requests.value() == 80000U);
+    CHECK(latency.snapshot().count == 80000U);
+
+    const auto text = registry.render();
+    CHECK(text.find("# TYPE netlistx_requests_total counter\n") != string::npos);
+    CHECK(text.find("netlistx_requests_total{type=\"read\"} 80000\n") != string::npos);
+    CHECK(text.find("netlistx_queue_depth 3\n") != string::npos);
+    CHECK(text.find("# TYPE netlistx_request_seconds histogram\n") != string::npos);
+    CHECK(text.find("netlistx_request_seconds_bucket{le=\"1.023e-06\"}") != string::npos);
+    CHECK(text.find("netlistx_request_seconds_bucket{le=\"+Inf\"} 80000\n") != string::npos);
+    CHECK(text.find("netlistx_request_seconds_count 80000\n") != string::npos);
+}
+
+#if !defined(_WIN32)
+TEST_CASE("Test MetricsServer") {
+    auto registry = MetricsRegistry{};
+    registry.counter("netlistx_scrapes_total", "Scrapes").inc(7);
+    auto server = MetricsServer{registry};
+    REQUIRE(server.start(0));
+    CHECK(server.port() != 0U);
+
+    const auto fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(fd >= 0);
+    auto addr = sockaddr_in{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(server.port());
+    REQUIRE(::connect(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof addr) == 0);
+    const auto request = string{"GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n"};
+    CHECK(::send(fd, request.data(), request.size(), 0) == ssize_t(request.size()));
+    auto response = string{};
+    char buffer[1024];
+    for (auto n = ::recv(fd, buffer, sizeof buffer, 0); n > 0;
+         n = ::recv(fd, buffer, sizeof buffer, 0)) {
+        response.append(buffer, size_t(n));
+    }
+    ::close(fd);
+    CHECK(response.rfind("HTTP/1.1 200 OK\r\n", 0) == 0);
+    CHECK(response.find("netlistx_scrapes_total 7\n") != string::npos);
+    server.stop();
+}
+#endif
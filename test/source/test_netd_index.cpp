@@ -0,0 +1,149 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <filesystem>                     // for temp_directory_path, copy_file, exists
+#include <fstream>                        // for ifstream, ofstream
+#include <iterator>                       // for istreambuf_iterator, distance
+#include <netlistx/netd_index.hpp>        // for NetDIndex, buildNetDIndex, readNetDNets
+#include <netlistx/netlist.hpp>           // for SimpleNetlist
+#include <string>                         // for string
+#include <vector>                         // for vector
+
+using namespace std;
+
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+/**
+ * @brief Whether net `i` of `sub` has the pins of net `first + i` of `full`, for every net
+ */
+static auto same_nets(const SimpleNetlist &full, const SimpleNetlist &sub, index_t first) -> bool {
+    const auto num_modules = index_t(full.number_of_modules());
+    if (sub.number_of_modules() != full.number_of_modules()) {
+        return false;
+    }
+    for (index_t i = 0; i != index_t(sub.number_of_nets()); ++i) {
+        const auto &pins = sub.gr[num_modules + i];
+        const auto &expected = full.gr[num_modules + first + i];
+        if (pins.size() != expected.size()) {
+            return false;
+        }
+        for (const auto &v : pins) {
+            if (!expected.contains(v)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+TEST_CASE("Test NetDIndex (ibm01)") {
+    const auto netDFileName = "../../testcases/ibm01.net";
+    const auto hyprgraph = readNetD(netDFileName);
+    auto index = NetDIndex{};
+    REQUIRE(buildNetDIndex(netDFileName, index));
+    CHECK(index.num_modules == hyprgraph.number_of_modules());
+    CHECK(index.num_nets == hyprgraph.number_of_nets());
+    CHECK(index.net_offsets.size() == hyprgraph.number_of_nets() + 1);
+
+    const auto whole = readNetDNets(netDFileName, index, 0, index.num_nets);
+    CHECK(whole.number_of_nets() == hyprgraph.number_of_nets());
+    CHECK(whole.get_max_degree() == hyprgraph.get_max_degree());
+    CHECK(whole.num_pads == hyprgraph.num_pads);
+    CHECK(same_nets(hyprgraph, whole, 0));
+
+    const auto sub = readNetDNets(netDFileName, index, 5000, 5100);
+    CHECK(sub.number_of_nets() == 100);
+    CHECK(same_nets(hyprgraph, sub, 5000));
+
+    // Every net with a pin in [100, 120] is in one of the returned ranges
+    const auto ranges = index.nets_touching(100, 120);
+    auto covered = true;
+    const auto num_modules = index_t(hyprgraph.number_of_modules());
+    for (const auto &net : hyprgraph.nets) {
+        auto touches = false;
+        for (const auto &v : hyprgraph.gr[net]) {
+            touches = touches || (v >= 100 && v <= 120);
+        }
+        const auto offset = net - num_modules;
+        auto inside = false;
+        for (const auto &range : ranges) {
+            inside = inside || (offset >= range.first && offset < range.second);
+        }
+        covered = covered && (!touches || inside);
+    }
+    CHECK(covered);
+    CHECK(!ranges.empty());
+}
+
+TEST_CASE("Test NetDIndex sidecar") {
+    const auto dir = filesystem::temp_directory_path() / "netlistx_test_netd_index";
+    filesystem::remove_all(dir);
+    filesystem::create_directories(dir);
+    const auto netDFileName = (dir / "dwarf1.netD").string();
+    filesystem::copy_file("../../testcases/dwarf1.netD", netDFileName);
+
+    auto index = NetDIndex{};
+    REQUIRE(loadNetDIndex(netDFileName, index));
+    CHECK(filesystem::exists(netDFileName + ".idx"));
+    auto stored = NetDIndex{};
+    REQUIRE(readNetDIndex(netDFileName + ".idx", stored));
+    CHECK(stored.net_offsets == index.net_offsets);
+    CHECK(stored.module_ranges == index.module_ranges);
+    CHECK(stored.num_pins == 13);
+    CHECK(stored.num_nets == 5);
+
+    const auto hyprgraph = readNetDNets(netDFileName, stored, 1, 3);
+    CHECK(same_nets(readNetD(netDFileName), hyprgraph, 1));
+
+    // A same-size edit (net 4 now starts at a0 instead of a3), even with the old time, is seen
+    const auto mtime = filesystem::last_write_time(netDFileName);
+    auto content = string{};
+    {
+        auto in = ifstream{netDFileName, ios::binary};
+        content.assign(istreambuf_iterator<char>{in}, istreambuf_iterator<char>{});
+    }
+    const auto pos = content.find("a3 s O");
+    REQUIRE(pos != string::npos);
+    content[pos + 1] = '0';
+    {
+        auto out = ofstream{netDFileName, ios::binary | ios::trunc};
+        out << content;
+    }
+    filesystem::last_write_time(netDFileName, mtime);
+    REQUIRE(loadNetDIndex(netDFileName, index));
+    CHECK(index.content_hash != stored.content_hash);
+    REQUIRE(readNetDIndex(netDFileName + ".idx", stored));
+    CHECK(stored.content_hash == index.content_hash);
+    CHECK(same_nets(readNetD(netDFileName), readNetDNets(netDFileName, stored, 0, 5), 0));
+
+    // The sidecar is renamed into place, no temporary file is left
+    CHECK(distance(filesystem::directory_iterator{dir}, filesystem::directory_iterator{}) == 2);
+    filesystem::remove_all(dir);
+}
+
+TEST_CASE("Test probe") {
+    const auto exact = probe("../../testcases/ibm01.net");
+    CHECK(exact.exact);
+    CHECK(exact.num_modules == 12752);
+    CHECK(exact.num_sampled_nets == exact.num_nets);
+    CHECK(exact.num_sampled_pins == exact.num_pins);
+    CHECK(exact.mean_net_degree == doctest::Approx(50566.0 / 14111.0));
+    CHECK(exact.estimated_pins == doctest::Approx(50566.0));
+
+    const auto hyprgraph = readNetD("../../testcases/ibm03.netD");
+    auto num_pins = 0.0;
+    for (const auto &net : hyprgraph.nets) {
+        num_pins += double(hyprgraph.gr.degree(net));
+    }
+    const auto mean_degree = num_pins / double(hyprgraph.number_of_nets());
+    const auto sampled = probe("../../testcases/ibm03.netD", 24, 4096, 7);
+    CHECK(!sampled.exact);
+    CHECK(sampled.num_windows == 24);
+    CHECK(sampled.num_sampled_nets > 100);
+    CHECK(sampled.mean_net_degree_low <= sampled.mean_net_degree);
+    CHECK(sampled.mean_net_degree <= sampled.mean_net_degree_high);
+    CHECK(sampled.mean_net_degree == doctest::Approx(mean_degree).epsilon(0.2));
+    CHECK(sampled.estimated_pins == doctest::Approx(num_pins).epsilon(0.2));
+    CHECK(sampled.degree_distribution.size() == 65);
+}
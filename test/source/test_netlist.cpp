@@ -89,6 +89,25 @@ auto create_test_netlist() -> SimpleNetlist {
     return hyprgraph;
 }
 
+/**
+ * @brief Create a netlist from a list of pin lists (module ids per net)
+ *
+ * @param[in] num_modules The number of modules
+ * @param[in] net_list The modules of every net
+ * @return SimpleNetlist
+ */
+auto make_netlist(uint32_t num_modules, const vector<vector<uint32_t>> &net_list)
+    -> SimpleNetlist {
+    const auto num_nets = uint32_t(net_list.size());
+    graph_t g(num_modules + num_nets);
+    for (uint32_t i = 0; i != num_nets; ++i) {
+        for (const auto v : net_list[i]) {
+            g.add_edge(v, num_modules + i);
+        }
+    }
+    return SimpleNetlist{std::move(g), num_modules, num_nets};
+}
+
 TEST_CASE("Test Netlist") {
     const auto hyprgraph = create_test_netlist();
 
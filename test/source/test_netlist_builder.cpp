@@ -0,0 +1,76 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstdint>                        // for uint32_t
+#include <netlistx/netlist.hpp>           // for SimpleNetlist
+#include <netlistx/netlist_builder.hpp>   // for NetlistBuilder, ValidationReport
+#include <vector>                         // for vector
+
+using namespace std;
+
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+TEST_CASE("Test NetlistBuilder") {
+    auto builder = NetlistBuilder{5, 4};
+    builder.add_pin(0, 0);
+    builder.add_pin(1, 0);
+    builder.add_pin(0, 0);  // duplicate
+    builder.add_pin(1, 2);
+    builder.add_pin(2, 2);
+    builder.add_pin(1, 2);  // duplicate
+    builder.add_pin(3, 3);
+
+    const auto &report = builder.validate();
+    CHECK(report.ok());
+    CHECK(report.num_pins == 7);
+    CHECK(report.num_duplicate_pins == 2);
+    CHECK(report.empty_nets == vector<index_t>{1});
+    CHECK(report.isolated_modules == vector<index_t>{4});
+
+    const auto hyprgraph = builder.build();
+    CHECK(hyprgraph.number_of_modules() == 5);
+    CHECK(hyprgraph.number_of_nets() == 4);
+    CHECK(hyprgraph.gr.degree(1) == 2);
+    CHECK(hyprgraph.gr.degree(5) == 2);
+    CHECK(hyprgraph.gr.degree(6) == 0);
+}
+
+TEST_CASE("Test NetlistBuilder (out of range)") {
+    auto builder = NetlistBuilder{3, 2};
+    builder.add_pin(0, 0);
+    builder.add_pin(3, 0);  // no such module
+    builder.add_pin(1, 2);  // no such net
+    builder.add_pin(2, 1);
+    const auto &report = builder.validate();
+    CHECK(!report.ok());
+    CHECK(report.num_out_of_range_pins == 2);
+    CHECK(report.num_duplicate_pins == 0);
+    CHECK(report.isolated_modules == vector<index_t>{1});
+
+    builder.set_number_of_nets(3);
+    CHECK(builder.validate().num_out_of_range_pins == 1);
+}
+
+TEST_CASE("Test NetlistBuilder (ibm01)") {
+    const auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    const auto num_modules = uint32_t(hyprgraph.number_of_modules());
+    auto builder = NetlistBuilder{num_modules, uint32_t(hyprgraph.number_of_nets())};
+    for (const auto &net : hyprgraph.nets) {
+        for (const auto &v : hyprgraph.gr[net]) {
+            builder.add_pin(v, net - num_modules);
+            builder.add_pin(v, net - num_modules);
+        }
+    }
+    const auto &report = builder.validate();
+    CHECK(report.ok());
+    CHECK(report.num_duplicate_pins * 2 == report.num_pins);
+    const auto rebuilt = builder.build();
+    CHECK(rebuilt.get_max_degree() == hyprgraph.get_max_degree());
+    CHECK(rebuilt.get_max_net_degree() == hyprgraph.get_max_net_degree());
+    auto same = true;
+    for (const auto &v : hyprgraph.gr) {
+        same = same && rebuilt.gr.degree(v) == hyprgraph.gr.degree(v);
+    }
+    CHECK(same);
+}
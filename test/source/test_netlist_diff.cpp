@@ -0,0 +1,87 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <cstdint>                    // for uint32_t
+#include <netlistx/netlist.hpp>       // for SimpleNetlist, graph_t
+#include <netlistx/netlist_diff.hpp>  // for diff, EcoDelta
+#include <utility>                    // for pair
+#include <vector>                     // for vector
+
+using namespace std;
+
+extern auto create_dwarf() -> SimpleNetlist;  // import create_dwarf
+extern auto make_netlist(uint32_t num_modules, const vector<vector<uint32_t>> &net_list)
+    -> SimpleNetlist;  // import make_netlist
+
+TEST_CASE("Test diff identical") {
+    const auto hyprgraph = create_dwarf();
+    const auto delta = diff(hyprgraph, create_dwarf());
+    CHECK(delta.empty());
+    CHECK(delta.touched_modules.empty());
+    CHECK(delta.net_map.size() == 6);
+    CHECK(delta.net_map[0] == 7);
+    CHECK(delta.net_map[5] == 12);
+}
+
+TEST_CASE("Test diff moved nets") {
+    const auto old_hgr = make_netlist(4, {{0, 1}, {1, 2, 3}, {0, 3}});
+    const auto new_hgr = make_netlist(4, {{0, 3}, {0, 1}, {3, 2, 1}});
+    const auto delta = diff(old_hgr, new_hgr);
+    CHECK(delta.empty());
+    CHECK(delta.net_map[0] == 5);
+    CHECK(delta.net_map[1] == 6);
+    CHECK(delta.net_map[2] == 4);
+    CHECK(delta.moved_nets == vector<pair<index_t, index_t>>{{4, 5}, {5, 6}, {6, 4}});
+    CHECK(delta.old_pins.size() == 0);
+}
+
+TEST_CASE("Test diff ECO") {
+    const auto old_hgr = make_netlist(4, {{0, 1}, {1, 2, 3}, {0, 3}, {2, 3}});
+    // nets 1 and 3 change, a new module 4 and a new net are added
+    const auto new_hgr = make_netlist(5, {{0, 1}, {2, 3, 4}, {0, 3}, {1, 4}, {0, 2}});
+    const auto delta = diff(old_hgr, new_hgr);
+    CHECK(!delta.empty());
+    CHECK(delta.added_modules == vector<index_t>{4});
+    CHECK(delta.removed_modules.empty());
+    REQUIRE(delta.changed_nets.size() == 2);
+    CHECK(delta.changed_nets[0] == pair<index_t, index_t>{5, 6});
+    CHECK(delta.changed_nets[1] == pair<index_t, index_t>{7, 8});
+    CHECK(delta.added_nets == vector<index_t>{9});
+    CHECK(delta.removed_nets.empty());
+    CHECK(delta.net_map == vector<index_t>{5, 6, 7, 8});
+    CHECK(delta.touched_modules == vector<index_t>{0, 1, 2, 3, 4});
+    CHECK(delta.moved_nets.empty());
+    REQUIRE(delta.old_pins.size() == 2);
+    CHECK(vector<index_t>(delta.old_pins[0].begin(), delta.old_pins[0].end())
+          == vector<index_t>{1, 2, 3});
+    CHECK(vector<index_t>(delta.old_pins[1].begin(), delta.old_pins[1].end())
+          == vector<index_t>{2, 3});
+}
+
+TEST_CASE("Test diff weights") {
+    const auto old_hgr = create_dwarf();
+    auto new_hgr = create_dwarf();
+    new_hgr.module_weight[2] = 7;
+    const auto delta = diff(old_hgr, new_hgr);
+    CHECK(delta.changed_modules == vector<index_t>{2});
+    CHECK(delta.touched_modules == vector<index_t>{2});
+    CHECK(delta.changed_nets.empty());
+}
+
+TEST_CASE("Test diff many identical nets") {
+    // Parallel 2-pin nets that all moved: every one goes through the same join bucket
+    const size_t num_nets = 20000;
+    auto old_nets = vector<vector<uint32_t>>{};
+    auto new_nets = vector<vector<uint32_t>>{};
+    for (size_t i = 0; i != num_nets; ++i) {
+        old_nets.push_back(i % 2 == 0 ? vector<uint32_t>{0, 1} : vector<uint32_t>{2, 3});
+        new_nets.push_back(i % 2 == 0 ? vector<uint32_t>{2, 3} : vector<uint32_t>{0, 1});
+    }
+    const auto delta = diff(make_netlist(4, old_nets), make_netlist(4, new_nets));
+    CHECK(delta.empty());
+    auto hit = vector<uint32_t>(num_nets, 0U);
+    for (const auto net : delta.net_map) {
+        ++hit[net - 4];
+    }
+    CHECK(hit == vector<uint32_t>(num_nets, 1U));
+}
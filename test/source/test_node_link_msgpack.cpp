@@ -0,0 +1,73 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <boost/utility/string_view.hpp>   // for boost::string_view
+#include <cstdint>                         // for uint8_t
+#include <filesystem>                      // for temp_directory_path, remove_all
+#include <netlistx/csr.hpp>                // for net_pins_csr
+#include <netlistx/netlist.hpp>            // for SimpleNetlist
+#include <netlistx/node_link_msgpack.hpp>  // for encodeMsgPack, decodeMsgPack, readMsgPack
+#include <vector>                          // for vector
+
+using namespace std;
+
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+static void check_same(const SimpleNetlist &lhs, const SimpleNetlist &rhs) {
+    CHECK(lhs.number_of_modules() == rhs.number_of_modules());
+    CHECK(lhs.number_of_nets() == rhs.number_of_nets());
+    CHECK(lhs.num_pads == rhs.num_pads);
+    CHECK(lhs.get_max_degree() == rhs.get_max_degree());
+    CHECK(lhs.get_max_net_degree() == rhs.get_max_net_degree());
+    const auto lhs_pins = net_pins_csr(lhs);
+    const auto rhs_pins = net_pins_csr(rhs);
+    CHECK(lhs_pins.offsets == rhs_pins.offsets);
+    CHECK(lhs_pins.targets == rhs_pins.targets);
+}
+
+TEST_CASE("Test MessagePack node-link round trip") {
+    const auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    const auto bytes = encodeMsgPack(hyprgraph);
+    auto num_pins = size_t{0};
+    for (const auto &v : hyprgraph) {
+        num_pins += hyprgraph.gr.degree(v);
+    }
+    // at most 3 + 3 bytes per link (uint16 ids) plus one id per node
+    CHECK(bytes.size() < 6U * num_pins + 3U * hyprgraph.number_of_nodes() + 128U);
+
+    const auto decoded = decodeMsgPack(bytes.data(), bytes.size());
+    REQUIRE(decoded.has_value());
+    check_same(hyprgraph, *decoded);
+
+    const auto dir = filesystem::temp_directory_path() / "netlistx_test_msgpack";
+    filesystem::remove_all(dir);
+    filesystem::create_directories(dir);
+    const auto file = (dir / "ibm01.msgpack").string();
+    writeMsgPack(file, hyprgraph);
+    check_same(hyprgraph, readMsgPack(file));
+    filesystem::remove_all(dir);
+}
+
+TEST_CASE("Test MessagePack node-link (per-link maps)") {
+    // {"graph": {"num_modules": 2, "num_nets": 1, "extra": [nil, 1.5]},
+    //  "nodes": [{"id": 0}, {"id": 1}, {"id": 2}],
+    //  "links": [{"source": 0, "target": 2}, {"source": 2, "target": 1, "key": 0}]}
+    const auto bytes = vector<unsigned char>{
+        0x83, 0xa5, 'g', 'r', 'a', 'p', 'h', 0x83, 0xab, 'n', 'u', 'm', '_', 'm', 'o', 'd', 'u',
+        'l', 'e', 's', 0x02, 0xa8, 'n', 'u', 'm', '_', 'n', 'e', 't', 's', 0x01, 0xa5, 'e', 'x',
+        't', 'r', 'a', 0x92, 0xc0, 0xcb, 0x3f, 0xf8, 0, 0, 0, 0, 0, 0, 0xa5, 'n', 'o', 'd', 'e',
+        's', 0x93, 0x81, 0xa2, 'i', 'd', 0x00, 0x81, 0xa2, 'i', 'd', 0x01, 0x81, 0xa2, 'i', 'd',
+        0x02, 0xa5, 'l', 'i', 'n', 'k', 's', 0x92, 0x82, 0xa6, 's', 'o', 'u', 'r', 'c', 'e', 0x00,
+        0xa6, 't', 'a', 'r', 'g', 'e', 't', 0x02, 0x83, 0xa6, 's', 'o', 'u', 'r', 'c', 'e', 0x02,
+        0xa6, 't', 'a', 'r', 'g', 'e', 't', 0x01, 0xa3, 'k', 'e', 'y', 0x00};
+    const auto decoded = decodeMsgPack(bytes.data(), bytes.size());
+    REQUIRE(decoded.has_value());
+    CHECK(decoded->number_of_modules() == 2);
+    CHECK(decoded->number_of_nets() == 1);
+    CHECK(decoded->gr.degree(2) == 2);
+
+    // Every truncation is rejected
+    for (size_t size = 0; size != bytes.size(); ++size) {
+        CHECK(!decodeMsgPack(bytes.data(), size).has_value());
+    }
+}
@@ -0,0 +1,68 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstdint>                        // for uint8_t, uint64_t
+#include <netlistx/netlist.hpp>           // for SimpleNetlist
+#include <netlistx/parallel_fm.hpp>       // for GainCache, parallel_fm
+#include <netlistx/partition.hpp>         // for block_weights, connectivity_cost
+#include <vector>                         // for vector
+
+using namespace std;
+
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+TEST_CASE("Test GainCache delta updates") {
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    const auto num_modules = hyprgraph.number_of_modules();
+    auto part = vector<uint8_t>(num_modules);
+    for (size_t v = 0; v != num_modules; ++v) {
+        part[v] = uint8_t(v % 3);
+    }
+    auto cache = GainCache{};
+    cache.init(hyprgraph, part, 3);
+    for (size_t i = 0; i != 200; ++i) {
+        const auto v = index_t(i * 7919 % num_modules);
+        const auto to = uint8_t((part[v] + 1 + i % 2) % 3);
+        const auto before = connectivity_cost(hyprgraph, part, 3);
+        const auto gain = cache.gain(v, to);
+        CHECK(cache.move(hyprgraph, part, v, to) == gain);
+        CHECK(static_cast<long long>(before - connectivity_cost(hyprgraph, part, 3)) == gain);
+    }
+    auto fresh = GainCache{};
+    fresh.init(hyprgraph, part, 3);
+    auto same = true;
+    for (index_t v = 0; v != num_modules; ++v) {
+        for (size_t b = 0; b != 3; ++b) {
+            same = same && (b == part[v] || cache.gain(v, b) == fresh.gain(v, b));
+        }
+    }
+    CHECK(same);
+}
+
+TEST_CASE("Test parallel_fm") {
+    const auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    const auto num_modules = hyprgraph.number_of_modules();
+    auto initial = vector<uint8_t>(num_modules);
+    for (size_t v = 0; v != num_modules; ++v) {
+        initial[v] = uint8_t(v % 2);
+    }
+    const auto initial_cost = connectivity_cost(hyprgraph, initial, 2);
+
+    auto costs = vector<uint64_t>{};
+    for (const auto num_threads : {size_t{1}, size_t{4}}) {
+        auto part = initial;
+        auto options = ParallelFmOptions{};
+        options.num_threads = num_threads;
+        const auto stats = parallel_fm(hyprgraph, part, options);
+        const auto cost = connectivity_cost(hyprgraph, part, 2);
+        CHECK(stats.gain == initial_cost - cost);
+        CHECK(stats.num_moves > 0);
+        const auto weights = block_weights(hyprgraph, part, 2);
+        CHECK(weights[0] <= num_modules * 11 / 20 + 1);
+        CHECK(weights[1] <= num_modules * 11 / 20 + 1);
+        costs.push_back(cost);
+    }
+    CHECK(costs[0] < initial_cost / 2);
+    CHECK(costs[1] < initial_cost / 2);
+}
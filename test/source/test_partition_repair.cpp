@@ -0,0 +1,98 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstdint>                        // for uint32_t, uint8_t
+#include <netlistx/netlist.hpp>           // for SimpleNetlist
+#include <netlistx/netlist_diff.hpp>      // for diff
+#include <netlistx/partition.hpp>         // for connectivity_cost, block_weights
+#include <netlistx/partition_repair.hpp>  // for repair_partition
+#include <vector>                         // for vector
+
+using namespace std;
+
+extern auto make_netlist(uint32_t num_modules, const vector<vector<uint32_t>> &net_list)
+    -> SimpleNetlist;  // import make_netlist
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+/**
+ * @brief Get the pin lists of all nets of a netlist
+ */
+static auto net_list_of(const SimpleNetlist &hyprgraph) -> vector<vector<uint32_t>> {
+    auto net_list = vector<vector<uint32_t>>{};
+    for (const auto &net : hyprgraph.nets) {
+        net_list.emplace_back(hyprgraph.gr[net].begin(), hyprgraph.gr[net].end());
+    }
+    return net_list;
+}
+
+TEST_CASE("Test connectivity_cost") {
+    const auto hyprgraph = make_netlist(4, {{0, 1}, {1, 2, 3}, {0, 3}});
+    CHECK(connectivity_cost(hyprgraph, {0, 0, 1, 1}, 2) == 2);
+    CHECK(connectivity_cost(hyprgraph, {0, 1, 2, 0}, 3) == 3);
+    CHECK(block_weights(hyprgraph, {0, 0, 1, 1}, 2) == vector<uint64_t>{2, 2});
+}
+
+TEST_CASE("Test repair_partition") {
+    const auto old_hgr = readNetD("../../testcases/p1.net");
+    const auto num_modules = uint32_t(old_hgr.number_of_modules());
+    auto net_list = net_list_of(old_hgr);
+    // ECO: two new modules connected to modules from both halves, and a rewired net
+    net_list.push_back({0, 500, num_modules});
+    net_list.push_back({num_modules, num_modules + 1, 10});
+    net_list[3] = {20, 700};
+    const auto new_hgr = make_netlist(num_modules + 2, net_list);
+    const auto delta = diff(old_hgr, new_hgr);
+
+    auto old_part = vector<uint8_t>(num_modules);
+    for (uint32_t v = 0; v != num_modules; ++v) {
+        old_part[v] = uint8_t(v * 2 / num_modules);
+    }
+    auto options = RepairOptions{};
+    options.max_passes = 0;
+    auto greedy = old_part;
+    repair_partition(new_hgr, delta, greedy, options);
+    CHECK(greedy.size() == new_hgr.number_of_modules());
+
+    options.max_passes = 4;
+    auto part = old_part;
+    const auto stats = repair_partition(new_hgr, delta, part, options);
+    CHECK(stats.region_size < num_modules);
+    CHECK(connectivity_cost(new_hgr, part, 2) + uint64_t(stats.gain)
+          == connectivity_cost(new_hgr, greedy, 2));
+    const auto weights = block_weights(new_hgr, part, 2);
+    for (const auto w : weights) {
+        CHECK(double(w) <= 1.1 * double(new_hgr.number_of_modules()) / 2 + 1);
+    }
+    auto moved = 0U;
+    for (uint32_t v = 0; v != num_modules; ++v) {
+        moved += part[v] != old_part[v] ? 1U : 0U;
+    }
+    CHECK(moved <= stats.num_moves);
+}
+
+TEST_CASE("Test repair_partition (256 blocks)") {
+    // One module per block; every block id is in use, so none can mark the new module
+    auto net_list = vector<vector<uint32_t>>{};
+    for (uint32_t v = 0; v + 1 != 256; ++v) {
+        net_list.push_back({v, v + 1});
+    }
+    const auto old_hgr = make_netlist(256, net_list);
+    net_list.push_back({256, 5, 6});
+    const auto new_hgr = make_netlist(257, net_list);
+    const auto delta = diff(old_hgr, new_hgr);
+
+    auto part = vector<uint8_t>(256);
+    for (uint32_t v = 0; v != 256; ++v) {
+        part[v] = uint8_t(v);
+    }
+    auto options = RepairOptions{};
+    options.num_parts = 256;
+    options.max_passes = 0;
+    repair_partition(new_hgr, delta, part, options);
+    REQUIRE(part.size() == 257);
+    CHECK(part[256] == 5);
+    const auto weights = block_weights(new_hgr, part, 256);
+    CHECK(weights[0] == 1);
+    CHECK(weights[5] == 2);
+}
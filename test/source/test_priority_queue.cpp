@@ -0,0 +1,141 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <algorithm>                    // for max, min, is_sorted
+#include <cstdint>                      // for uint64_t
+#include <functional>                   // for greater
+#include <map>                          // for map
+#include <netlistx/priority_queue.hpp>  // for BucketQueue, DaryHeap, RadixHeap
+#include <random>                       // for mt19937
+#include <vector>                       // for vector
+
+using namespace std;
+
+// Random pushes, updates, removes and pops, checked against a map of the queued keys
+template <typename Queue, typename Key, typename KeyFn>
+static auto random_operations(Queue &queue, size_t num_items, KeyFn random_key, bool is_max)
+    -> bool {
+    auto rng = mt19937{42};
+    auto reference = map<index_t, Key>{};
+    auto extreme = [&]() {
+        auto best = reference.begin()->second;
+        for (const auto &entry : reference) {
+            best = is_max ? max(best, entry.second) : min(best, entry.second);
+        }
+        return best;
+    };
+    for (size_t i = 0; i != 20000; ++i) {
+        const auto v = index_t(rng() % num_items);
+        const auto op = rng() % 4;
+        if (queue.contains(v) != (reference.count(v) != 0U)) {
+            return false;
+        }
+        if (op == 3 && !queue.empty()) {
+            const auto expected = extreme();
+            const auto u = queue.pop();
+            if (reference.count(u) == 0U || reference[u] != expected) {
+                return false;
+            }
+            reference.erase(u);
+        } else if (!queue.contains(v)) {
+            const auto key = random_key(rng);
+            queue.push(v, key);
+            reference[v] = key;
+        } else if (op == 0) {
+            queue.remove(v);
+            reference.erase(v);
+        } else {
+            const auto key = random_key(rng);
+            queue.update(v, key);
+            reference[v] = key;
+        }
+        if (queue.size() != reference.size()) {
+            return false;
+        }
+    }
+    while (!queue.empty()) {
+        const auto expected = extreme();
+        const auto u = queue.pop();
+        if (reference[u] != expected) {
+            return false;
+        }
+        reference.erase(u);
+    }
+    return reference.empty();
+}
+
+TEST_CASE("Test BucketQueue") {
+    auto queue = BucketQueue{100, 10};
+    queue.push(3, -2);
+    queue.push(5, 7);
+    queue.push(8, 7);
+    CHECK(queue.contains(5));
+    CHECK(!queue.contains(4));
+    CHECK(queue.key(3) == -2);
+    queue.update(3, 10);
+    CHECK(queue.top() == 3);
+    queue.remove(3);
+    const auto first = queue.pop();
+    CHECK((first == 5 || first == 8));
+    queue.clear();
+    CHECK(queue.empty());
+
+    auto random = BucketQueue{500, 64};
+    CHECK(random_operations<BucketQueue, long long>(
+        random, 500, [](mt19937 &rng) { return static_cast<long long>(rng() % 129) - 64; }, true));
+}
+
+TEST_CASE("Test DaryHeap") {
+    auto heap = DaryHeap<long long>{100};
+    heap.push(1, 4);
+    heap.push(2, 9);
+    heap.push(3, 1);
+    CHECK(heap.top() == 2);
+    heap.update(3, 12);
+    CHECK(heap.top() == 3);
+    heap.remove(3);
+    CHECK(heap.pop() == 2);
+    CHECK(heap.size() == 1);
+
+    auto random = DaryHeap<long long>{500};
+    auto random_key = [](mt19937 &rng) { return static_cast<long long>(rng() % 1000) - 500; };
+    CHECK(random_operations<DaryHeap<long long>, long long>(random, 500, random_key, true));
+    auto binary = DaryHeap<double, 2, greater<double>>{500};  // a binary min-heap
+    CHECK(random_operations<DaryHeap<double, 2, greater<double>>, double>(
+        binary, 500, [](mt19937 &rng) { return double(rng() % 1000) / 8.0; }, false));
+}
+
+TEST_CASE("Test RadixHeap") {
+    auto heap = RadixHeap{100};
+    heap.push(1, 40);
+    heap.push(2, 7);
+    heap.push(3, 1000);
+    heap.update(3, 5);
+    CHECK(heap.pop() == 3);
+    CHECK(heap.last_key() == 5);
+    heap.push(4, 5);
+    CHECK(heap.pop() == 4);
+    heap.remove(2);
+    CHECK(heap.pop() == 1);
+    CHECK(heap.empty());
+
+    // A monotone workload: new keys are never below the last popped key
+    auto rng = mt19937{7};
+    auto random = RadixHeap{1000};
+    auto popped = vector<uint64_t>{};
+    for (index_t v = 0; v != 1000; ++v) {
+        if (v % 3 == 2 && !random.empty()) {
+            const auto u = random.pop();
+            popped.push_back(random.key(u));
+        }
+        random.push(v, random.last_key() + rng() % 100000U);
+        if (v % 5 == 0) {
+            random.update(v, random.last_key() + rng() % 1000U);
+        }
+    }
+    while (!random.empty()) {
+        popped.push_back(random.key(random.pop()));
+    }
+    CHECK(popped.size() == 1000);
+    CHECK(is_sorted(popped.begin(), popped.end()));
+}
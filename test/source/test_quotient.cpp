@@ -0,0 +1,118 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstdint>                        // for uint32_t, uint8_t, uint64_t
+#include <netlistx/netlist.hpp>           // for SimpleNetlist
+#include <netlistx/netlist_builder.hpp>   // for NetlistBuilder
+#include <netlistx/partition.hpp>         // for block_weights, connectivity_cost
+#include <netlistx/quotient.hpp>          // for quotient_graph, take_snapshot
+#include <set>                            // for set
+#include <vector>                         // for vector
+
+using namespace std;
+
+extern auto make_netlist(uint32_t num_modules, const vector<vector<uint32_t>> &net_list)
+    -> SimpleNetlist;  // import make_netlist
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+TEST_CASE("Test quotient_graph (small)") {
+    const auto hyprgraph = make_netlist(5, {{0, 1}, {1, 2, 3}, {3, 4}, {0, 4}});
+    const auto part = vector<uint8_t>{0, 0, 1, 2, 2};
+    const auto quotient = quotient_graph(hyprgraph, part, 3);
+    CHECK(quotient.num_cut_nets == 2);
+    CHECK(quotient.block_weight == vector<uint64_t>{2, 1, 2});
+    CHECK(quotient.weight(0, 1) == 1);
+    CHECK(quotient.weight(1, 2) == 1);
+    CHECK(quotient.weight(0, 2) == 2);
+    CHECK(quotient.neighbors(1) == vector<uint8_t>{0, 2});
+    CHECK(quotient.extern_nets[1].size() == 1);
+    CHECK(quotient.boundary_modules[0].size() == 2);
+    CHECK(quotient.boundary_modules[2].size() == 2);
+
+    const auto snapshot = take_snapshot(hyprgraph, part, quotient, 1);
+    CHECK(snapshot.extern_nets.size() == 1);
+    CHECK(snapshot.extern_modules.size() == 2);
+    CHECK(snapshot.extern_modules.at(3) == 2);
+}
+
+TEST_CASE("Test quotient_graph (no nets)") {
+    const auto hyprgraph = NetlistBuilder{4, 0}.build();
+    const auto quotient = quotient_graph(hyprgraph, {0, 1, 0, 1}, 2);
+    CHECK(quotient.num_cut_nets == 0);
+    CHECK(quotient.block_weight == vector<uint64_t>{2, 2});
+    CHECK(quotient.weight(0, 1) == 0);
+    CHECK(quotient.extern_nets[0].empty());
+    CHECK(quotient.boundary_modules[1].empty());
+}
+
+TEST_CASE("Test quotient_graph (fewer nets than blocks)") {
+    // Enough modules for one block per worker, but only three nets to split among them
+    const auto num_modules = uint32_t{100000};
+    auto builder = NetlistBuilder{num_modules, 3};
+    builder.add_pin(0, 0);
+    builder.add_pin(1, 0);
+    builder.add_pin(1, 1);
+    builder.add_pin(num_modules - 1, 1);
+    builder.add_pin(2, 2);
+    const auto hyprgraph = builder.build();
+    auto part = vector<uint8_t>(num_modules, 0U);
+    part[1] = 1U;
+    part[num_modules - 1] = 2U;
+    const auto quotient = quotient_graph(hyprgraph, part, 3);
+    CHECK(quotient.num_cut_nets == 2);
+    CHECK(quotient.block_weight == vector<uint64_t>{num_modules - 2, 1, 1});
+    CHECK(quotient.weight(0, 1) == 1);
+    CHECK(quotient.weight(1, 2) == 1);
+    CHECK(quotient.weight(0, 2) == 0);
+    CHECK(quotient.boundary_modules[0].size() == 1);
+}
+
+TEST_CASE("Test quotient_graph (ibm01)") {
+    const auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    const auto num_parts = size_t{4};
+    auto part = vector<uint8_t>(hyprgraph.number_of_modules());
+    for (size_t v = 0; v != part.size(); ++v) {
+        part[v] = uint8_t(v * num_parts / part.size());
+    }
+    const auto quotient = quotient_graph(hyprgraph, part, num_parts);
+    CHECK(quotient.block_weight == block_weights(hyprgraph, part, num_parts));
+
+    // Brute force: blocks spanned by every net
+    auto edge_weight = vector<uint64_t>(num_parts * num_parts, 0U);
+    auto extern_nets = vector<set<uint32_t>>(num_parts);
+    auto boundary = vector<set<uint32_t>>(num_parts);
+    auto num_cut = size_t{0};
+    auto lambda_sum = uint64_t{0};
+    for (const auto &net : hyprgraph.nets) {
+        auto spanned = set<uint8_t>{};
+        for (const auto &v : hyprgraph.gr[net]) {
+            spanned.insert(part[v]);
+        }
+        lambda_sum += spanned.size() - 1;
+        if (spanned.size() < 2) {
+            continue;
+        }
+        ++num_cut;
+        for (const auto p : spanned) {
+            extern_nets[p].insert(uint32_t(net));
+            for (const auto q : spanned) {
+                edge_weight[p * num_parts + q] += p != q ? 1U : 0U;
+            }
+        }
+        for (const auto &v : hyprgraph.gr[net]) {
+            boundary[part[v]].insert(uint32_t(v));
+        }
+    }
+    CHECK(quotient.num_cut_nets == num_cut);
+    CHECK(lambda_sum == connectivity_cost(hyprgraph, part, num_parts));
+    CHECK(quotient.edge_weight == edge_weight);
+    for (size_t p = 0; p != num_parts; ++p) {
+        const auto nets = quotient.extern_nets[p];
+        const auto modules = quotient.boundary_modules[p];
+        CHECK(vector<uint32_t>(nets.begin(), nets.end())
+              == vector<uint32_t>(extern_nets[p].begin(), extern_nets[p].end()));
+        CHECK(vector<uint32_t>(modules.begin(), modules.end())
+              == vector<uint32_t>(boundary[p].begin(), boundary[p].end()));
+    }
+}
@@ -0,0 +1,67 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <algorithm>                      // for sort, stable_sort, is_sorted
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstdint>                        // for uint32_t, uint64_t, uint8_t
+#include <netlistx/netlist.hpp>           // for SimpleNetlist
+#include <netlistx/radix_sort.hpp>        // for radix_sort, radix_sort_pairs, radix_argsort
+#include <random>                         // for mt19937_64
+#include <utility>                        // for pair
+#include <vector>                         // for vector
+
+using namespace std;
+
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+TEST_CASE("Test radix_sort") {
+    auto gen = mt19937_64{5};
+    for (const auto len : {0U, 7U, 5000U, 300000U}) {
+        auto keys32 = vector<uint32_t>(len);
+        auto keys64 = vector<uint64_t>(len);
+        for (size_t i = 0; i != len; ++i) {
+            keys32[i] = uint32_t(gen());
+            keys64[i] = gen() >> (i % 3 == 0 ? 0U : 40U);
+        }
+        auto expected32 = keys32;
+        auto expected64 = keys64;
+        sort(expected32.begin(), expected32.end());
+        sort(expected64.begin(), expected64.end());
+        radix_sort(keys32);
+        radix_sort(keys64);
+        CHECK(keys32 == expected32);
+        CHECK(keys64 == expected64);
+    }
+    auto same = vector<uint8_t>(10000, 7U);  // every pass is skipped
+    radix_sort(same);
+    CHECK(same == vector<uint8_t>(10000, 7U));
+}
+
+TEST_CASE("Test radix_sort_pairs (pins of ibm01)") {
+    const auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    auto nets = vector<uint32_t>{};
+    auto modules = vector<uint32_t>{};
+    for (const auto &v : hyprgraph) {
+        for (const auto &net : hyprgraph.gr[v]) {
+            nets.push_back(uint32_t(net));
+            modules.push_back(uint32_t(v));
+        }
+    }
+    auto expected = vector<pair<uint32_t, uint32_t>>(nets.size());
+    for (size_t i = 0; i != nets.size(); ++i) {
+        expected[i] = {nets[i], modules[i]};
+    }
+    stable_sort(expected.begin(), expected.end(),
+                [](const auto &p1, const auto &p2) { return p1.first < p2.first; });
+
+    const auto perm = radix_argsort(nets);
+    const auto input_modules = modules;
+    radix_sort_pairs(nets, modules);
+    auto same = true;
+    for (size_t i = 0; i != nets.size(); ++i) {
+        same = same && nets[i] == expected[i].first && modules[i] == expected[i].second;
+        same = same && input_modules[perm[i]] == modules[i];
+    }
+    CHECK(same);
+    CHECK(is_sorted(nets.begin(), nets.end()));
+}
@@ -2,12 +2,19 @@
 #include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
 // #include <__config>            // for std
 #include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <filesystem>                     // for temp_directory_path, remove_all
+#include <fstream>                        // for ofstream
 #include <netlistx/netlist.hpp>           // for Netlist, SimpleNetlist
+#include <optional>                       // for optional
+#include <string>                         // for string
 
 using namespace std;
 
 extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+extern auto tryReadNetD(boost::string_view netDFileName, string &error) -> optional<SimpleNetlist>;
 extern void readAre(SimpleNetlist &hyprgraph, boost::string_view areFileName);
+extern auto tryReadAre(SimpleNetlist &hyprgraph, boost::string_view areFileName, string &error)
+    -> bool;
 extern void writeJSON(boost::string_view jsonFileName, const SimpleNetlist &hyprgraph);
 
 TEST_CASE("Test Read Dwarf") {
@@ -59,6 +66,42 @@ TEST_CASE("Test Read ibm01") {
 //     CHECK(hyprgraph.get_module_weight(1) == 1);
 // }
 
+TEST_CASE("Test Read malformed files") {
+    const auto dir = filesystem::temp_directory_path() / "netlistx_test_readwrite";
+    filesystem::create_directories(dir);
+    const auto write = [&](const char *name, const char *text) {
+        const auto path = (dir / name).string();
+        ofstream{path} << text;
+        return path;
+    };
+    auto error = string{};
+
+    CHECK(!tryReadNetD((dir / "missing.net").string(), error));
+    CHECK(!tryReadNetD(write("header.net", "0\n4\nx\n"), error));
+    CHECK(error == "invalid header");
+    CHECK(!tryReadNetD(write("keyword.net", "0\n4\n2\n3\n0\na0 s 1\nx1 l 1\n"), error));
+    // a module id beyond the header count is caught by the builder validation
+    CHECK(!tryReadNetD(write("module.net", "0\n2\n1\n3\n0\na0 s 1\na9 l 1\n"), error));
+    // a truncated file ends the pins early
+    CHECK(!tryReadNetD(write("short.net", "0\n4\n2\n3\n0\na0 s 1\na1 l 1\n"), error));
+    REQUIRE(tryReadNetD(write("ok.net", "0\n4\n2\n3\n0\na0 s 1\na1 l 1\na1 s 1\na2 l 1\n"),
+                        error));
+
+    // The weights are written in place and are unchanged on error
+    auto hyprgraph = readNetD("../../testcases/dwarf1.netD");
+    readAre(hyprgraph, "../../testcases/dwarf1.are");
+    const auto *data = hyprgraph.module_weight.data();
+    CHECK(!tryReadAre(hyprgraph, write("keyword.are", "a0 5\nb1 4\n"), error));
+    CHECK(!tryReadAre(hyprgraph, write("range.are", "a0 5\na99 4\n"), error));
+    CHECK(hyprgraph.get_module_weight(0) == 1);
+    CHECK(tryReadAre(hyprgraph, write("ok.are", "a0 5\n"), error));
+    CHECK(hyprgraph.module_weight.data() == data);
+    CHECK(hyprgraph.get_module_weight(0) == 5);
+    CHECK(hyprgraph.get_module_weight(1) == 0);
+
+    filesystem::remove_all(dir);
+}
+
 TEST_CASE("Test Write Dwarf") {
     auto hyprgraph = readNetD("../../testcases/dwarf1.netD");
     readAre(hyprgraph, "../../testcases/dwarf1.are");
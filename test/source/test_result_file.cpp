@@ -0,0 +1,112 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstdint>                        // for uint8_t, uint32_t
+#include <filesystem>                     // for temp_directory_path, remove_all, directory_iterator
+#include <fstream>                        // for fstream
+#include <netlistx/fingerprint.hpp>       // for fingerprint
+#include <netlistx/netlist.hpp>           // for SimpleNetlist
+#include <netlistx/result_file.hpp>       // for ResultFile, writeResult
+#include <string>                         // for string
+#include <vector>                         // for vector
+
+using namespace std;
+
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+TEST_CASE("Test result file") {
+    const auto dir = filesystem::temp_directory_path() / "netlistx_test_result_file";
+    filesystem::remove_all(dir);
+    filesystem::create_directories(dir);
+    const auto hyprgraph = readNetD("../../testcases/p1.net");
+    const auto num_modules = hyprgraph.number_of_modules();
+    const auto key = fingerprint(hyprgraph);
+
+    // Partition
+    auto part = vector<uint8_t>(num_modules);
+    for (size_t v = 0; v != num_modules; ++v) {
+        part[v] = uint8_t(v % 3);
+    }
+    auto metadata = ResultMetadata{};
+    metadata.netlist = key;
+    metadata.num_parts = 3;
+    metadata.values = {{"cut", 129.0}, {"seconds", 0.25}, {"a_rather_long_value_name_xyz", 1.0}};
+    const auto part_file = (dir / "p1.part").string();
+    REQUIRE(writeResult(part_file, metadata, part));
+    auto result = ResultFile{};
+    REQUIRE(result.open(part_file));
+    CHECK(result.metadata().kind == ResultKind::partition);
+    CHECK(result.metadata().num_parts == 3);
+    CHECK(result.metadata().value("cut") == 129.0);
+    CHECK(result.metadata().value("seconds") == 0.25);
+    CHECK(result.metadata().value("a_rather_long_value_nam") == 1.0);  // truncated
+    CHECK(result.metadata().value("missing", -1.0) == -1.0);
+    CHECK(result.entry_bits() == 8);
+    CHECK(result.matches(key, num_modules));
+    CHECK(!result.matches(key, num_modules + 1));
+    CHECK(result.verify());
+    CHECK(result.to_bytes() == part);
+
+    // Cover (bit-packed)
+    auto cover = vector<uint8_t>(num_modules);
+    for (size_t v = 0; v != num_modules; ++v) {
+        cover[v] = v % 7 == 0 ? 1U : 0U;
+    }
+    metadata.kind = ResultKind::cover;
+    metadata.values = {{"weight", 119.0}};
+    const auto cover_file = (dir / "p1.cover").string();
+    REQUIRE(writeResult(cover_file, metadata, cover));
+    CHECK(filesystem::file_size(cover_file) == 512 + (num_modules + 7) / 8);
+    REQUIRE(result.open(cover_file));
+    CHECK(result.entry_bits() == 1);
+    CHECK(result.to_bytes() == cover);
+    CHECK(result[7] == 1);
+    CHECK(result[8] == 0);
+
+    // Rewriting replaces the file, the open mapping keeps the old contents
+    auto other = vector<uint8_t>(num_modules, 1U);
+    REQUIRE(writeResult(cover_file, metadata, other));
+    CHECK(result.to_bytes() == cover);
+    CHECK(result.verify());
+    auto rewritten = ResultFile{};
+    REQUIRE(rewritten.open(cover_file));
+    CHECK(rewritten.to_bytes() == other);
+    CHECK(!writeResult((dir / "missing" / "p1.cover").string(), metadata, cover));
+    auto num_files = 0;
+    for (const auto &entry : filesystem::directory_iterator{dir}) {
+        num_files += entry.is_regular_file() ? 1 : 0;  // no temporary file is left
+    }
+    CHECK(num_files == 2);
+
+    // Clustering, then a corrupted payload
+    auto cluster = vector<uint32_t>(num_modules);
+    for (size_t v = 0; v != num_modules; ++v) {
+        cluster[v] = uint32_t(v * 100003U);
+    }
+    metadata.kind = ResultKind::cluster;
+    CHECK(!writeResult(cover_file, metadata, cover));  // wrong kind for bytes
+    const auto cluster_file = (dir / "p1.cluster").string();
+    REQUIRE(writeResult(cluster_file, metadata, cluster));
+    REQUIRE(result.open(cluster_file));
+    auto same = result.size() == num_modules;
+    for (size_t v = 0; v != num_modules; ++v) {
+        same = same && result[v] == cluster[v];
+    }
+    CHECK(same);
+    CHECK(result.verify());
+    {
+        auto file = fstream{cluster_file, ios::in | ios::out | ios::binary};
+        file.seekp(600);
+        file.put('x');
+    }
+    REQUIRE(result.open(cluster_file));
+    CHECK(!result.verify());
+
+    {
+        auto file = ofstream{cluster_file, ios::binary | ios::app};
+        file.put('x');  // payload size no longer matches
+    }
+    CHECK(!result.open(cluster_file));
+    filesystem::remove_all(dir);
+}
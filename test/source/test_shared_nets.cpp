@@ -0,0 +1,67 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cstdint>                        // for uint32_t
+#include <netlistx/netlist.hpp>           // for SimpleNetlist
+#include <netlistx/shared_nets.hpp>       // for SharedNetIndex, intersection_size
+#include <vector>                         // for vector
+
+using namespace std;
+
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+/**
+ * @brief Nested-loop reference of the shared-net count
+ */
+static auto shared_nets(const SimpleNetlist &hyprgraph, index_t u, index_t v) -> size_t {
+    auto count = size_t{0};
+    for (const auto &net : hyprgraph.gr[u]) {
+        count += hyprgraph.gr[v].contains(net) ? 1U : 0U;
+    }
+    return count;
+}
+
+TEST_CASE("Test intersection_size") {
+    auto a = vector<index_t>{3, 9};
+    auto b = vector<index_t>{};
+    for (index_t i = 0; i != 100; ++i) {
+        b.push_back(i * 3);
+    }
+    const auto ra = CsrRow{a.data(), a.data() + a.size()};
+    const auto rb = CsrRow{b.data(), b.data() + b.size()};
+    CHECK(intersection_size(ra, rb) == 2);  // galloping
+    CHECK(intersection_size(rb, ra) == 2);
+    CHECK(intersection_size(rb, rb) == 100);  // merging
+    a = {1, 2, 299, 400};
+    CHECK(intersection_size(CsrRow{a.data(), a.data() + a.size()}, rb) == 0);
+}
+
+TEST_CASE("Test SharedNetIndex") {
+    const auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    auto index = SharedNetIndex{hyprgraph};
+    const auto num_modules = index_t(hyprgraph.number_of_modules());
+    auto same = true;
+    for (index_t u = 0; u < num_modules; u += 97) {
+        for (const auto &net : hyprgraph.gr[u]) {
+            for (const auto &v : hyprgraph.gr[net]) {
+                same = same && index.count(u, v) == shared_nets(hyprgraph, u, v);
+            }
+        }
+        same = same && index.count(u, (u * 7 + 1) % num_modules)
+                           == shared_nets(hyprgraph, u, (u * 7 + 1) % num_modules);
+    }
+    CHECK(same);
+
+    index.build_top_k(hyprgraph, 4);
+    same = true;
+    for (index_t u = 0; u < num_modules; u += 31) {
+        const auto top = index.top_k(u);
+        same = same && top.size() <= 4;
+        for (const auto &entry : top) {
+            same = same && entry.second == shared_nets(hyprgraph, u, entry.first);
+            same = same && index.count(u, entry.first) == entry.second;
+        }
+    }
+    CHECK(same);
+}
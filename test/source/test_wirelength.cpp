@@ -0,0 +1,146 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, CHECK, TestCase, TEST_CASE
+
+#include <algorithm>                      // for min, sort
+#include <boost/utility/string_view.hpp>  // for boost::string_view
+#include <cmath>                          // for abs
+#include <limits>                         // for numeric_limits
+#include <netlistx/csr.hpp>               // for CsrRow, net_pins_csr
+#include <netlistx/netlist.hpp>           // for SimpleNetlist, index_t
+#include <netlistx/wirelength.hpp>        // for net_hpwl, net_rsmt, total_hpwl, total_rsmt
+#include <random>                         // for mt19937
+#include <utility>                        // for pair
+#include <vector>                         // for vector
+
+using namespace std;
+
+extern auto readNetD(boost::string_view netDFileName) -> SimpleNetlist;
+
+// Rectilinear minimum spanning tree of the points (Prim)
+static auto rmst_length(const vector<double> &x, const vector<double> &y) -> double {
+    const auto n = x.size();
+    auto dist = vector<double>(n, numeric_limits<double>::max());
+    auto in_tree = vector<bool>(n, false);
+    auto length = 0.0;
+    dist[0] = 0.0;
+    for (size_t step = 0; step != n; ++step) {
+        auto u = n;
+        for (size_t v = 0; v != n; ++v) {
+            if (!in_tree[v] && (u == n || dist[v] < dist[u])) {
+                u = v;
+            }
+        }
+        in_tree[u] = true;
+        length += dist[u];
+        for (size_t v = 0; v != n; ++v) {
+            dist[v] = min(dist[v], abs(x[u] - x[v]) + abs(y[u] - y[v]));
+        }
+    }
+    return length;
+}
+
+// Exact RSMT: the shortest RMST of the pins and at most d - 2 points of the Hanan grid (Hanan)
+static auto exact_rsmt(const vector<double> &x, const vector<double> &y) -> double {
+    auto xs = x;
+    auto ys = y;
+    sort(xs.begin(), xs.end());
+    sort(ys.begin(), ys.end());
+    auto grid = vector<pair<double, double>>{};
+    for (const auto gx : xs) {
+        for (const auto gy : ys) {
+            grid.emplace_back(gx, gy);
+        }
+    }
+    auto best = numeric_limits<double>::max();
+    auto px = x;
+    auto py = y;
+    // Adds Steiner points grid[first..] one at a time, up to `left` more of them
+    auto search = [&](auto &self, size_t first, size_t left) -> void {
+        best = min(best, rmst_length(px, py));
+        for (auto i = first; left != 0 && i != grid.size(); ++i) {
+            px.push_back(grid[i].first);
+            py.push_back(grid[i].second);
+            self(self, i + 1, left - 1);
+            px.pop_back();
+            py.pop_back();
+        }
+    };
+    search(search, 0, x.size() - 2);
+    return best;
+}
+
+TEST_CASE("Test net_rsmt (known nets)") {
+    const auto x = vector<double>{0, 2, 0, 2, 1, 1, 0, 2};
+    const auto y = vector<double>{0, 0, 2, 2, 0, 2, 1, 1};
+    const auto square = vector<index_t>{0, 1, 2, 3};
+    const auto cross = vector<index_t>{4, 5, 6, 7};
+    const auto row = [](const vector<index_t> &pins) {
+        return CsrRow{pins.data(), pins.data() + pins.size()};
+    };
+    CHECK(net_hpwl(row(square), x, y) == 4.0);
+    CHECK(net_rsmt(row(square), x, y) == 6.0);
+    CHECK(net_rsmt(row(cross), x, y) == 4.0);
+    CHECK(net_rsmt(CsrRow{cross.data(), cross.data() + 3}, x, y) == 3.0);
+}
+
+TEST_CASE("Test net_rsmt (exact up to 6 pins)") {
+    auto rng = mt19937{11};
+    auto exact = true;
+    for (size_t trial = 0; trial != 60; ++trial) {
+        const auto d = 4 + trial % 3;
+        auto x = vector<double>(d);
+        auto y = vector<double>(d);
+        for (size_t i = 0; i != d; ++i) {
+            x[i] = double(rng() % 16);
+            y[i] = double(rng() % 16);
+        }
+        auto pins = vector<index_t>(d);
+        for (size_t i = 0; i != d; ++i) {
+            pins[i] = index_t((i + trial) % d);  // any pin order
+        }
+        const auto length = net_rsmt(CsrRow{pins.data(), pins.data() + d}, x, y);
+        exact = exact && length == exact_rsmt(x, y);
+    }
+    CHECK(exact);
+}
+
+TEST_CASE("Test net_rsmt (large nets)") {
+    auto rng = mt19937{3};
+    auto bounded = true;
+    for (const size_t d : {7U, 12U, 30U, 64U, 65U, 500U}) {
+        auto x = vector<double>(d);
+        auto y = vector<double>(d);
+        auto pins = vector<index_t>(d);
+        for (size_t i = 0; i != d; ++i) {
+            x[i] = double(rng() % 1000) / 4.0;
+            y[i] = double(rng() % 1000) / 4.0;
+            pins[i] = index_t(i);
+        }
+        const auto row = CsrRow{pins.data(), pins.data() + d};
+        const auto length = net_rsmt(row, x, y);
+        bounded = bounded && net_hpwl(row, x, y) <= length;
+        bounded = bounded && (d > 64U || length <= rmst_length(x, y));
+    }
+    CHECK(bounded);
+}
+
+TEST_CASE("Test total_rsmt (ibm01)") {
+    const auto hyprgraph = readNetD("../../testcases/ibm01.net");
+    const auto pins = net_pins_csr(hyprgraph);
+    auto rng = mt19937{1};
+    auto x = vector<double>(hyprgraph.number_of_modules());
+    auto y = vector<double>(hyprgraph.number_of_modules());
+    for (size_t v = 0; v != x.size(); ++v) {
+        x[v] = double(rng() % 10000);
+        y[v] = double(rng() % 10000);
+    }
+    auto hpwl = 0.0;
+    auto rsmt = 0.0;
+    for (size_t i = 0; i != pins.size(); ++i) {
+        hpwl += net_hpwl(pins[i], x, y);
+        rsmt += net_rsmt(pins[i], x, y);
+    }
+    CHECK(total_hpwl(pins, x, y) == hpwl);
+    CHECK(total_rsmt(pins, x, y) == rsmt);
+    CHECK(rsmt > hpwl);
+}
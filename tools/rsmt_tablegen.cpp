@@ -0,0 +1,159 @@
+// Generates the RSMT lookup tables of source/wirelength.cpp at build time.
+//
+// Sort the pins of a net by x and let row[i] be the y rank of the i-th pin: the permutation
+// `row` places the pins on the d x d Hanan grid, and a rectilinear Steiner tree that uses only
+// grid edges (an optimal one exists) has length sum_i h[i] * gx[i] + sum_j v[j] * gy[j], where
+// gx and gy are the gaps between consecutive sorted x and y coordinates and h[i], v[j] count
+// the tree edges crossing them. For every permutation, the Dreyfus-Wagner recursion over the
+// Hanan grid is run on these count vectors, keeping the Pareto-minimal vectors at every step,
+// so the minimum over the resulting vectors is the exact RSMT length for any gaps.
+#include <algorithm>  // for next_permutation, min, max
+#include <array>      // for array
+#include <cstdint>    // for uint8_t
+#include <fstream>    // for ofstream
+#include <iostream>   // for cerr
+#include <numeric>    // for iota
+#include <vector>     // for vector
+
+namespace {
+    constexpr size_t max_degree = 6;
+    constexpr size_t num_gaps = 2 * (max_degree - 1);
+    using Powv = std::array<std::uint8_t, num_gaps>;  // h[0..d-1), then v[0..d-1), zero padded
+    using PowvSet = std::vector<Powv>;
+
+    auto dominates(const Powv &p, const Powv &q) -> bool {
+        for (size_t i = 0; i != num_gaps; ++i) {
+            if (p[i] > q[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void insert(PowvSet &set, const Powv &p) {
+        for (const auto &q : set) {
+            if (dominates(q, p)) {
+                return;
+            }
+        }
+        set.erase(std::remove_if(set.begin(), set.end(),
+                                 [&](const Powv &q) { return dominates(p, q); }),
+                  set.end());
+        set.push_back(p);
+    }
+
+    auto add(const Powv &p, const Powv &q) -> Powv {
+        auto sum = Powv{};
+        for (size_t i = 0; i != num_gaps; ++i) {
+            sum[i] = std::uint8_t(p[i] + q[i]);
+        }
+        return sum;
+    }
+
+    // The Pareto-minimal count vectors of the Steiner trees of the pins at (i, row[i])
+    auto rsmt_vectors(const std::vector<size_t> &row) -> PowvSet {
+        const auto d = row.size();
+        const auto num_nodes = d * d;  // node c * d + r is column c, row r
+        auto dist = [&](size_t a, size_t b) {
+            auto p = Powv{};
+            for (auto c = std::min(a / d, b / d); c != std::max(a / d, b / d); ++c) {
+                p[c] = 1U;
+            }
+            for (auto r = std::min(a % d, b % d); r != std::max(a % d, b % d); ++r) {
+                p[d - 1 + r] = 1U;
+            }
+            return p;
+        };
+        // best[mask * num_nodes + v]: trees connecting node v and the pins of `mask`, the last
+        // pin being the root
+        const auto full = (size_t{1} << (d - 1)) - 1;
+        auto best = std::vector<PowvSet>((full + 1) * num_nodes);
+        for (size_t t = 0; t + 1 != d; ++t) {
+            for (size_t v = 0; v != num_nodes; ++v) {
+                best[(size_t{1} << t) * num_nodes + v] = {dist(t * d + row[t], v)};
+            }
+        }
+        auto merged = std::vector<PowvSet>(num_nodes);
+        for (size_t mask = 3; mask <= full; ++mask) {
+            const auto low = mask & (~mask + 1);
+            if (mask == low) {
+                continue;
+            }
+            for (size_t w = 0; w != num_nodes; ++w) {
+                merged[w].clear();
+                for (auto sub = (mask - 1) & mask; sub != 0; sub = (sub - 1) & mask) {
+                    if ((sub & low) == 0) {
+                        continue;  // every split once
+                    }
+                    for (const auto &p : best[sub * num_nodes + w]) {
+                        for (const auto &q : best[(mask ^ sub) * num_nodes + w]) {
+                            insert(merged[w], add(p, q));
+                        }
+                    }
+                }
+            }
+            const auto root = (d - 1) * d + row[d - 1];
+            for (size_t v = 0; v != num_nodes; ++v) {
+                if (mask == full && v != root) {
+                    continue;
+                }
+                auto &set = best[mask * num_nodes + v];
+                for (size_t w = 0; w != num_nodes; ++w) {
+                    const auto path = dist(w, v);
+                    for (const auto &p : merged[w]) {
+                        insert(set, add(p, path));
+                    }
+                }
+            }
+        }
+        return best[full * num_nodes + (d - 1) * d + row[d - 1]];
+    }
+}  // namespace
+
+auto main(int argc, char **argv) -> int {
+    if (argc != 2) {
+        std::cerr << "usage: " << argv[0] << " <output file>\n";
+        return 1;
+    }
+    auto first = std::vector<size_t>{0U};
+    auto powvs = PowvSet{};
+    auto perm_base = std::vector<size_t>(max_degree + 1, 0U);
+    for (size_t d = 4; d <= max_degree; ++d) {
+        perm_base[d] = first.size() - 1;
+        auto row = std::vector<size_t>(d);
+        std::iota(row.begin(), row.end(), size_t{0});
+        do {  // lexicographic order, the rank used by the lookup
+            for (const auto &p : rsmt_vectors(row)) {
+                powvs.push_back(p);
+            }
+            first.push_back(powvs.size());
+        } while (std::next_permutation(row.begin(), row.end()));
+    }
+
+    auto out = std::ofstream{argv[1]};
+    out << "// Generated by tools/rsmt_tablegen.cpp, do not edit.\n\n";
+    out << "constexpr size_t rsmt_table_degree = " << max_degree << ";\n\n";
+    out << "// The permutations of degree d start at rsmt_first[rsmt_perm_base[d]]\n";
+    out << "constexpr std::uint32_t rsmt_perm_base[] = {";
+    for (size_t d = 0; d <= max_degree; ++d) {
+        out << (d == 0 ? "" : ", ") << perm_base[d];
+    }
+    out << "};\n\n";
+    out << "// The vectors of a permutation are rsmt_powv[rsmt_first[p] .. rsmt_first[p + 1])\n";
+    out << "constexpr std::uint32_t rsmt_first[] = {\n";
+    for (size_t i = 0; i != first.size(); ++i) {
+        out << (i % 12 == 0 ? "    " : " ") << first[i] << ","
+            << (i % 12 == 11 || i + 1 == first.size() ? "\n" : "");
+    }
+    out << "};\n\n";
+    out << "constexpr std::uint8_t rsmt_powv[][" << num_gaps << "] = {\n";
+    for (const auto &p : powvs) {
+        out << "    {";
+        for (size_t i = 0; i != num_gaps; ++i) {
+            out << (i == 0 ? "" : ", ") << unsigned(p[i]);
+        }
+        out << "},\n";
+    }
+    out << "};\n";
+    return out ? 0 : 1;
+}
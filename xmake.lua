@@ -18,13 +18,28 @@ if is_mode("coverage") then
     add_cxflags("-ftest-coverage", "-fprofile-arcs", {force = true})
 end
 
+-- Generates the RSMT lookup tables of source/wirelength.cpp
+target("rsmt_tablegen")
+    set_kind("binary")
+    set_default(false)
+    add_files("tools/rsmt_tablegen.cpp")
+
 target("NetlistX")
     set_kind("static")
+    add_deps("rsmt_tablegen")
     add_includedirs("include", {public = true})
     add_includedirs("../py2cpp/include", {public = true})
     add_includedirs("../xnetwork-cpp/include", {public = true})
     add_files("source/*.cpp")
     add_packages("boost", "range-v3", "msgsl")
+    on_load(function (target)
+        target:add("includedirs", path.join(target:autogendir(), "generated"))
+    end)
+    before_build(function (target)
+        local outputdir = path.join(target:autogendir(), "generated")
+        os.mkdir(outputdir)
+        os.vrunv(target:dep("rsmt_tablegen"):targetfile(), {path.join(outputdir, "rsmt_tables.inc")})
+    end)
 
 target("test_netlistx")
     set_kind("binary")